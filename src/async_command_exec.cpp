@@ -108,7 +108,9 @@ std::pair<pid_t, int> AsyncCommandExecutor::spawnCommand(const std::string& cmd,
 
 sdbusplus::async::task<std::pair<int, std::string>>
     // NOLINTNEXTLINE
-    AsyncCommandExecutor::execCmd(const std::string& cmd)
+    AsyncCommandExecutor::execCmd(const std::string& cmd,
+                                  tracing::CorrelationId correlationId,
+                                  OutputHandler onOutput)
 {
     int pipefd[2];
     // Create pipe for the IPC
@@ -128,7 +130,15 @@ sdbusplus::async::task<std::pair<int, std::string>>
         co_return {-1, ""};
     }
 
+    auto spawnStart = tracing::Clock::now();
     auto [pid, spawnResult] = spawnCommand(cmd, actions);
+    if (correlationId != 0)
+    {
+        tracing::SpanTracer::instance().record(
+            {correlationId, tracing::Stage::ProcessSpawn, spawnStart,
+             tracing::Clock::now() - spawnStart,
+             "PID: " + std::to_string(pid)});
+    }
 
     // Manually close the write end of the pipe in parent because only the child
     // need to write.
@@ -140,7 +150,7 @@ sdbusplus::async::task<std::pair<int, std::string>>
 
     // Wait until the child writes into the fd.
     // NOLINTNEXTLINE
-    auto output = co_await waitForCmdCompletion(readFd());
+    auto output = co_await waitForCmdCompletion(readFd(), onOutput);
 
     // Manually close the read fd of the parent immediately instead of keeping
     // it open until RAII scope cleanup.
@@ -162,7 +172,8 @@ sdbusplus::async::task<std::pair<int, std::string>>
 
 sdbusplus::async::task<std::string>
     // NOLINTNEXTLINE
-    AsyncCommandExecutor::waitForCmdCompletion(int fd)
+    AsyncCommandExecutor::waitForCmdCompletion(int fd,
+                                               const OutputHandler& onOutput)
 {
     // Set non-blocking mode for the file descriptor
     int flags = fcntl(fd, F_GETFL, 0);
@@ -187,6 +198,18 @@ sdbusplus::async::task<std::string>
         if (bytes > 0)
         {
             output.append(buffer.data(), bytes);
+            if (onOutput)
+            {
+                onOutput(std::string_view(buffer.data(),
+                                          static_cast<size_t>(bytes)));
+
+                // Consumed already, hence only the tail is kept, Eg: for the
+                // error messages.
+                if (output.size() > 2 * maxOutputTail)
+                {
+                    output.erase(0, output.size() - maxOutputTail);
+                }
+            }
             buffer.fill(0);
         }
         else if (bytes == 0)
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "tracing.hpp"
 #include "utility.hpp"
 
 #include <fcntl.h>
@@ -9,6 +10,9 @@
 
 #include <sdbusplus/async.hpp>
 
+#include <functional>
+#include <string_view>
+
 namespace data_sync::async
 {
 
@@ -56,6 +60,11 @@ class SpawnFActions
 };
 } // namespace utility
 
+/**
+ * @brief The callback to consume the command output as it is read.
+ */
+using OutputHandler = std::function<void(std::string_view)>;
+
 /**
  * @class AsyncCommandExecutor
  *
@@ -83,13 +92,25 @@ class AsyncCommandExecutor
      *        'posix_spawn'.
      *
      * @param[in] - cmd - The bash command to execute
+     * @param[in] - correlationId - The correlation id to trace the process
+     *                              spawn against, 0 to skip the tracing.
+     * @param[in] - onOutput - Consumes the output as it is read, in which case
+     *                         only the tail of the output is returned.
      *
      * @return sdbusplus::async::task<std::pair<int, std::string>>
      *              - int : Exit code of the spawned process (-1 on failure)
      *              - std::string : Combined stdout and stderr output
      */
     sdbusplus::async::task<std::pair<int, std::string>>
-        execCmd(const std::string& cmd);
+        execCmd(const std::string& cmd,
+                tracing::CorrelationId correlationId = 0,
+                OutputHandler onOutput = {});
+
+    /**
+     * @brief The size of the output tail returned, if the output is consumed
+     *        as it is read.
+     */
+    static constexpr size_t maxOutputTail = 64 * 1024;
 
   private:
     /**
@@ -139,13 +160,16 @@ class AsyncCommandExecutor
      *        descriptor once it is ready.
      *
      * @param[in] - fd - file descriptor to read the data from.
+     * @param[in] - onOutput - Consumes the output as it is read, if set.
      *
      * @return - sdbusplus::async::task<std::string>
-     *             On success - The accumulated output from the descriptor.
+     *             On success - The accumulated output from the descriptor,
+     *                          only its tail if it is consumed as read.
      *             On failure - An empty string.
      *
      */
-    sdbusplus::async::task<std::string> waitForCmdCompletion(int fd);
+    sdbusplus::async::task<std::string>
+        waitForCmdCompletion(int fd, const OutputHandler& onOutput);
 
     /**
      * @brief The async context object used to perform operations
@@ -0,0 +1,351 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "change_journal.hpp"
+
+#include "utility.hpp"
+#include <nlohmann/json.hpp>
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+#include <string>
+
+namespace data_sync::journal
+{
+
+namespace
+{
+
+/**
+ * @brief Helper to check whether the journaled path is a directory, the
+ *        directories are journaled with a trailing slash.
+ */
+bool isDirEntry(const fs::path& path)
+{
+    return path.string().ends_with('/');
+}
+
+/**
+ * @brief The record types of the journal log.
+ */
+constexpr std::string_view addRecord{"+"};
+constexpr std::string_view removeRecord{"-"};
+constexpr std::string_view overflowRecord{"O"};
+
+} // namespace
+
+ChangeJournal::ChangeJournal(fs::path journalFile, size_t maxEntries,
+                             size_t collapseThreshold) :
+    _journalFile(std::move(journalFile)), _maxEntries(maxEntries),
+    _collapseThreshold(collapseThreshold)
+{
+    load();
+}
+
+size_t ChangeJournal::size() const
+{
+    size_t entries{0};
+    for (const auto& [cfgPath, paths] : _entries)
+    {
+        entries += paths.size();
+    }
+    return entries;
+}
+
+bool ChangeJournal::addEntry(const fs::path& cfgPath,
+                             const fs::path& changedPath)
+{
+    if (_overflowed)
+    {
+        // The changes are not tracked anymore until the full sync.
+        return false;
+    }
+
+    auto& paths = _entries[cfgPath];
+
+    // Skip if the path or one of its parent directories is already journaled.
+    if (paths.contains(changedPath) ||
+        std::ranges::any_of(paths, [&changedPath](const auto& path) {
+        return isDirEntry(path) && utility::isSameOrChildOf(changedPath, path);
+    }))
+    {
+        return false;
+    }
+
+    // The directory covers its children, hence drop them.
+    if (isDirEntry(changedPath))
+    {
+        std::erase_if(paths, [&changedPath](const auto& path) {
+            return utility::isSameOrChildOf(path, changedPath);
+        });
+    }
+    paths.insert(changedPath);
+
+    const fs::path changedParent =
+        utility::withoutTrailingSlash(changedPath).parent_path();
+    collapseIntoParent(cfgPath, changedParent);
+
+    if (size() > _maxEntries)
+    {
+        lg2::warning("The change journal exceeded {MAX} entries, a full sync "
+                     "is required to recover",
+                     "MAX", _maxEntries);
+        _entries.clear();
+        _overflowed = true;
+    }
+    return true;
+}
+
+void ChangeJournal::add(const fs::path& cfgPath, const fs::path& changedPath)
+{
+    if (!addEntry(cfgPath, changedPath))
+    {
+        return;
+    }
+    if (_overflowed)
+    {
+        // Just the overflow is to be persisted.
+        compact();
+        return;
+    }
+    append(addRecord, cfgPath, changedPath);
+}
+
+void ChangeJournal::collapseIntoParent(const fs::path& cfgPath,
+                                       const fs::path& dir)
+{
+    // Collapse only within the configured directory, as the paths outside of
+    // it are not synced as part of the configuration.
+    if (dir.empty() || !isDirEntry(cfgPath) ||
+        !utility::isSameOrChildOf(dir, cfgPath))
+    {
+        return;
+    }
+
+    auto& paths = _entries[cfgPath];
+    auto children = std::ranges::count_if(paths, [&dir](const auto& path) {
+        return utility::isSameOrChildOf(path, dir);
+    });
+    if (static_cast<size_t>(children) <= _collapseThreshold)
+    {
+        return;
+    }
+
+    std::erase_if(paths, [&dir](const auto& path) {
+        return utility::isSameOrChildOf(path, dir);
+    });
+    paths.insert(dir / "");
+
+    // The collapsed directory may in turn push its parent over the threshold.
+    collapseIntoParent(cfgPath, dir.parent_path());
+}
+
+bool ChangeJournal::removeEntry(const fs::path& cfgPath,
+                                const fs::path& changedPath)
+{
+    auto it = _entries.find(cfgPath);
+    if (it == _entries.end() || it->second.erase(changedPath) == 0)
+    {
+        return false;
+    }
+    if (it->second.empty())
+    {
+        _entries.erase(it);
+    }
+    return true;
+}
+
+void ChangeJournal::remove(const fs::path& cfgPath, const fs::path& changedPath)
+{
+    if (!removeEntry(cfgPath, changedPath))
+    {
+        return;
+    }
+    if (_entries.empty())
+    {
+        // Nothing is left to replay, hence just truncate the log.
+        compact();
+        return;
+    }
+    append(removeRecord, cfgPath, changedPath);
+}
+
+void ChangeJournal::markOverflowed()
+{
+    if (_overflowed)
+    {
+        return;
+    }
+    _entries.clear();
+    _overflowed = true;
+    compact();
+}
+
+void ChangeJournal::clear()
+{
+    if (empty())
+    {
+        return;
+    }
+    _entries.clear();
+    _overflowed = false;
+    compact();
+}
+
+void ChangeJournal::load()
+{
+    std::ifstream journalLog(_journalFile);
+    if (!journalLog.is_open())
+    {
+        return;
+    }
+
+    try
+    {
+        std::string line;
+        size_t lineNum{0};
+        while (std::getline(journalLog, line))
+        {
+            ++lineNum;
+            if (line.empty())
+            {
+                continue;
+            }
+
+            auto record = nlohmann::json::parse(line, nullptr, false);
+            if (record.is_discarded() || !record.is_array() || record.empty())
+            {
+                if (journalLog.peek() == std::ifstream::traits_type::eof())
+                {
+                    // The last record is torn by a power loss while appending
+                    // it, hence the change is yet to be synced anyway.
+                    lg2::warning("Ignoring the incomplete last record of the "
+                                 "change journal {FILE}",
+                                 "FILE", _journalFile);
+                    break;
+                }
+                throw std::runtime_error(
+                    std::format("Invalid record at line {}", lineNum));
+            }
+
+            const auto recordType = record[0].get<std::string>();
+            if (recordType == overflowRecord)
+            {
+                _entries.clear();
+                _overflowed = true;
+            }
+            else if (recordType == addRecord)
+            {
+                addEntry(record.at(1).get<std::string>(),
+                         record.at(2).get<std::string>());
+            }
+            else if (recordType == removeRecord)
+            {
+                removeEntry(record.at(1).get<std::string>(),
+                            record.at(2).get<std::string>());
+            }
+            else
+            {
+                throw std::runtime_error(std::format(
+                    "Unknown record type {} at line {}", recordType, lineNum));
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        // Not aware of the missed changes, hence recover by the full sync.
+        lg2::error("Failed to restore the change journal from {FILE}, "
+                   "Error: {ERROR}",
+                   "FILE", _journalFile, "ERROR", e);
+        _entries.clear();
+        _overflowed = true;
+    }
+    journalLog.close();
+
+    compact();
+}
+
+void ChangeJournal::append(std::string_view record, const fs::path& cfgPath,
+                           const fs::path& changedPath)
+{
+    if (++_appendedRecords > compactionFactor * _maxEntries)
+    {
+        // The journal already has this change.
+        compact();
+        return;
+    }
+
+    try
+    {
+        if (!_journalLog.is_open())
+        {
+            fs::create_directories(_journalFile.parent_path());
+            _journalLog.open(_journalFile, std::ios::out | std::ios::app);
+        }
+        _journalLog << nlohmann::json::array(
+                           {record, cfgPath.string(), changedPath.string()})
+                           .dump()
+                    << '\n'
+                    << std::flush;
+        if (!_journalLog)
+        {
+            throw std::runtime_error(
+                std::format("Failed to write {}", _journalFile.string()));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        // The journal is still usable for this boot, hence just log it.
+        lg2::error("Failed to persist the change journal, Error: {ERROR}",
+                   "ERROR", e);
+        _journalLog.close();
+        _journalLog.clear();
+    }
+}
+
+void ChangeJournal::compact()
+{
+    _journalLog.close();
+    _journalLog.clear();
+    _appendedRecords = 0;
+
+    // Written aside and renamed, so that the log is never left partial.
+    const fs::path compactedFile = fs::path(_journalFile).concat(".tmp");
+    try
+    {
+        fs::create_directories(_journalFile.parent_path());
+        std::ofstream compactedLog(compactedFile, std::ios::trunc);
+        if (_overflowed)
+        {
+            compactedLog << nlohmann::json::array({overflowRecord}).dump()
+                         << '\n';
+        }
+        for (const auto& [cfgPath, paths] : _entries)
+        {
+            for (const auto& path : paths)
+            {
+                compactedLog << nlohmann::json::array(
+                                    {addRecord, cfgPath.string(),
+                                     path.string()})
+                                    .dump()
+                             << '\n';
+            }
+        }
+        compactedLog.close();
+        if (!compactedLog)
+        {
+            throw std::runtime_error(
+                std::format("Failed to write {}", compactedFile.string()));
+        }
+        fs::rename(compactedFile, _journalFile);
+    }
+    catch (const std::exception& e)
+    {
+        // The journal is still usable for this boot, hence just log it.
+        lg2::error("Failed to persist the change journal, Error: {ERROR}",
+                   "ERROR", e);
+    }
+}
+
+} // namespace data_sync::journal
@@ -0,0 +1,227 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string_view>
+
+namespace data_sync::journal
+{
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief The changed paths, grouped by the configured path they belong to.
+ */
+using JournalEntries = std::map<fs::path, std::set<fs::path>>;
+
+/**
+ * @class ChangeJournal
+ *
+ * @brief A persistent journal of the paths changed while the changes cannot
+ *        be synced, Eg: when the sync is disabled or the sibling BMC is not
+ *        reachable. Replaying the journal syncs only the changed paths
+ *        instead of a full sync.
+ *
+ * The journal is persisted as an append-only log of the added and removed
+ * paths, one JSON array per line, so that journaling a change doesn't
+ * rewrite the whole journal. The log is compacted into the journaled paths
+ * on restoring it, on clearing it and once it grows beyond a multiple of the
+ * maximum entries.
+ *
+ * The journal is kept bounded as below,
+ *   - A path is not added if it or one of its parent directories is already
+ *     journaled, and adding a directory drops its journaled children.
+ *   - If a directory has more than the collapse threshold children
+ *     journaled, they are replaced by the directory itself.
+ *   - If the number of entries exceeds the maximum, the entries are dropped
+ *     and the journal is marked as overflowed, which needs a full sync to
+ *     recover from.
+ */
+class ChangeJournal
+{
+  public:
+    /**
+     * @brief The default maximum number of entries.
+     */
+    static constexpr size_t defaultMaxEntries = 1024;
+
+    /**
+     * @brief The default number of children of a directory beyond which they
+     *        get collapsed into the directory.
+     */
+    static constexpr size_t defaultCollapseThreshold = 32;
+
+    /**
+     * @brief The number of records appended to the log per the maximum
+     *        entries, beyond which the log gets compacted.
+     */
+    static constexpr size_t compactionFactor = 4;
+
+    ChangeJournal(const ChangeJournal&) = delete;
+    ChangeJournal& operator=(const ChangeJournal&) = delete;
+    ChangeJournal(ChangeJournal&&) = delete;
+    ChangeJournal& operator=(ChangeJournal&&) = delete;
+    ~ChangeJournal() = default;
+
+    /**
+     * @brief Constructor which restores the journal from the given file if
+     *        exists.
+     *
+     * @param[in] journalFile - The file to persist the journal
+     * @param[in] maxEntries - The maximum number of entries
+     * @param[in] collapseThreshold - The number of children of a directory
+     *                                beyond which they get collapsed
+     */
+    explicit ChangeJournal(fs::path journalFile,
+                           size_t maxEntries = defaultMaxEntries,
+                           size_t collapseThreshold = defaultCollapseThreshold);
+
+    /**
+     * @brief API to journal a changed path.
+     *
+     * @param[in] cfgPath - The configured path which the changed path
+     *                      belongs to
+     * @param[in] changedPath - The changed path, the directories are expected
+     *                          to have a trailing slash
+     */
+    void add(const fs::path& cfgPath, const fs::path& changedPath);
+
+    /**
+     * @brief API to remove a journaled path once it is synced.
+     *
+     * @param[in] cfgPath - The configured path which the path belongs to
+     * @param[in] changedPath - The journaled path
+     */
+    void remove(const fs::path& cfgPath, const fs::path& changedPath);
+
+    /**
+     * @brief API to mark the journal as overflowed, i.e. the changes are not
+     *        tracked and a full sync is required.
+     */
+    void markOverflowed();
+
+    /**
+     * @brief API to clear the journal including the overflow state.
+     */
+    void clear();
+
+    /**
+     * @brief API to check whether the journal is overflowed.
+     */
+    bool isOverflowed() const
+    {
+        return _overflowed;
+    }
+
+    /**
+     * @brief API to check whether there is anything to replay.
+     */
+    bool empty() const
+    {
+        return !_overflowed && _entries.empty();
+    }
+
+    /**
+     * @brief API to get the number of the journaled paths.
+     */
+    size_t size() const;
+
+    /**
+     * @brief API to get the journaled paths.
+     */
+    const JournalEntries& getEntries() const
+    {
+        return _entries;
+    }
+
+  private:
+    /**
+     * @brief API to journal a changed path in memory.
+     *
+     * @param[in] cfgPath - The configured path
+     * @param[in] changedPath - The changed path
+     *
+     * @return True if the journal is changed; otherwise False.
+     */
+    bool addEntry(const fs::path& cfgPath, const fs::path& changedPath);
+
+    /**
+     * @brief API to remove a journaled path in memory.
+     *
+     * @param[in] cfgPath - The configured path
+     * @param[in] changedPath - The journaled path
+     *
+     * @return True if the journal is changed; otherwise False.
+     */
+    bool removeEntry(const fs::path& cfgPath, const fs::path& changedPath);
+
+    /**
+     * @brief API to collapse the journaled children of the given directory
+     *        into the directory if they exceed the collapse threshold.
+     *
+     * @param[in] cfgPath - The configured path
+     * @param[in] dir - The parent directory of the newly added path
+     */
+    void collapseIntoParent(const fs::path& cfgPath, const fs::path& dir);
+
+    /**
+     * @brief API to restore the journal by replaying the log.
+     */
+    void load();
+
+    /**
+     * @brief API to append a record of a journal change to the log.
+     *
+     * @param[in] record - The record type
+     * @param[in] cfgPath - The configured path
+     * @param[in] changedPath - The added or removed path
+     */
+    void append(std::string_view record, const fs::path& cfgPath,
+                const fs::path& changedPath);
+
+    /**
+     * @brief API to rewrite the log with just the journaled paths.
+     */
+    void compact();
+
+    /**
+     * @brief The file to persist the journal.
+     */
+    fs::path _journalFile;
+
+    /**
+     * @brief The maximum number of entries.
+     */
+    size_t _maxEntries;
+
+    /**
+     * @brief The number of children beyond which they get collapsed.
+     */
+    size_t _collapseThreshold;
+
+    /**
+     * @brief Indicates the changes are not tracked due to overflow.
+     */
+    bool _overflowed{false};
+
+    /**
+     * @brief The journaled paths.
+     */
+    JournalEntries _entries;
+
+    /**
+     * @brief The log opened to append, once a record is appended.
+     */
+    std::ofstream _journalLog;
+
+    /**
+     * @brief The number of records appended since the last compaction.
+     */
+    size_t _appendedRecords{0};
+};
+
+} // namespace data_sync::journal
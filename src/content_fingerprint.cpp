@@ -0,0 +1,321 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "content_fingerprint.hpp"
+
+#include "utility.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+
+namespace data_sync::fingerprint
+{
+
+namespace
+{
+
+constexpr uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t prime3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+
+/**
+ * @brief The size of the chunks the files are read and hashed in.
+ */
+constexpr size_t readChunkSize = 64 * 1024;
+
+/**
+ * @brief The files larger than this are not hashed, and always synced.
+ */
+constexpr uintmax_t maxHashSize = 64 * 1024 * 1024;
+
+/**
+ * @brief The number of lookups between the stats logs.
+ */
+constexpr size_t statsLogInterval = 1024;
+
+template <typename T>
+T readLE(const uint8_t* data)
+{
+    T value{};
+    std::memcpy(&value, data, sizeof(value));
+    if constexpr (std::endian::native == std::endian::big)
+    {
+        value = std::byteswap(value);
+    }
+    return value;
+}
+
+uint64_t round(uint64_t acc, uint64_t input)
+{
+    acc += input * prime2;
+    acc = std::rotl(acc, 31);
+    return acc * prime1;
+}
+
+uint64_t mergeRound(uint64_t acc, uint64_t value)
+{
+    acc ^= round(0, value);
+    return acc * prime1 + prime4;
+}
+
+/**
+ * @brief The XXH64 hash of the bytes fed in the chunks, the same as of all of
+ *        them at once.
+ */
+class XXH64Stream
+{
+  public:
+    explicit XXH64Stream(uint64_t seed) :
+        _seed(seed), _v1(seed + prime1 + prime2), _v2(seed + prime2),
+        _v3(seed), _v4(seed - prime1)
+    {}
+
+    /**
+     * @brief API to hash the next chunk of the bytes.
+     *
+     * @param[in] data - The bytes to hash
+     */
+    void update(std::span<const uint8_t> data)
+    {
+        _totalSize += data.size();
+
+        // A stripe left over from the previous chunk is completed first
+        if (_bufferedSize > 0)
+        {
+            const auto bytes = std::min(data.size(),
+                                        _buffer.size() - _bufferedSize);
+            std::memcpy(_buffer.data() + _bufferedSize, data.data(), bytes);
+            _bufferedSize += bytes;
+            data = data.subspan(bytes);
+            if (_bufferedSize < _buffer.size())
+            {
+                return;
+            }
+            consumeStripe(_buffer.data());
+            _bufferedSize = 0;
+        }
+
+        while (data.size() >= _buffer.size())
+        {
+            consumeStripe(data.data());
+            data = data.subspan(_buffer.size());
+        }
+        std::memcpy(_buffer.data(), data.data(), data.size());
+        _bufferedSize = data.size();
+    }
+
+    /**
+     * @brief API to get the hash of all the bytes fed so far.
+     */
+    uint64_t digest() const
+    {
+        uint64_t hash{0};
+        if (_totalSize >= _buffer.size())
+        {
+            hash = std::rotl(_v1, 1) + std::rotl(_v2, 7) + std::rotl(_v3, 12) +
+                   std::rotl(_v4, 18);
+            hash = mergeRound(hash, _v1);
+            hash = mergeRound(hash, _v2);
+            hash = mergeRound(hash, _v3);
+            hash = mergeRound(hash, _v4);
+        }
+        else
+        {
+            hash = _seed + prime5;
+        }
+
+        hash += _totalSize;
+
+        const uint8_t* input = _buffer.data();
+        const uint8_t* const end = input + _bufferedSize;
+        while (input + 8 <= end)
+        {
+            hash ^= round(0, readLE<uint64_t>(input));
+            hash = std::rotl(hash, 27) * prime1 + prime4;
+            input += 8;
+        }
+        if (input + 4 <= end)
+        {
+            hash ^= static_cast<uint64_t>(readLE<uint32_t>(input)) * prime1;
+            hash = std::rotl(hash, 23) * prime2 + prime3;
+            input += 4;
+        }
+        while (input < end)
+        {
+            hash ^= (*input) * prime5;
+            hash = std::rotl(hash, 11) * prime1;
+            ++input;
+        }
+
+        hash ^= hash >> 33;
+        hash *= prime2;
+        hash ^= hash >> 29;
+        hash *= prime3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+  private:
+    /**
+     * @brief API to hash a 32 bytes stripe into the accumulators.
+     */
+    void consumeStripe(const uint8_t* stripe)
+    {
+        _v1 = round(_v1, readLE<uint64_t>(stripe));
+        _v2 = round(_v2, readLE<uint64_t>(stripe + 8));
+        _v3 = round(_v3, readLE<uint64_t>(stripe + 16));
+        _v4 = round(_v4, readLE<uint64_t>(stripe + 24));
+    }
+
+    uint64_t _seed;
+    uint64_t _v1;
+    uint64_t _v2;
+    uint64_t _v3;
+    uint64_t _v4;
+    uint64_t _totalSize{0};
+
+    // The bytes of the last incomplete stripe
+    std::array<uint8_t, 32> _buffer{};
+    size_t _bufferedSize{0};
+};
+
+} // namespace
+
+uint64_t xxh64(std::span<const uint8_t> data, uint64_t seed)
+{
+    XXH64Stream stream(seed);
+    stream.update(data);
+    return stream.digest();
+}
+
+std::optional<Fingerprint> getFingerprint(const fs::path& path)
+{
+    utility::FD fd(open(path.c_str(), O_RDONLY | O_NOFOLLOW | O_CLOEXEC));
+    if (fd() == -1)
+    {
+        return std::nullopt;
+    }
+
+    struct stat fileStat{};
+    if (fstat(fd(), &fileStat) == -1 || !S_ISREG(fileStat.st_mode) ||
+        static_cast<uintmax_t>(fileStat.st_size) > maxHashSize)
+    {
+        return std::nullopt;
+    }
+    const auto size = static_cast<size_t>(fileStat.st_size);
+
+    // Read rather than mapped, as a mapped file truncated meanwhile raises
+    // SIGBUS on the access beyond its end.
+    XXH64Stream stream(0);
+    std::array<uint8_t, readChunkSize> chunk{};
+    size_t offset{0};
+    while (offset < size)
+    {
+        auto bytes = pread(fd(), chunk.data(),
+                           std::min(chunk.size(), size - offset),
+                           static_cast<off_t>(offset));
+        if (bytes < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (bytes <= 0)
+        {
+            // Truncated while reading, the next write event follows
+            return std::nullopt;
+        }
+        stream.update({chunk.data(), static_cast<size_t>(bytes)});
+        offset += static_cast<size_t>(bytes);
+    }
+    return Fingerprint{size, stream.digest()};
+}
+
+TimedFingerprint getTimedFingerprint(const fs::path& path)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    auto fingerprint = getFingerprint(path);
+    return {fingerprint,
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - startTime)};
+}
+
+bool FingerprintCache::isUnchanged(const fs::path& path)
+{
+    return isUnchanged(path, getTimedFingerprint(path));
+}
+
+bool FingerprintCache::isUnchanged(const fs::path& path,
+                                   const TimedFingerprint& timedFingerprint)
+{
+    ++_stats.lookups;
+    _stats.hashTime += timedFingerprint.hashTime;
+    const auto& fingerprint = timedFingerprint.fingerprint;
+
+    if (_stats.lookups % statsLogInterval == 0)
+    {
+        const auto seconds = std::chrono::duration<double>(_stats.hashTime)
+                                 .count();
+        lg2::info("Content fingerprint cache: {HITS}/{LOOKUPS} writes "
+                  "unchanged, {BYTES} bytes hashed at {RATE} bytes/s",
+                  "HITS", _stats.hits, "LOOKUPS", _stats.lookups, "BYTES",
+                  _stats.bytesHashed, "RATE",
+                  seconds > 0 ? static_cast<uintmax_t>(
+                                    static_cast<double>(_stats.bytesHashed) /
+                                    seconds)
+                              : 0);
+    }
+
+    if (!fingerprint.has_value())
+    {
+        forget(path);
+        return false;
+    }
+    _stats.bytesHashed += fingerprint->size;
+
+    auto entry = _entries.find(path);
+    if (entry != _entries.end() && entry->second.synced == fingerprint)
+    {
+        ++_stats.hits;
+        entry->second.pending.reset();
+        return true;
+    }
+
+    if (entry == _entries.end())
+    {
+        if (_entries.size() >= maxEntries)
+        {
+            // The files written rarely are synced once more at worst
+            _entries.clear();
+        }
+        entry = _entries.emplace(path, Entry{}).first;
+    }
+    entry->second.pending = fingerprint;
+    return false;
+}
+
+void FingerprintCache::commit(const fs::path& path)
+{
+    if (auto entry = _entries.find(path);
+        entry != _entries.end() && entry->second.pending.has_value())
+    {
+        entry->second.synced = std::exchange(entry->second.pending,
+                                             std::nullopt);
+    }
+}
+
+void FingerprintCache::forget(const fs::path& path)
+{
+    std::erase_if(_entries, [&path](const auto& entry) {
+        return utility::isSameOrChildOf(entry.first, path);
+    });
+}
+
+} // namespace data_sync::fingerprint
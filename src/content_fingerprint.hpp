@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <span>
+
+namespace data_sync::fingerprint
+{
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief API to get the XXH64 hash of the given bytes.
+ *
+ * @param[in] data - The bytes to hash
+ * @param[in] seed - The seed of the hash
+ *
+ * @return The 64 bit hash.
+ */
+uint64_t xxh64(std::span<const uint8_t> data, uint64_t seed = 0);
+
+/**
+ * @brief The fingerprint of the content of a file.
+ */
+struct Fingerprint
+{
+    uintmax_t size;
+    uint64_t hash;
+
+    bool operator==(const Fingerprint&) const = default;
+};
+
+/**
+ * @brief API to get the fingerprint of the given regular file, read and
+ *        hashed in chunks.
+ *
+ * @param[in] path - The file to fingerprint
+ *
+ * @return The fingerprint, or std::nullopt if it is not a regular file or it
+ *         is too large to hash.
+ */
+std::optional<Fingerprint> getFingerprint(const fs::path& path);
+
+/**
+ * @brief The fingerprint of a file along with the time taken to get it, so
+ *        that the file can be hashed off the event loop.
+ */
+struct TimedFingerprint
+{
+    std::optional<Fingerprint> fingerprint;
+    std::chrono::microseconds hashTime{0};
+};
+
+/**
+ * @brief API to get the fingerprint of the given regular file, and the time
+ *        taken to get it.
+ *
+ * @param[in] path - The file to fingerprint
+ *
+ * @return The fingerprint and the time taken.
+ */
+TimedFingerprint getTimedFingerprint(const fs::path& path);
+
+/**
+ * @class FingerprintCache
+ *
+ * @brief Remembers the fingerprints of the files synced to the sibling BMC,
+ *        to drop the writes which didn't change the content of a file before
+ *        spawning an rsync for it.
+ */
+class FingerprintCache
+{
+  public:
+    /**
+     * @brief The cost and effectiveness of the cache.
+     */
+    struct Stats
+    {
+        // The number of the writes checked
+        size_t lookups{0};
+
+        // The number of the writes dropped as the content is unchanged
+        size_t hits{0};
+
+        // The number of bytes hashed
+        uintmax_t bytesHashed{0};
+
+        // The time spent to hash
+        std::chrono::microseconds hashTime{0};
+    };
+
+    /**
+     * @brief The maximum number of files remembered.
+     */
+    static constexpr size_t maxEntries = 4096;
+
+    FingerprintCache() = default;
+    FingerprintCache(const FingerprintCache&) = delete;
+    FingerprintCache& operator=(const FingerprintCache&) = delete;
+    FingerprintCache(FingerprintCache&&) = delete;
+    FingerprintCache& operator=(FingerprintCache&&) = delete;
+    ~FingerprintCache() = default;
+
+    /**
+     * @brief API to check whether the content of the written file is the same
+     *        as its last synced content. Otherwise, the current fingerprint is
+     *        kept to be committed once the file is synced.
+     *
+     * @param[in] path - The written file
+     *
+     * @return True if unchanged; otherwise False.
+     */
+    bool isUnchanged(const fs::path& path);
+
+    /**
+     * @brief API to check whether the content of the written file is the same
+     *        as its last synced content, as per the fingerprint taken
+     *        already. Otherwise, the fingerprint is kept to be committed once
+     *        the file is synced.
+     *
+     * @param[in] path - The written file
+     * @param[in] timedFingerprint - The current fingerprint of the file
+     *
+     * @return True if unchanged; otherwise False.
+     */
+    bool isUnchanged(const fs::path& path,
+                     const TimedFingerprint& timedFingerprint);
+
+    /**
+     * @brief API to record that the file is synced with the content checked
+     *        last by isUnchanged().
+     *
+     * @param[in] path - The synced file
+     */
+    void commit(const fs::path& path);
+
+    /**
+     * @brief API to forget the given path and the files under it, Eg: on
+     *        deleting.
+     *
+     * @param[in] path - The path to forget
+     */
+    void forget(const fs::path& path);
+
+    /**
+     * @brief API to get the cost and effectiveness of the cache.
+     */
+    const Stats& getStats() const
+    {
+        return _stats;
+    }
+
+  private:
+    /**
+     * @brief The fingerprints of a file.
+     */
+    struct Entry
+    {
+        // The content last synced
+        std::optional<Fingerprint> synced;
+
+        // The content last checked, not yet synced
+        std::optional<Fingerprint> pending;
+    };
+
+    /**
+     * @brief The fingerprints by the file.
+     */
+    std::map<fs::path, Entry> _entries;
+
+    /**
+     * @brief The cost and effectiveness of the cache.
+     */
+    Stats _stats;
+};
+
+} // namespace data_sync::fingerprint
@@ -24,11 +24,60 @@ bool Retry::operator==(const Retry& retry) const
            _retryIntervalInSec == retry._retryIntervalInSec;
 }
 
+void NotifyPathTrie::insert(const fs::path& path)
+{
+    size_t node{0};
+    for (const auto& component : path.relative_path())
+    {
+        // The trailing slash results in an empty last component
+        if (component.empty())
+        {
+            continue;
+        }
+        auto [child, inserted] =
+            _nodes[node].children.try_emplace(component.string(),
+                                              _nodes.size());
+        node = child->second;
+        if (inserted)
+        {
+            _nodes.emplace_back();
+        }
+    }
+    _nodes[node].terminal = true;
+}
+
+bool NotifyPathTrie::matches(const fs::path& path) const
+{
+    size_t node{0};
+    for (const auto& component : path.relative_path())
+    {
+        if (_nodes[node].terminal)
+        {
+            return true;
+        }
+        if (component.empty())
+        {
+            continue;
+        }
+        auto child = _nodes[node].children.find(component.string());
+        if (child == _nodes[node].children.end())
+        {
+            return false;
+        }
+        node = child->second;
+    }
+    return _nodes[node].terminal;
+}
+
 NotifySiblingConfig::NotifySiblingConfig(const nlohmann::json& notifySibling)
 {
     if (notifySibling.contains("NotifyOnPaths"))
     {
         _paths = notifySibling["NotifyOnPaths"].get<NotifyOnPaths>();
+        for (const auto& path : _paths.value())
+        {
+            _pathTrie.insert(path);
+        }
     }
     // _notifyReqInfo is copied directly to the sibling BMC.
     // Keys like 'NotifyServices' and 'Mode' will be processed by the sibling.
@@ -39,6 +88,11 @@ NotifySiblingConfig::NotifySiblingConfig(const nlohmann::json& notifySibling)
     _notifyReqInfo.erase("NotifyOnPaths");
 }
 
+bool NotifySiblingConfig::needsNotification(const fs::path& path) const
+{
+    return !_paths.has_value() || _pathTrie.matches(path);
+}
+
 DataSyncConfig::DataSyncConfig(const nlohmann::json& config,
                                const bool isPathDir) :
     _path(config["Path"].get<std::string>()), _isPathDir(isPathDir),
@@ -114,6 +168,11 @@ DataSyncConfig::DataSyncConfig(const nlohmann::json& config,
     {
         _includeList = std::nullopt;
     }
+
+    if (config.contains("ConsistencyGroup"))
+    {
+        _consistencyGroup = config["ConsistencyGroup"].get<std::string>();
+    }
 }
 
 bool DataSyncConfig::operator==(const DataSyncConfig& dataSyncCfg) const
@@ -125,7 +184,8 @@ bool DataSyncConfig::operator==(const DataSyncConfig& dataSyncCfg) const
            _periodicityInSec == dataSyncCfg._periodicityInSec &&
            _retry == dataSyncCfg._retry &&
            _excludeList == dataSyncCfg._excludeList &&
-           _includeList == dataSyncCfg._includeList;
+           _includeList == dataSyncCfg._includeList &&
+           _consistencyGroup == dataSyncCfg._consistencyGroup;
 }
 
 void DataSyncConfig::frameRsyncExcludeList(
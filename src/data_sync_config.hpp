@@ -6,10 +6,12 @@
 
 #include <chrono>
 #include <filesystem>
+#include <map>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_set>
+#include <vector>
 
 namespace data_sync::config
 {
@@ -79,6 +81,50 @@ struct Retry
  */
 using NotifyOnPaths = std::unordered_set<fs::path>;
 
+/**
+ * @class NotifyPathTrie
+ *
+ * @brief The prefix tree of the NotifyOnPaths by the path components, to find
+ *        whether a changed path is one of them or under one of them with a
+ *        single walk of its components.
+ */
+class NotifyPathTrie
+{
+  public:
+    /**
+     * @brief API to add a path to notify on.
+     *
+     * @param[in] path - The absolute path, with or without the trailing slash
+     */
+    void insert(const fs::path& path);
+
+    /**
+     * @brief API to check whether the given path is one of the added paths or
+     *        under one of them.
+     *
+     * @param[in] path - The absolute path of the changed data
+     *
+     * @return True if the path matches; otherwise False.
+     */
+    bool matches(const fs::path& path) const;
+
+  private:
+    /**
+     * @brief A node of the trie, the children are the indexes of the nodes
+     *        by the next path component.
+     */
+    struct Node
+    {
+        std::map<std::string, size_t> children;
+        bool terminal{false};
+    };
+
+    /**
+     * @brief The nodes of the trie, the root is the first one.
+     */
+    std::vector<Node> _nodes{Node{}};
+};
+
 struct NotifySiblingConfig
 {
     /**
@@ -95,6 +141,22 @@ struct NotifySiblingConfig
      */
     std::optional<NotifyOnPaths> _paths;
 
+    /**
+     * @brief The trie of the _paths to match the changed paths against.
+     */
+    NotifyPathTrie _pathTrie;
+
+    /**
+     * @brief API to check whether the change of the given path needs the
+     *        sibling to be notified, that is the NotifyOnPaths are not
+     *        configured or the path is one of them or under one of them.
+     *
+     * @param[in] path - The absolute path of the changed data
+     *
+     * @return True if the sibling needs to be notified; otherwise False.
+     */
+    bool needsNotification(const fs::path& path) const;
+
     /**
      * @brief JSON object describing the notification mode and the list of
      *        services to be notified.
@@ -244,6 +306,16 @@ struct DataSyncConfig
      */
     std::optional<std::unordered_set<fs::path>> _includeList;
 
+    /**
+     * @brief The name of the consistency group of the path. The paths of a
+     *        group are replicated together in a single rsync, so that the
+     *        sibling BMC never sees a partial update of the group.
+     *
+     * @note Holds a value if the path only makes sense along with the other
+     *       paths, Eg: a data file and its checksum file.
+     */
+    std::optional<std::string> _consistencyGroup;
+
     /**
      * @brief Tracks file or directory paths currently being processed for
      *        sync.
@@ -253,6 +325,44 @@ struct DataSyncConfig
      */
     mutable std::unordered_set<fs::path> _syncInProgressPaths;
 
+    /**
+     * @brief Tracks the changes which are not yet replicated to the sibling
+     *        BMC, to find out the replication lag.
+     *
+     *        Maps the changed path to the time of its oldest change not yet
+     *        replicated. An entry is removed once a sync that started after
+     *        the change completes successfully for the path or its parent.
+     */
+    mutable std::map<fs::path, std::chrono::steady_clock::time_point>
+        _pendingChanges;
+
+    /**
+     * @brief Indicates whether the sync events (the inotify watcher or the
+     *        periodic timer) are running for this configuration.
+     *
+     *        The events keep running while the sync is disabled, so that
+     *        enabling it back doesn't need to re-create them.
+     */
+    mutable bool _syncEventsRunning{false};
+
+    /**
+     * @brief Indicates whether the data of the periodic sync is changed or
+     *        failed to sync since its last sync, so that the idle intervals
+     *        can be skipped.
+     *
+     *        Set initially as the data might be changed while the sync
+     *        events were not running.
+     */
+    mutable bool _periodicDirty{true};
+
+    /**
+     * @brief Indicates the running sync events to stop, Eg: as the
+     *        configuration is not eligible to sync anymore after the BMC role
+     *        change. The events stop on their next wake up, and clearing it
+     *        before that keeps them running.
+     */
+    mutable bool _syncEventsStopRequested{false};
+
   private:
     /**
      * @brief A helper API to retrieve the corresponding enum type
@@ -1,10 +1,24 @@
 // SPDX-License-Identifier: Apache-2.0
 
+#include "config.h"
+
 #include "data_watcher.hpp"
 
+#include "event_trace.hpp"
+#include "watch_budget.hpp"
+#include "worker_pool.hpp"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cstring>
+#include <experimental/scope>
+#include <iterator>
 #include <ranges>
 #include <string>
 #include <utility>
@@ -12,29 +26,71 @@
 namespace data_sync::watch::inotify
 {
 
+namespace
+{
+
+} // namespace
+
 DataWatcher::DataWatcher(
     sdbusplus::async::context& ctx, const int inotifyFlags,
     const uint32_t eventMasksToWatch, fs::path dataPathToWatch,
     std::optional<std::unordered_set<fs::path>> excludeList,
     std::optional<std::unordered_set<fs::path>> includeList) :
-    _inotifyFlags(inotifyFlags), _eventMasksToWatch(eventMasksToWatch),
+    _ctx(ctx), _inotifyFlags(inotifyFlags),
+    _eventMasksToWatch(eventMasksToWatch),
     _dataPathToWatch(std::move(dataPathToWatch)),
     _excludeList(std::move(excludeList)), _includeList(std::move(includeList)),
     _inotifyFileDescriptor(inotifyInit()),
-    _fdioInstance(
-        std::make_unique<sdbusplus::async::fdio>(ctx, _inotifyFileDescriptor()))
+    _wakeupFileDescriptor(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+    _epollFileDescriptor(epoll_create1(EPOLL_CLOEXEC))
 {
+    if (_wakeupFileDescriptor() == -1 || _epollFileDescriptor() == -1)
+    {
+        throw std::runtime_error("Failed to create the wakeup fds for " +
+                                 _dataPathToWatch.string());
+    }
+
+#if INOTIFY_READER_THREAD
+    // The events are read on the reader thread and consumed from the ring
+    // once its eventfd is signalled.
+    _readerChannel = InotifyReader::instance().add(_inotifyFileDescriptor(),
+                                                   INOTIFY_RING_CAPACITY);
+    const int eventsFd = _readerChannel->eventFd();
+#else
+    const int eventsFd = _inotifyFileDescriptor();
+#endif
+    for (const int fd : {eventsFd, _wakeupFileDescriptor()})
+    {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (epoll_ctl(_epollFileDescriptor(), EPOLL_CTL_ADD, fd, &event) == -1)
+        {
+            throw std::runtime_error("Failed to wait on the events of " +
+                                     _dataPathToWatch.string());
+        }
+    }
+    _fdioInstance =
+        std::make_unique<sdbusplus::async::fdio>(ctx, _epollFileDescriptor());
     createWatchers(_dataPathToWatch);
 }
 
 DataWatcher::~DataWatcher()
 {
+    if (_readerChannel)
+    {
+        // Stop reading before the inotify fd gets closed
+        InotifyReader::instance().remove(_inotifyFileDescriptor());
+        _fdioInstance.reset();
+    }
+
     if (_inotifyFileDescriptor() >= 0)
     {
         std::ranges::for_each(_watchDescriptors, [this](const auto& wd) {
             if (wd.first >= 0)
             {
                 inotify_rm_watch(_inotifyFileDescriptor(), wd.first);
+                WatchBudget::instance().release();
             }
         });
     }
@@ -146,10 +202,33 @@ fs::path DataWatcher::getExistingParentPath(const fs::path& dataPath)
 void DataWatcher::addToWatchList(const fs::path& pathToWatch,
                                  uint32_t eventMasksToWatch)
 {
+    if (isPolled(pathToWatch))
+    {
+        lg2::debug("{PATH} is covered by the periodic scan", "PATH",
+                   pathToWatch);
+        return;
+    }
+
+    auto& watchBudget = WatchBudget::instance();
+    if (!watchBudget.tryAcquire() &&
+        !(demoteColdestSubtree(pathToWatch) && watchBudget.tryAcquire()))
+    {
+        pollSubtree(pathToWatch);
+        return;
+    }
+
     auto wd = inotify_add_watch(_inotifyFileDescriptor(), pathToWatch.c_str(),
                                 eventMasksToWatch);
+    if (-1 == wd && errno == ENOSPC)
+    {
+        // The system wide limit is reached before the budget
+        watchBudget.release();
+        pollSubtree(pathToWatch);
+        return;
+    }
     if (-1 == wd)
     {
+        watchBudget.release();
         lg2::error(
             "inotify_add_watch call failed for {PATH} with ErrNo : {ERRNO}, "
             "ErrMsg : {ERRMSG}",
@@ -161,15 +240,31 @@ void DataWatcher::addToWatchList(const fs::path& pathToWatch,
     {
         // Add trailing slash for directories to ensure rsync syncs directory
         // contents rather than the directory itself
-        _watchDescriptors.emplace(
+        auto [it, added] = _watchDescriptors.emplace(
             wd,
             (fs::is_directory(pathToWatch) ? pathToWatch / "" : pathToWatch));
+        if (!added)
+        {
+            // The same inode is watched already
+            watchBudget.release();
+        }
+        if (_eventRecorder)
+        {
+            _eventRecorder->recordWatchAdded(wd, _watchDescriptors[wd]);
+        }
         lg2::debug("Watch added. PATH : {PATH}, wd : {WD}", "PATH",
                    _watchDescriptors[wd], "WD", wd);
     }
 }
 
 bool DataWatcher::isPathExcluded(const fs::path& path)
+{
+    return isPathExcluded(path, _excludeList);
+}
+
+bool DataWatcher::isPathExcluded(
+    const fs::path& path,
+    const std::optional<std::unordered_set<fs::path>>& excludeList)
 {
     auto matchesOrParentOfPath = [&path](const auto& excludePath) {
         if (fs::is_directory(path))
@@ -187,11 +282,11 @@ bool DataWatcher::isPathExcluded(const fs::path& path)
             return (path.string() == excludePath.string());
         }
     };
-    if (!_excludeList.has_value())
+    if (!excludeList.has_value())
     {
         return false;
     }
-    if (std::ranges::any_of(_excludeList.value(), matchesOrParentOfPath))
+    if (std::ranges::any_of(excludeList.value(), matchesOrParentOfPath))
     {
         lg2::debug("{PATH} is in exclude list. Hence skipping", "PATH", path);
         return true;
@@ -200,13 +295,20 @@ bool DataWatcher::isPathExcluded(const fs::path& path)
 }
 
 bool DataWatcher::isPathIncluded(const fs::path& path)
+{
+    return isPathIncluded(path, _includeList);
+}
+
+bool DataWatcher::isPathIncluded(
+    const fs::path& path,
+    const std::optional<std::unordered_set<fs::path>>& includeList)
 {
     // A path will be considered as included in the following cases :
     // Case 1. If the given path(file/dir) is present in include list.
     // Case 2. If the given path(file/dir) is child of the path listed in
     // include list.
 
-    if (!_includeList.has_value())
+    if (!includeList.has_value())
     {
         return false;
     }
@@ -214,7 +316,7 @@ bool DataWatcher::isPathIncluded(const fs::path& path)
     fs::path normalizedPath{};
     fs::is_directory(path) ? normalizedPath = path / "" : normalizedPath = path;
 
-    if (_includeList.value().contains(normalizedPath))
+    if (includeList.value().contains(normalizedPath))
     {
         lg2::debug("{PATH} present inside include list", "PATH",
                    normalizedPath);
@@ -228,9 +330,9 @@ bool DataWatcher::isPathIncluded(const fs::path& path)
         return (parentItr == includePath.end()) || (*parentItr == "");
     };
 
-    if (auto itr = std::ranges::find_if(_includeList.value(),
+    if (auto itr = std::ranges::find_if(includeList.value(),
                                         isParentOfNormPath);
-        itr != _includeList.value().end())
+        itr != includeList.value().end())
     {
         lg2::debug("{PATH} is child of the include list path[{INCLUDE}]",
                    "PATH", normalizedPath, "INCLUDE", *itr);
@@ -240,6 +342,13 @@ bool DataWatcher::isPathIncluded(const fs::path& path)
 }
 
 bool DataWatcher::isPathParentOfInclude(const fs::path& path)
+{
+    return isPathParentOfInclude(path, _includeList);
+}
+
+bool DataWatcher::isPathParentOfInclude(
+    const fs::path& path,
+    const std::optional<std::unordered_set<fs::path>>& includeList)
 {
     // If the paths configured in include list is not exists on the
     // filesystem, then it's parent path need to consider as include list and
@@ -261,12 +370,12 @@ bool DataWatcher::isPathParentOfInclude(const fs::path& path)
         return ((parentItr == normalizedPath.end()) || (*parentItr == ""));
     };
 
-    if (!_includeList.has_value())
+    if (!includeList.has_value())
     {
         return false;
     }
-    if (auto itr = std::ranges::find_if(_includeList.value(), childOfPath);
-        itr != _includeList.value().end())
+    if (auto itr = std::ranges::find_if(includeList.value(), childOfPath);
+        itr != includeList.value().end())
     {
         lg2::debug("{PATH} is parent of the include list path[{INCLUDE}]",
                    "PATH", path, "INCLUDE", *itr);
@@ -275,6 +384,23 @@ bool DataWatcher::isPathParentOfInclude(const fs::path& path)
     return false;
 }
 
+std::vector<fs::path> DataWatcher::collectSubDirs(
+    const fs::path& dir,
+    const std::optional<std::unordered_set<fs::path>>& excludeList)
+{
+    std::vector<fs::path> subDirs;
+    for (const auto& entry : fs::recursive_directory_iterator(dir))
+    {
+        // If ExcldueList is configured, exclude those directories from
+        // monitoring and add watch for rest.
+        if (entry.is_directory() && !isPathExcluded(entry.path(), excludeList))
+        {
+            subDirs.emplace_back(entry.path());
+        }
+    }
+    return subDirs;
+}
+
 void DataWatcher::addSubDirWatches(const fs::path& pathToWatch)
 {
     if (!fs::is_directory(pathToWatch))
@@ -285,20 +411,48 @@ void DataWatcher::addSubDirWatches(const fs::path& pathToWatch)
         return;
     }
 
-    auto addWatchIfDir = [this](const fs::path& entry) {
-        if (fs::is_directory(entry))
+    if (_deferSubDirWalks)
+    {
+        _pendingSubDirWalks.emplace_back(pathToWatch);
+        return;
+    }
+
+    for (const auto& subDir : collectSubDirs(pathToWatch, _excludeList))
+    {
+        addToWatchList(subDir, _eventMasksToWatch);
+    }
+}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<> DataWatcher::addPendingSubDirWatches()
+{
+    while (!_pendingSubDirWalks.empty())
+    {
+        const auto dirs = std::exchange(_pendingSubDirWalks, {});
+        for (const auto& dir : dirs)
         {
-            // If ExcldueList is configured, exclude those directories
-            // from monitoring and add watch for rest.
-            if (_excludeList.has_value() && isPathExcluded(entry))
+            try
             {
-                return;
+                // A large tree takes long to walk, hence walk it off the
+                // event loop and just add the watches on it.
+                auto subDirs = co_await worker::WorkerPool::instance().run(
+                    _ctx, [dir, excludeList = _excludeList]() {
+                    return collectSubDirs(dir, excludeList);
+                });
+                for (const auto& subDir : subDirs)
+                {
+                    addToWatchList(subDir, _eventMasksToWatch);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                lg2::error("Failed to watch the subdirectories of {PATH}, "
+                           "Error : {ERROR}",
+                           "PATH", dir, "ERROR", e);
             }
-            addToWatchList(entry, _eventMasksToWatch);
         }
-    };
-    std::ranges::for_each(fs::recursive_directory_iterator(pathToWatch),
-                          addWatchIfDir);
+    }
+    co_return;
 }
 
 void DataWatcher::createWatchers(const fs::path& pathToWatch)
@@ -378,17 +532,84 @@ void DataWatcher::createWatchers(const fs::path& pathToWatch)
 // NOLINTNEXTLINE
 sdbusplus::async::task<DataOperations> DataWatcher::onDataChange()
 {
+    if (!_snapshotTaken)
+    {
+        // NOLINTNEXTLINE
+        co_await initSnapshot();
+    }
+
     // NOLINTNEXTLINE
     co_await _fdioInstance->next();
 
-    if (auto receivedEvents = readEvents(); receivedEvents.has_value())
+    // The events, if any, are left queued for the next call
+    uint64_t wakeups{0};
+    if (read(_wakeupFileDescriptor(), &wakeups, sizeof(wakeups)) > 0)
+    {
+        co_return DataOperations{};
+    }
+
+    _correlationId = tracing::SpanTracer::instance().newCorrelationId();
+    std::optional<std::vector<EventInfo>> receivedEvents;
     {
+        tracing::ScopedSpan span(_correlationId, tracing::Stage::InotifyRead,
+                                 _dataPathToWatch.string());
+        receivedEvents = _readerChannel ? consumeEvents() : readEvents();
+    }
+
+    if (receivedEvents.has_value())
+    {
+        tracing::ScopedSpan span(_correlationId, tracing::Stage::EventClassify,
+                                 std::to_string(receivedEvents->size()) +
+                                     " events");
+        _deferSubDirWalks = true;
+        using std::experimental::scope_exit;
+        auto walksDeferred = scope_exit([this]() noexcept {
+            _deferSubDirWalks = false;
+        });
         processEvents(receivedEvents.value());
     }
 
+    if (_rescanPending)
+    {
+        _rescanPending = false;
+        // NOLINTNEXTLINE
+        co_await rescanInBackground();
+    }
+
+    // Watched before the resulted syncs, which cover the changes in the new
+    // subdirectories until then.
+    // NOLINTNEXTLINE
+    co_await addPendingSubDirWatches();
+
     co_return _dataOperations;
 }
 
+// NOLINTNEXTLINE
+sdbusplus::async::task<> DataWatcher::initSnapshot()
+{
+    if (_snapshotTaken)
+    {
+        co_return;
+    }
+    _snapshotTaken = true;
+
+    // A large tree takes long to walk, hence walk it off the event loop. The
+    // changes till then are in the snapshot itself.
+    _snapshot = co_await worker::WorkerPool::instance().run(
+        _ctx, [dataPath = _dataPathToWatch, excludeList = _excludeList,
+               includeList = _includeList]() {
+        return takeSnapshot(dataPath, excludeList, includeList);
+    });
+    co_return;
+}
+
+void DataWatcher::wakeUp()
+{
+    uint64_t count{1};
+    [[maybe_unused]] auto rc = write(_wakeupFileDescriptor(), &count,
+                                     sizeof(count));
+}
+
 std::optional<std::vector<EventInfo>> DataWatcher::readEvents()
 {
     // Before reading the events clear the map of data operation to remove the
@@ -398,58 +619,196 @@ std::optional<std::vector<EventInfo>> DataWatcher::readEvents()
         _dataOperations.clear();
     }
 
-    // Maximum inotify events supported in the buffer
-    constexpr auto maxBytes = sizeof(struct inotify_event) + NAME_MAX + 1;
-    uint8_t buffer[maxBytes];
-    std::memset(buffer, '\0', maxBytes);
+    // Maximum events processed per wakeup, so that a burst doesn't hold the
+    // event loop for long. The rest stay queued and wake up the fdio again.
+    constexpr size_t maxBatchSize = 256;
+
+    // The buffer fits many events of the typical name lengths, and at least
+    // one of the longest name
+    constexpr auto maxEventBytes = sizeof(struct inotify_event) + NAME_MAX + 1;
+    constexpr auto maxBytes = 16 * maxEventBytes;
+    alignas(struct inotify_event) std::array<uint8_t, maxBytes> buffer{};
 
-    auto bytes = read(_inotifyFileDescriptor(), buffer, maxBytes);
-    if (0 > bytes)
+    // Drain the queued events rather than a single read, so that a burst of
+    // changes is seen together by the callers.
+    std::vector<EventInfo> events;
+    while (events.size() < maxBatchSize)
     {
-        // In non blocking mode, read returns immediately with EAGAIN /
-        // EWOULDBLOCK when no data is available, instead of waiting.
-        if (errno != EAGAIN && errno != EWOULDBLOCK)
+        auto bytes = read(_inotifyFileDescriptor(), buffer.data(), maxBytes);
+        if (0 >= bytes)
         {
-            lg2::error("Failed to read inotify event, error: {ERROR}", "ERROR",
-                       strerror(errno));
+            // In non blocking mode, read returns immediately with EAGAIN /
+            // EWOULDBLOCK when no data is available, instead of waiting.
+            if (0 > bytes && errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                lg2::error("Failed to read inotify event, error: {ERROR}",
+                           "ERROR", strerror(errno));
+            }
+            break;
         }
+
+        auto parsedEvents =
+            parseEvents({buffer.data(), static_cast<size_t>(bytes)});
+        std::ranges::move(parsedEvents, std::back_inserter(events));
+    }
+
+    if (events.empty())
+    {
         return std::nullopt;
     }
+    return filterEvents(events);
+}
 
-    auto offset = 0;
+std::optional<std::vector<EventInfo>> DataWatcher::consumeEvents()
+{
+    if (!_dataOperations.empty())
+    {
+        _dataOperations.clear();
+    }
+
+    // Maximum events processed per wakeup, so that a burst doesn't hold the
+    // event loop for long.
+    constexpr size_t maxBatchSize = 256;
+
+    uint64_t count{0};
+    [[maybe_unused]] auto rc = read(_readerChannel->eventFd(), &count,
+                                    sizeof(count));
+
+    std::vector<EventInfo> events;
+    while (events.size() < maxBatchSize)
+    {
+        auto event = _readerChannel->events.pop();
+        if (!event.has_value())
+        {
+            break;
+        }
+        events.emplace_back(std::move(event.value()));
+    }
+
+    if (!_readerChannel->events.empty())
+    {
+        // Wake up again for the rest of the events
+        count = 1;
+        rc = write(_readerChannel->eventFd(), &count, sizeof(count));
+    }
+
+    if (_readerChannel->overflowed.exchange(false, std::memory_order_acquire))
+    {
+        lg2::warning("Inotify events dropped for {PATH} as the ring is full, "
+                     "Capacity : {CAPACITY}, HighWatermark : {HIGH}, "
+                     "Overflows : {OVERFLOWS}",
+                     "PATH", _dataPathToWatch, "CAPACITY",
+                     _readerChannel->events.capacity(), "HIGH",
+                     _readerChannel->events.highWatermark(), "OVERFLOWS",
+                     _readerChannel->events.overflows());
+
+        // The same as the kernel queue overflow, the dropped changes are
+        // unknown.
+        events.emplace_back(-1, "", IN_Q_OVERFLOW, 0);
+    }
+
+    if (events.empty())
+    {
+        return std::nullopt;
+    }
+    return filterEvents(events);
+}
+
+std::vector<EventInfo>
+    DataWatcher::filterEvents(const std::vector<EventInfo>& events)
+{
     std::vector<EventInfo> receivedEvents{};
-    while (offset < bytes)
+    for (const auto& event : events)
     {
-        // NOLINTNEXTLINE to avoid cppcoreguidelines-pro-type-reinterpret-cast
-        auto* receivedEvent = reinterpret_cast<inotify_event*>(&buffer[offset]);
+        const auto& [wd, name, mask, cookie] = event;
 
+        auto watchedPath = _watchDescriptors.find(wd);
         lg2::debug("Received {EVENTS} from {PATH}, wd:{WD} and name : {NAME}",
-                   "EVENTS", eventName(receivedEvent->mask), "PATH",
-                   _watchDescriptors[receivedEvent->wd], "WD",
-                   receivedEvent->wd, "NAME", receivedEvent->name);
-
-        if (((receivedEvent->mask & _eventMasksToWatch) != 0) ||
-            ((receivedEvent->mask & _eventMasksIfNotExists) != 0))
+                   "EVENTS", eventName(mask), "PATH",
+                   watchedPath != _watchDescriptors.end() ? watchedPath->second
+                                                          : fs::path{},
+                   "WD", wd, "NAME", name);
+
+        // The queue overflow and the watch removal are not the watched
+        // events, they are received for all the watches.
+        if (((mask & _eventMasksToWatch) != 0) ||
+            ((mask & _eventMasksIfNotExists) != 0) ||
+            ((mask & (IN_Q_OVERFLOW | IN_IGNORED)) != 0))
         {
-            receivedEvents.emplace_back(receivedEvent->wd, receivedEvent->name,
-                                        receivedEvent->mask,
-                                        receivedEvent->cookie);
+            receivedEvents.emplace_back(event);
         }
         else
         {
             lg2::debug("Skipping the uninterested events[{EVENTS}] for the "
                        "configured path : {PATH}",
-                       "EVENTS", eventName(receivedEvent->mask), "PATH",
-                       _dataPathToWatch);
+                       "EVENTS", eventName(mask), "PATH", _dataPathToWatch);
         }
-        offset += offsetof(inotify_event, name) + receivedEvent->len;
+    }
+
+    // Record all the events, the uninterested events can be filtered while
+    // replaying.
+    if (_eventRecorder && !events.empty())
+    {
+        _eventRecorder->recordEvents(events);
     }
     return receivedEvents;
 }
 
+void DataWatcher::startRecording(const fs::path& traceFile)
+{
+    _eventRecorder = std::make_unique<trace::EventRecorder>(traceFile,
+                                                            _dataPathToWatch);
+    for (const auto& [wd, path] : _watchDescriptors)
+    {
+        _eventRecorder->recordWatchAdded(wd, path);
+    }
+}
+
+DataOperations DataWatcher::replayEvents(const std::vector<EventInfo>& events)
+{
+    _dataOperations.clear();
+    _correlationId = tracing::SpanTracer::instance().newCorrelationId();
+    tracing::ScopedSpan span(
+        _correlationId, tracing::Stage::EventClassify,
+        std::to_string(events.size()) + " replayed events");
+
+    // Apply the same filtering as for the live events since the trace holds
+    // all the received events.
+    auto interestedEvents =
+        events | std::views::filter([this](const auto& event) {
+        return ((std::get<2>(event) & _eventMasksToWatch) != 0) ||
+               ((std::get<2>(event) & _eventMasksIfNotExists) != 0) ||
+               ((std::get<2>(event) & (IN_Q_OVERFLOW | IN_IGNORED)) != 0);
+    });
+    processEvents(std::vector<EventInfo>(interestedEvents.begin(),
+                                         interestedEvents.end()));
+    if (_rescanPending)
+    {
+        _rescanPending = false;
+        rescan();
+    }
+    return _dataOperations;
+}
+
+std::optional<WD> DataWatcher::getWatchDescriptor(const fs::path& path) const
+{
+    auto it = std::ranges::find_if(_watchDescriptors,
+                                   [&path](const auto& wdPair) {
+        return wdPair.second == path;
+    });
+    if (it == _watchDescriptors.end())
+    {
+        return std::nullopt;
+    }
+    return it->first;
+}
+
 void DataWatcher::processEvents(
     const std::vector<EventInfo>& receivedEventsInfo)
 {
+    _renames.clear();
+    expireMovedFrom();
+
     std::ranges::for_each(receivedEventsInfo, [this](const auto& event) {
         std::optional<DataOperation> dataOperation = processEvent(event);
         if (dataOperation.has_value())
@@ -457,6 +816,484 @@ void DataWatcher::processEvents(
             _dataOperations.emplace_back(dataOperation.value());
         }
     });
+    updateSnapshot(_dataOperations);
+}
+
+void DataWatcher::expireMovedFrom()
+{
+    const auto now = std::chrono::steady_clock::now();
+    auto expired = std::erase_if(_movedFromDataOps,
+                                 [&now](const auto& movedFrom) {
+        return now - movedFrom.second.second > movedFromExpiry;
+    });
+
+    // The cookies are increasing, hence the first ones are the oldest
+    while (_movedFromDataOps.size() > maxUnmatchedMoves)
+    {
+        _movedFromDataOps.erase(_movedFromDataOps.begin());
+        ++expired;
+    }
+
+    if (expired != 0)
+    {
+        lg2::debug("Forgot {COUNT} IN_MOVED_FROM without the IN_MOVED_TO for "
+                   "{PATH}",
+                   "COUNT", expired, "PATH", _dataPathToWatch);
+    }
+}
+
+void DataWatcher::renamePath(const fs::path& from, const fs::path& to)
+{
+    auto renamed = [&from, &to](const fs::path& path) {
+        const auto toPath = utility::withoutTrailingSlash(to);
+        auto relative = utility::withoutTrailingSlash(path).lexically_relative(
+            utility::withoutTrailingSlash(from));
+        auto renamedPath = (relative == ".") ? toPath : toPath / relative;
+        return path.has_filename() ? renamedPath : renamedPath / "";
+    };
+
+    for (auto& [wd, path] : _watchDescriptors)
+    {
+        if (utility::isSameOrChildOf(path, from))
+        {
+            path = renamed(path);
+            if (_eventRecorder)
+            {
+                _eventRecorder->recordWatchAdded(wd, path);
+            }
+        }
+    }
+
+    if (_snapshot.has_value())
+    {
+        auto entries = std::views::keys(*_snapshot) |
+                       std::views::filter([&from](const fs::path& path) {
+            return utility::isSameOrChildOf(path, from);
+        });
+        std::vector<fs::path> renamedEntries(entries.begin(), entries.end());
+        for (const auto& entry : renamedEntries)
+        {
+            auto node = _snapshot->extract(entry);
+            node.key() = renamed(entry);
+            _snapshot->insert(std::move(node));
+        }
+    }
+}
+
+bool DataWatcher::isSkipped(const fs::path& path)
+{
+    return isSkipped(path, _excludeList, _includeList);
+}
+
+bool DataWatcher::isSkipped(
+    const fs::path& path,
+    const std::optional<std::unordered_set<fs::path>>& excludeList,
+    const std::optional<std::unordered_set<fs::path>>& includeList)
+{
+    return path.filename().string().starts_with(".") ||
+           (excludeList.has_value() && isPathExcluded(path, excludeList)) ||
+           (includeList.has_value() && !isPathIncluded(path, includeList) &&
+            !isPathParentOfInclude(path, includeList));
+}
+
+bool DataWatcher::isPolled(const fs::path& path) const
+{
+    return std::ranges::any_of(_polledSubtrees, [&path](const auto& subtree) {
+        return utility::isSameOrChildOf(path, subtree.first);
+    });
+}
+
+std::vector<fs::path> DataWatcher::getPolledSubtrees() const
+{
+    auto roots = std::views::keys(_polledSubtrees);
+    return {roots.begin(), roots.end()};
+}
+
+void DataWatcher::pollSubtree(const fs::path& path)
+{
+    const auto root = utility::withoutTrailingSlash(path);
+    const bool wasPolling = !_polledSubtrees.empty();
+
+    // The polled subtrees under it are covered by its scan
+    std::erase_if(_polledSubtrees, [&root](const auto& subtree) {
+        return utility::isSameOrChildOf(subtree.first, root);
+    });
+    _polledSubtrees.emplace(
+        root, std::make_unique<scan::SubtreeScanner>(
+                  root, [this](const fs::path& entry) {
+        return isSkipped(entry);
+    }));
+
+    lg2::warning("No inotify watch available within the budget, {PATH} is "
+                 "scanned every {INTERVAL}s instead",
+                 "PATH", root, "INTERVAL", POLL_SCAN_INTERVAL);
+
+    if (!wasPolling && _pollingStarted)
+    {
+        _pollingStarted();
+    }
+}
+
+bool DataWatcher::demoteColdestSubtree(const fs::path& pathToWatch)
+{
+    const auto root = utility::withoutTrailingSlash(_dataPathToWatch);
+
+    // The candidates are the top level subdirectories of the configured path
+    // along with their events and watches.
+    std::map<fs::path, std::pair<size_t, std::vector<WD>>> subtrees;
+    for (const auto& [wd, path] : _watchDescriptors)
+    {
+        const auto dir = utility::withoutTrailingSlash(path);
+        if (dir == root || !utility::isSameOrChildOf(dir, root))
+        {
+            continue;
+        }
+        const auto topLevel = root / *dir.lexically_relative(root).begin();
+        if (utility::isSameOrChildOf(pathToWatch, topLevel))
+        {
+            continue;
+        }
+
+        auto& [churn, wds] = subtrees[topLevel];
+        if (auto events = _churn.find(wd); events != _churn.end())
+        {
+            churn += events->second;
+        }
+        wds.emplace_back(wd);
+    }
+    if (subtrees.empty())
+    {
+        return false;
+    }
+
+    // The least events first, and the most watches among them
+    auto coldest = std::ranges::min_element(subtrees, [](const auto& lhs,
+                                                         const auto& rhs) {
+        return std::make_pair(lhs.second.first, rhs.second.second.size()) <
+               std::make_pair(rhs.second.first, lhs.second.second.size());
+    });
+
+    lg2::info("Moving {PATH} with {WATCHES} watches and {EVENTS} recent "
+              "events to the periodic scan, to free the inotify watches",
+              "PATH", coldest->first, "WATCHES",
+              coldest->second.second.size(), "EVENTS",
+              coldest->second.first);
+    std::ranges::for_each(coldest->second.second,
+                          [this](WD wd) { removeWatch(wd); });
+    pollSubtree(coldest->first);
+    return true;
+}
+
+DataOperations DataWatcher::pollSubtrees()
+{
+    DataOperations dataOperations;
+    for (auto& [wd, churn] : _churn)
+    {
+        churn /= 2;
+    }
+
+    const auto root = utility::withoutTrailingSlash(_dataPathToWatch);
+    std::vector<fs::path> hotSubtrees;
+    for (const auto& [subtreeRoot, scanner] : _polledSubtrees)
+    {
+        auto changes = scanner->scan();
+
+        // The parent of the configured path might be polled if it doesn't
+        // exist, and only the changes of the configured path are of interest.
+        auto isInterested = [this, &root](const fs::path& path) {
+            return utility::isSameOrChildOf(path, root) &&
+                   (!_includeList.has_value() || isPathIncluded(path));
+        };
+        for (auto& path : changes.modified)
+        {
+            if (isInterested(path))
+            {
+                dataOperations.emplace_back(std::move(path), DataOps::COPY);
+            }
+        }
+        for (auto& path : changes.removed)
+        {
+            if (isInterested(path))
+            {
+                dataOperations.emplace_back(std::move(path), DataOps::DELETE);
+            }
+        }
+
+        // The subtree which keeps changing is worth the watches, with the
+        // room for its growth.
+        if (!changes.empty() && WatchBudget::instance().getAvailable() >
+                                    2 * (scanner->getDirCount() + 1))
+        {
+            hotSubtrees.emplace_back(subtreeRoot);
+        }
+    }
+
+    for (const auto& subtreeRoot : hotSubtrees)
+    {
+        lg2::info("Moving {PATH} back to the inotify watches", "PATH",
+                  subtreeRoot);
+        _polledSubtrees.erase(subtreeRoot);
+        try
+        {
+            const bool isUnderRoot = utility::isSameOrChildOf(subtreeRoot,
+                                                              root);
+            addToWatchList(subtreeRoot, isUnderRoot ? _eventMasksToWatch
+                                                    : _eventMasksIfNotExists);
+            if (isUnderRoot && fs::is_directory(subtreeRoot))
+            {
+                addSubDirWatches(subtreeRoot);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error("Failed to watch {PATH}, Error : {ERROR}", "PATH",
+                       subtreeRoot, "ERROR", e);
+        }
+    }
+
+    updateSnapshot(dataOperations);
+    return dataOperations;
+}
+
+std::optional<Snapshot> DataWatcher::takeSnapshot(
+    const fs::path& dataPath,
+    const std::optional<std::unordered_set<fs::path>>& excludeList,
+    const std::optional<std::unordered_set<fs::path>>& includeList)
+{
+    Snapshot snapshot;
+    std::error_code ec;
+    if (!fs::exists(dataPath, ec))
+    {
+        return snapshot;
+    }
+
+    // Without the trailing slash, to find the children by their parent
+    const auto root = utility::withoutTrailingSlash(dataPath);
+    snapshot.emplace(root, fs::last_write_time(root, ec));
+    if (!fs::is_directory(dataPath, ec))
+    {
+        return snapshot;
+    }
+
+    for (auto it = fs::recursive_directory_iterator(
+             dataPath, fs::directory_options::skip_permission_denied, ec);
+         !ec && it != fs::recursive_directory_iterator(); it.increment(ec))
+    {
+        if (isSkipped(it->path(), excludeList, includeList))
+        {
+            it.disable_recursion_pending();
+            continue;
+        }
+        if (snapshot.size() >= maxSnapshotEntries)
+        {
+            return std::nullopt;
+        }
+        snapshot.emplace(it->path(), it->last_write_time(ec));
+    }
+    return snapshot;
+}
+
+void DataWatcher::updateSnapshot(const DataOperations& dataOperations)
+{
+    if (!_snapshot.has_value())
+    {
+        return;
+    }
+
+    // A path written many times in the batch is stat'ed once, as its mtime
+    // is the current one anyway.
+    std::unordered_set<fs::path> updatedEntries;
+    std::error_code ec;
+    for (const auto& [path, dataOp] : dataOperations)
+    {
+        // The directory paths are with the trailing slash
+        auto entry = utility::withoutTrailingSlash(path);
+        if (dataOp == DataOps::DELETE)
+        {
+            // The children follow their parent in the path order
+            auto first = _snapshot->lower_bound(entry);
+            auto last = std::find_if(first, _snapshot->end(),
+                                     [&entry](const auto& snapshotEntry) {
+                return !utility::isSameOrChildOf(snapshotEntry.first, entry);
+            });
+            _snapshot->erase(first, last);
+            updatedEntries.clear();
+            continue;
+        }
+
+        if (updatedEntries.contains(entry))
+        {
+            continue;
+        }
+        auto mtime = fs::last_write_time(entry, ec);
+        if (ec)
+        {
+            continue;
+        }
+        if (_snapshot->size() >= maxSnapshotEntries &&
+            !_snapshot->contains(entry))
+        {
+            _snapshot.reset();
+            return;
+        }
+        _snapshot->insert_or_assign(entry, mtime);
+        updatedEntries.emplace(std::move(entry));
+    }
+}
+
+DataWatcher::RescanResult DataWatcher::scanChanges(
+    const fs::path& dataPath,
+    const std::optional<std::unordered_set<fs::path>>& excludeList,
+    const std::optional<std::unordered_set<fs::path>>& includeList,
+    const std::optional<Snapshot>& previous,
+    const std::unordered_set<fs::path>& watchedPaths)
+{
+    RescanResult result;
+    result.snapshot = takeSnapshot(dataPath, excludeList, includeList);
+    if (!previous.has_value() || !result.snapshot.has_value())
+    {
+        // Unknown what is changed, hence sync the whole configured path
+        result.fallback = true;
+        result.dataOperations.emplace_back(dataPath, DataOps::COPY);
+        return result;
+    }
+
+    // A new or removed directory covers its children
+    const auto root = utility::withoutTrailingSlash(dataPath);
+    auto isTopLevel = [&root](const fs::path& path, const Snapshot& snapshot) {
+        return path == root || snapshot.contains(path.parent_path());
+    };
+
+    const auto& snapshot = *result.snapshot;
+    std::error_code ec;
+    for (const auto& [path, mtime] : snapshot)
+    {
+        const bool isDir = fs::is_directory(path, ec);
+        if (isDir && !watchedPaths.contains(path / "") &&
+            !watchedPaths.contains(path))
+        {
+            result.unwatchedDirs.emplace_back(path);
+        }
+
+        auto previousEntry = previous->find(path);
+        if (previousEntry == previous->end())
+        {
+            if (isTopLevel(path, *previous))
+            {
+                result.dataOperations.emplace_back(isDir ? path / "" : path,
+                                                   DataOps::COPY);
+            }
+        }
+        else if (!isDir && previousEntry->second != mtime)
+        {
+            // The directory mtime changes only for the added or removed
+            // entries, which are found by themselves.
+            result.dataOperations.emplace_back(path, DataOps::COPY);
+        }
+    }
+
+    for (const auto& [path, mtime] : *previous)
+    {
+        if (!snapshot.contains(path) && isTopLevel(path, snapshot))
+        {
+            result.dataOperations.emplace_back(path, DataOps::DELETE);
+        }
+    }
+    return result;
+}
+
+void DataWatcher::rescan()
+{
+    tracing::ScopedSpan span(_correlationId, tracing::Stage::OverflowRescan,
+                             _dataPathToWatch.string());
+    const auto start = tracing::Clock::now();
+
+    applyRescan(scanChanges(_dataPathToWatch, _excludeList, _includeList,
+                            _snapshot, getWatchedPaths()),
+                start, span);
+}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<> DataWatcher::rescanInBackground()
+{
+    tracing::ScopedSpan span(_correlationId, tracing::Stage::OverflowRescan,
+                             _dataPathToWatch.string());
+    const auto start = tracing::Clock::now();
+
+    // The snapshot is being retaken, hence not updated meanwhile
+    auto result = co_await worker::WorkerPool::instance().run(
+        _ctx, [dataPath = _dataPathToWatch, excludeList = _excludeList,
+               includeList = _includeList,
+               previous = std::exchange(_snapshot, std::nullopt),
+               watchedPaths = getWatchedPaths()]() {
+        return scanChanges(dataPath, excludeList, includeList, previous,
+                           watchedPaths);
+    });
+    applyRescan(std::move(result), start, span);
+    co_return;
+}
+
+std::unordered_set<fs::path> DataWatcher::getWatchedPaths() const
+{
+    // Looked up per snapshot entry, hence not searched in the watch
+    // descriptors each time.
+    std::unordered_set<fs::path> watchedPaths;
+    watchedPaths.reserve(_watchDescriptors.size());
+    for (const auto& [wd, watchedPath] : _watchDescriptors)
+    {
+        watchedPaths.emplace(watchedPath);
+    }
+    return watchedPaths;
+}
+
+void DataWatcher::applyRescan(RescanResult result,
+                              tracing::Clock::time_point start,
+                              tracing::ScopedSpan& span)
+{
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    _snapshot = std::move(result.snapshot);
+    ++_rescanStats.rescans;
+    if (result.fallback)
+    {
+        ++_rescanStats.fallbacks;
+    }
+
+    for (const auto& dir : result.unwatchedDirs)
+    {
+        try
+        {
+            addToWatchList(dir, _eventMasksToWatch);
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error("Failed to watch {PATH} while rescanning, "
+                       "Error : {ERROR}",
+                       "PATH", dir, "ERROR", e);
+        }
+    }
+
+    const auto changes = result.dataOperations.size();
+    std::ranges::move(result.dataOperations,
+                      std::back_inserter(_dataOperations));
+
+    const auto duration = duration_cast<microseconds>(tracing::Clock::now() -
+                                                      start);
+    _rescanStats.lastScannedEntries = _snapshot.has_value() ? _snapshot->size()
+                                                            : 0;
+    _rescanStats.lastDuration = duration;
+    _rescanStats.totalDuration += duration;
+
+    span.setDetail(_dataPathToWatch.string() + " Changes: " +
+                   std::to_string(changes));
+    lg2::warning("Rescanned {PATH} after the inotify event queue overflow, "
+                 "Changes : {CHANGES}, Entries : {ENTRIES}, Duration : "
+                 "{DURATION}us, Rescans : {RESCANS}, Fallbacks : {FALLBACKS}",
+                 "PATH", _dataPathToWatch, "CHANGES", changes, "ENTRIES",
+                 _rescanStats.lastScannedEntries, "DURATION", duration.count(),
+                 "RESCANS", _rescanStats.rescans, "FALLBACKS",
+                 _rescanStats.fallbacks);
 }
 
 std::optional<DataOperation>
@@ -475,9 +1312,49 @@ std::optional<DataOperation>
         return std::nullopt;
     }
 
-    fs::path eventReceivedFor =
-        _watchDescriptors.at(std::get<WD>(receivedEventInfo)) /
-        std::get<BaseName>(receivedEventInfo);
+    if ((std::get<2>(receivedEventInfo) & IN_Q_OVERFLOW) != 0)
+    {
+        // The events got lost, hence the configured path is rescanned once
+        // the received events are processed.
+        lg2::warning("Inotify event queue overflowed for {PATH}", "PATH",
+                     _dataPathToWatch);
+        _rescanPending = true;
+        return std::nullopt;
+    }
+
+    if ((std::get<2>(receivedEventInfo) & IN_IGNORED) != 0)
+    {
+        // The kernel removed the watch as its path got deleted, unless it is
+        // removed by the watcher already.
+        if (auto wd = std::get<WD>(receivedEventInfo);
+            _watchDescriptors.erase(wd) != 0)
+        {
+            _churn.erase(wd);
+            WatchBudget::instance().release();
+            if (_eventRecorder)
+            {
+                _eventRecorder->recordWatchRemoved(wd);
+            }
+        }
+        return std::nullopt;
+    }
+
+    // The watch may be removed while its events are still queued, Eg: its
+    // subtree is moved to the periodic scan which covers them.
+    auto watched = _watchDescriptors.find(std::get<WD>(receivedEventInfo));
+    if (watched == _watchDescriptors.end())
+    {
+        lg2::debug("Skipping the {EVENTS} for {NAME} as its watch {WD} is "
+                   "removed",
+                   "EVENTS", eventName(std::get<2>(receivedEventInfo)), "NAME",
+                   std::get<BaseName>(receivedEventInfo), "WD",
+                   std::get<WD>(receivedEventInfo));
+        return std::nullopt;
+    }
+
+    fs::path eventReceivedFor = watched->second /
+                                std::get<BaseName>(receivedEventInfo);
+    ++_churn[std::get<WD>(receivedEventInfo)];
 
     // Skip the events received for the paths which are in excluded list and not
     // in include list.
@@ -712,9 +1589,10 @@ std::optional<DataOperation>
                "PATH", absMovedPath, "COOKIE", std::get<3>(receivedEventInfo));
     if (absMovedPath.string().starts_with(_dataPathToWatch.string()))
     {
-        _movedFromDataOps.emplace(
+        _movedFromDataOps.insert_or_assign(
             std::get<3>(receivedEventInfo),
-            std::make_pair(absMovedPath, DataOps::DELETE));
+            std::make_pair(std::make_pair(absMovedPath, DataOps::DELETE),
+                           std::chrono::steady_clock::now()));
     }
 
     if (std::get<BaseName>(receivedEventInfo).starts_with("."))
@@ -745,20 +1623,31 @@ std::optional<DataOperation>
 
         if (_movedFromDataOps.contains(cookie))
         {
-            if ((_movedFromDataOps[cookie].first.filename().string())
-                    .starts_with("."))
+            const auto movedFrom = _movedFromDataOps.at(cookie).first.first;
+            if (movedFrom.filename().string().starts_with("."))
             {
                 lg2::debug("Ignoring the received IN_MOVED_TO for {PATH} with "
                            "cookie : {COOKIE} as update is done by RSYNC",
                            "PATH", absCopiedPath, "COOKIE", cookie);
                 return std::nullopt;
             }
-            else
+
+            lg2::debug("[{OLDPATH}] renamed/moved to [{NEWPATH}]", "OLDPATH",
+                       movedFrom, "NEWPATH", absCopiedPath);
+            _movedFromDataOps.erase(cookie);
+
+            // Case 3 : Renamed within the configured path, the delete of the
+            // old path in this batch is replaced by the rename so that the
+            // sibling renames its copy instead of transferring it again.
+            if (auto deleteOp = std::ranges::find(
+                    _dataOperations,
+                    DataOperation{movedFrom, DataOps::DELETE});
+                deleteOp != _dataOperations.end())
             {
-                lg2::debug("[{OLDPATH}] renamed/moved to [{NEWPATH}]",
-                           "OLDPATH", _movedFromDataOps.at(cookie).first,
-                           "NEWPATH", absCopiedPath);
-                _movedFromDataOps.erase(cookie);
+                _dataOperations.erase(deleteOp);
+                _renames.insert_or_assign(absCopiedPath, movedFrom);
+                renamePath(movedFrom, absCopiedPath);
+                return std::make_pair(absCopiedPath, DataOps::RENAME);
             }
         }
         return std::make_pair(absCopiedPath, DataOps::COPY);
@@ -859,6 +1748,12 @@ void DataWatcher::removeWatch(int wd)
 
     inotify_rm_watch(_inotifyFileDescriptor(), wd);
     _watchDescriptors.erase(wd);
+    _churn.erase(wd);
+    WatchBudget::instance().release();
+    if (_eventRecorder)
+    {
+        _eventRecorder->recordWatchRemoved(wd);
+    }
 
     lg2::debug("Stopped monitoring {PATH}, WD : {WD}", "PATH", pathToRemove,
                "WD", wd);
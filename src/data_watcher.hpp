@@ -2,6 +2,9 @@
 
 #pragma once
 
+#include "inotify_reader.hpp"
+#include "subtree_scanner.hpp"
+#include "tracing.hpp"
 #include "utility.hpp"
 
 #include <sys/inotify.h>
@@ -9,9 +12,18 @@
 #include <data_sync_config.hpp>
 #include <sdbusplus/async.hpp>
 
+#include <chrono>
 #include <filesystem>
+#include <functional>
 #include <map>
+#include <optional>
 #include <unordered_set>
+#include <vector>
+
+namespace data_sync::watch::trace
+{
+class EventRecorder;
+} // namespace data_sync::watch::trace
 
 namespace data_sync::watch::inotify
 {
@@ -19,19 +31,6 @@ namespace data_sync::watch::inotify
 namespace fs = std::filesystem;
 namespace utility = data_sync::utility;
 
-/**
- * @brief A tuple which has the info related to the occured inotify event
- *
- * int         - Watch descriptor corresponds to the event
- * std::string - name[] in inotify_event struct
- * uint32_t    - Mask describing event
- */
-using WD = int;
-using BaseName = std::string;
-using EventMask = uint32_t;
-using Cookie = uint32_t;
-using EventInfo = std::tuple<WD, BaseName, EventMask, Cookie>;
-
 /**
  * @brief enum which indicates the type of operations that can take against an
  * intersted inotify event on a configured data path
@@ -39,7 +38,8 @@ using EventInfo = std::tuple<WD, BaseName, EventMask, Cookie>;
 enum class DataOps
 {
     COPY,
-    DELETE
+    DELETE,
+    RENAME
 };
 
 /**
@@ -55,6 +55,18 @@ enum class DataOps
 using DataOperation = std::pair<fs::path, DataOps>;
 using DataOperations = std::vector<DataOperation>;
 
+/**
+ * @brief The renamed paths of the RENAME data operations, mapped from the new
+ *        path to the old path.
+ */
+using Renames = std::map<fs::path, fs::path>;
+
+/**
+ * @brief The last known modification time of the watched files/directories,
+ *        to find the changes missed due to an inotify event queue overflow.
+ */
+using Snapshot = std::map<fs::path, fs::file_time_type>;
+
 /** @class DataWatcher
  *
  *  @brief Adds inotify watch on directories/files configured for sync.
@@ -63,6 +75,32 @@ using DataOperations = std::vector<DataOperation>;
 class DataWatcher
 {
   public:
+    /**
+     * @brief The cost and frequency of the rescans done to recover from the
+     *        inotify event queue overflows.
+     */
+    struct RescanStats
+    {
+        // The number of rescans
+        size_t rescans{0};
+
+        // The number of rescans which synced the whole configured path
+        size_t fallbacks{0};
+
+        // The number of entries scanned by the last rescan
+        size_t lastScannedEntries{0};
+
+        // The time taken by the last rescan and by all the rescans
+        std::chrono::microseconds lastDuration{0};
+        std::chrono::microseconds totalDuration{0};
+    };
+
+    /**
+     * @brief The maximum number of entries in the snapshot, the whole
+     *        configured path is synced upon an overflow if the tree is larger.
+     */
+    static constexpr size_t maxSnapshotEntries = 10000;
+
     DataWatcher(const DataWatcher&) = delete;
     DataWatcher& operator=(const DataWatcher&) = delete;
     DataWatcher(DataWatcher&&) = delete;
@@ -105,7 +143,147 @@ class DataWatcher
      */
     sdbusplus::async::task<DataOperations> onDataChange();
 
+    /**
+     * @brief API to take the snapshot of the configured path on a worker
+     *        thread, which the overflow rescans diff against. It is taken
+     *        once, by the first onDataChange() unless called before.
+     */
+    sdbusplus::async::task<> initSnapshot();
+
+    /**
+     * @brief API to wake up the waiting onDataChange() without any event,
+     *        which returns no data operations then. Eg: to stop watching
+     *        right away rather than upon the next event.
+     */
+    void wakeUp();
+
+    /**
+     * @brief API to start recording the received inotify events along with
+     *        the watch table changes into the given trace file.
+     *
+     * The current watch table is written first so that the trace can be
+     * replayed against a watcher created for the same configured path.
+     *
+     * @param[in] traceFile - The file to record the events into
+     *
+     * @throws std::runtime_error if the trace file cannot be opened
+     */
+    void startRecording(const fs::path& traceFile);
+
+    /**
+     * @brief API to process the given events as if they were read from the
+     *        inotify fd.
+     *
+     * Used to replay the recorded events through the same processing path
+     * as the live events, including the watch table updates.
+     *
+     * @param[in] events - The events to process
+     *
+     * @returns The data operations resulted from the given events
+     */
+    DataOperations replayEvents(const std::vector<EventInfo>& events);
+
+    /**
+     * @brief API to get the watch descriptor of a watched path.
+     *
+     * @param[in] path - The watched path
+     *
+     * @returns The watch descriptor if the path is being watched,
+     *          otherwise std::nullopt
+     */
+    std::optional<WD> getWatchDescriptor(const fs::path& path) const;
+
+    /**
+     * @brief API to get the correlation id of the last processed batch of
+     *        events, which is carried by the resulted data operations across
+     *        the sync pipeline.
+     */
+    tracing::CorrelationId getCorrelationId() const
+    {
+        return _correlationId;
+    }
+
+    /**
+     * @brief API to check whether any subtree is covered by the periodic scan
+     *        instead of the inotify watches.
+     */
+    bool hasPolledSubtrees() const
+    {
+        return !_polledSubtrees.empty();
+    }
+
+    /**
+     * @brief API to get the roots of the subtrees covered by the periodic
+     *        scan.
+     */
+    std::vector<fs::path> getPolledSubtrees() const;
+
+    /**
+     * @brief API to set the callback to notify that a subtree is moved to the
+     *        periodic scan while none was, so that the scan runs only then.
+     *
+     * @param[in] callback - The callback to notify
+     */
+    void setPollingStartedCallback(std::function<void()> callback)
+    {
+        _pollingStarted = std::move(callback);
+    }
+
+    /**
+     * @brief API to scan the subtrees which are not watched due to the watch
+     *        budget, to be called periodically.
+     *
+     * The polled subtrees with changes are moved back to the inotify watches
+     * if the watch budget allows.
+     *
+     * @returns The data operations for the changes found
+     */
+    DataOperations pollSubtrees();
+
+    /**
+     * @brief API to get the cost and frequency of the overflow rescans.
+     */
+    const RescanStats& getRescanStats() const
+    {
+        return _rescanStats;
+    }
+
+    /**
+     * @brief API to get the old paths of the RENAME data operations of the
+     *        last processed batch of events.
+     */
+    const Renames& getRenames() const
+    {
+        return _renames;
+    }
+
+    /**
+     * @brief API to get the number of the IN_MOVED_FROM events waiting for
+     *        their IN_MOVED_TO.
+     */
+    size_t getUnmatchedMoves() const
+    {
+        return _movedFromDataOps.size();
+    }
+
+    /**
+     * @brief The time after which an IN_MOVED_FROM without its IN_MOVED_TO is
+     *        forgotten, i.e. moved out of the watched paths.
+     */
+    static constexpr auto movedFromExpiry = std::chrono::seconds(5);
+
+    /**
+     * @brief The maximum number of the IN_MOVED_FROM events waiting for their
+     *        IN_MOVED_TO, the oldest ones are forgotten beyond it.
+     */
+    static constexpr size_t maxUnmatchedMoves = 1024;
+
   private:
+    /**
+     * @brief The async context object.
+     */
+    sdbusplus::async::context& _ctx;
+
     /**
      * @brief inotify flags
      */
@@ -164,23 +342,110 @@ class DataWatcher
      */
     utility::FD _inotifyFileDescriptor;
 
+    /**
+     * @brief The eventfd to wake up the waiting onDataChange().
+     */
+    utility::FD _wakeupFileDescriptor;
+
+    /**
+     * @brief The epoll instance to wait on the events and the wakeups
+     *        together.
+     */
+    utility::FD _epollFileDescriptor;
+
     /**
      * @brief fdio instance
      */
     std::unique_ptr<sdbusplus::async::fdio> _fdioInstance;
 
+    /**
+     * @brief The events read by the inotify reader thread, if the inotify fd
+     *        is not read on the event loop.
+     */
+    std::shared_ptr<InotifyReader::Channel> _readerChannel;
+
+    /**
+     * @brief The snapshot of the configured path, std::nullopt if the tree
+     *        exceeds the maxSnapshotEntries.
+     */
+    std::optional<Snapshot> _snapshot;
+
+    /**
+     * @brief Indicates the snapshot of the configured path is taken.
+     */
+    bool _snapshotTaken{false};
+
+    /**
+     * @brief Indicates an inotify event queue overflow is received, and the
+     *        configured path needs to be rescanned.
+     */
+    bool _rescanPending{false};
+
+    /**
+     * @brief Indicates the subdirectory walks are deferred to be done off
+     *        the event loop, while processing the live events.
+     */
+    bool _deferSubDirWalks{false};
+
+    /**
+     * @brief The directories whose subdirectories are yet to be watched.
+     */
+    std::vector<fs::path> _pendingSubDirWalks;
+
+    /**
+     * @brief The cost and frequency of the overflow rescans.
+     */
+    RescanStats _rescanStats;
+
+    /**
+     * @brief The number of events received per watch, halved on every
+     *        periodic scan so that the recent events weigh more.
+     */
+    std::map<WD, size_t> _churn;
+
+    /**
+     * @brief The subtrees covered by the periodic scan instead of the
+     *        inotify watches, by their root.
+     */
+    std::map<fs::path, std::unique_ptr<scan::SubtreeScanner>> _polledSubtrees;
+
+    /**
+     * @brief The callback to notify that the periodic scan is needed.
+     */
+    std::function<void()> _pollingStarted;
+
     /**
      * @brief Map of DataOperation
      */
     DataOperations _dataOperations;
 
     /**
-     * @brief Map of Cookie and DataOperation to save the inotify event info.
+     * @brief Map of Cookie and DataOperation to save the inotify event info,
+     *        along with the time received to expire it.
      *
      * Eg : The IN_MOVED_FROM info during the rename or move operations can be
      * saved for map to the corresponding IN_MOVED_TO signals.
      */
-    std::map<Cookie, DataOperation> _movedFromDataOps;
+    std::map<Cookie,
+             std::pair<DataOperation, std::chrono::steady_clock::time_point>>
+        _movedFromDataOps;
+
+    /**
+     * @brief The old paths of the RENAME data operations in _dataOperations.
+     */
+    Renames _renames;
+
+    /**
+     * @brief The recorder which captures the received inotify events.
+     *
+     * @note Holds a value only if the recording is started.
+     */
+    std::unique_ptr<trace::EventRecorder> _eventRecorder;
+
+    /**
+     * @brief The correlation id of the last processed batch of events.
+     */
+    tracing::CorrelationId _correlationId{0};
 
     /**
      * @brief initialize an inotify instance and returns file descriptor
@@ -228,6 +493,16 @@ class DataWatcher
      */
     bool isPathExcluded(const fs::path& path);
 
+    /**
+     * @brief Checks whether the given path is in the given exclude list.
+     *
+     * @param[in] path - absolute path of the data
+     * @param[in] excludeList - The configured exclude list
+     */
+    static bool isPathExcluded(
+        const fs::path& path,
+        const std::optional<std::unordered_set<fs::path>>& excludeList);
+
     /**
      * @brief API to check whether the given path is part of include list
      *        The API will check whether the given path is in the configured
@@ -239,6 +514,16 @@ class DataWatcher
      */
     bool isPathIncluded(const fs::path& path);
 
+    /**
+     * @brief Checks whether the given path is in the given include list.
+     *
+     * @param[in] path - absolute path of the data
+     * @param[in] includeList - The configured include list
+     */
+    static bool isPathIncluded(
+        const fs::path& path,
+        const std::optional<std::unordered_set<fs::path>>& includeList);
+
     /**
      * @brief Checks whether the given path is a parent of any configured
      *        include list paths.
@@ -252,14 +537,48 @@ class DataWatcher
      */
     bool isPathParentOfInclude(const fs::path& path);
 
+    /**
+     * @brief Checks whether the given path is a parent of any given include
+     *        list paths.
+     *
+     * @param[in] path - absolute path of the data
+     * @param[in] includeList - The configured include list
+     */
+    static bool isPathParentOfInclude(
+        const fs::path& path,
+        const std::optional<std::unordered_set<fs::path>>& includeList);
+
     /**
      * @brief API to create watchers for the sub directories if the given path
      * is a directory.
      *
+     * The walk is deferred to addPendingSubDirWatches() while processing the
+     * live events.
+     *
      * @param[in] pathToWatch - The absolute path of directory.
      */
     void addSubDirWatches(const fs::path& pathToWatch);
 
+    /**
+     * @brief API to create watchers for the sub directories of the deferred
+     *        walks, walking the directories on a worker thread.
+     */
+    sdbusplus::async::task<> addPendingSubDirWatches();
+
+    /**
+     * @brief API to collect the sub directories of the given directory which
+     *        are not excluded. It doesn't touch the watcher state, hence can
+     *        run on a worker thread.
+     *
+     * @param[in] dir - The directory to walk
+     * @param[in] excludeList - The configured exclude list
+     *
+     * @return The sub directories to watch.
+     */
+    static std::vector<fs::path> collectSubDirs(
+        const fs::path& dir,
+        const std::optional<std::unordered_set<fs::path>>& excludeList);
+
     /** @brief API to create watchers for the given path and also for the
      * subdirectories if exists inside the configured directory path.
      *
@@ -275,6 +594,183 @@ class DataWatcher
      */
     std::optional<std::vector<EventInfo>> readEvents();
 
+    /**
+     * @brief API to consume a batch of the events read by the inotify reader
+     *        thread.
+     *
+     * returns : The vector of events consumed from the reader
+     *         : std::nullopt , if no events are available
+     */
+    std::optional<std::vector<EventInfo>> consumeEvents();
+
+    /**
+     * @brief API to record and log the received events, and to filter out
+     *        the uninterested ones.
+     *
+     * @param[in] events - The received events
+     *
+     * returns : The interested events
+     */
+    std::vector<EventInfo> filterEvents(const std::vector<EventInfo>& events);
+
+    /**
+     * @brief API to forget the expired IN_MOVED_FROM events which didn't get
+     *        their IN_MOVED_TO.
+     */
+    void expireMovedFrom();
+
+    /**
+     * @brief API to update the watched paths and the snapshot of the renamed
+     *        path, as the watches follow the renamed inodes.
+     *
+     * @param[in] from - The old path
+     * @param[in] to - The new path
+     */
+    void renamePath(const fs::path& from, const fs::path& to);
+
+    /**
+     * @brief API to check whether the path is not of interest, i.e. hidden,
+     *        excluded or not included.
+     *
+     * @param[in] path - The path to check
+     */
+    bool isSkipped(const fs::path& path);
+
+    /**
+     * @brief Checks whether the path is not of interest as per the given
+     *        lists, i.e. hidden, excluded or not included.
+     *
+     * @param[in] path - The path to check
+     * @param[in] excludeList - The configured exclude list
+     * @param[in] includeList - The configured include list
+     */
+    static bool isSkipped(
+        const fs::path& path,
+        const std::optional<std::unordered_set<fs::path>>& excludeList,
+        const std::optional<std::unordered_set<fs::path>>& includeList);
+
+    /**
+     * @brief API to check whether the path is covered by the periodic scan.
+     *
+     * @param[in] path - The path to check
+     */
+    bool isPolled(const fs::path& path) const;
+
+    /**
+     * @brief API to cover the given subtree by the periodic scan, as it
+     *        cannot be watched within the watch budget.
+     *
+     * @param[in] path - The root of the subtree
+     */
+    void pollSubtree(const fs::path& path);
+
+    /**
+     * @brief API to free the watches of the top level subdirectory with the
+     *        least events, by covering it with the periodic scan instead.
+     *
+     * @param[in] pathToWatch - The path which needs a watch, its subtree is
+     *                          not demoted
+     *
+     * @returns True if any watch is freed; otherwise False.
+     */
+    bool demoteColdestSubtree(const fs::path& pathToWatch);
+
+    /**
+     * @brief The changes found by a rescan, which are applied to the watcher
+     *        on the event loop.
+     */
+    struct RescanResult
+    {
+        // The new snapshot, std::nullopt if the tree is too large
+        std::optional<Snapshot> snapshot;
+
+        // The data operations for the changed entries
+        DataOperations dataOperations;
+
+        // The directories created while the events were lost
+        std::vector<fs::path> unwatchedDirs;
+
+        // Whether the whole configured path is synced
+        bool fallback{false};
+    };
+
+    /**
+     * @brief API to take the snapshot of the given path, skipping the
+     *        excluded and hidden paths. It doesn't touch the watcher state,
+     *        hence can run on a worker thread.
+     *
+     * @param[in] dataPath - The configured path
+     * @param[in] excludeList - The configured exclude list
+     * @param[in] includeList - The configured include list
+     *
+     * returns : The snapshot
+     *         : std::nullopt , if the tree exceeds the maxSnapshotEntries
+     */
+    static std::optional<Snapshot> takeSnapshot(
+        const fs::path& dataPath,
+        const std::optional<std::unordered_set<fs::path>>& excludeList,
+        const std::optional<std::unordered_set<fs::path>>& includeList);
+
+    /**
+     * @brief API to take the new snapshot of the given path and to diff it
+     *        against the previous one. It doesn't touch the watcher state,
+     *        hence can run on a worker thread.
+     *
+     * @param[in] dataPath - The configured path
+     * @param[in] excludeList - The configured exclude list
+     * @param[in] includeList - The configured include list
+     * @param[in] previous - The previous snapshot
+     * @param[in] watchedPaths - The currently watched paths
+     *
+     * @return The changes since the previous snapshot
+     */
+    static RescanResult scanChanges(
+        const fs::path& dataPath,
+        const std::optional<std::unordered_set<fs::path>>& excludeList,
+        const std::optional<std::unordered_set<fs::path>>& includeList,
+        const std::optional<Snapshot>& previous,
+        const std::unordered_set<fs::path>& watchedPaths);
+
+    /**
+     * @brief API to update the snapshot with the data operations resulted
+     *        from the received events.
+     *
+     * @param[in] dataOperations - The data operations
+     */
+    void updateSnapshot(const DataOperations& dataOperations);
+
+    /**
+     * @brief API to rescan the configured path after an inotify event queue
+     *        overflow, as the events are lost.
+     *
+     * Adds the data operations for the entries changed since the snapshot,
+     * and adds the missing watches for the new directories. The whole
+     * configured path is synced if the snapshot is not available.
+     */
+    void rescan();
+
+    /**
+     * @brief API to rescan the configured path as rescan() does, but taking
+     *        and diffing the snapshot on a worker thread.
+     */
+    sdbusplus::async::task<> rescanInBackground();
+
+    /**
+     * @brief API to get the paths currently watched.
+     */
+    std::unordered_set<fs::path> getWatchedPaths() const;
+
+    /**
+     * @brief API to apply the changes found by a rescan, i.e. to watch the
+     *        new directories and to add their data operations.
+     *
+     * @param[in] result - The changes found by the rescan
+     * @param[in] start - The time the rescan started
+     * @param[in] span - The span of the rescan
+     */
+    void applyRescan(RescanResult result, tracing::Clock::time_point start,
+                     tracing::ScopedSpan& span);
+
     /**
      * @brief API to trigger processing of the received inotify events.
      *
@@ -0,0 +1,301 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "echo_suppressor.hpp"
+
+#include "utility.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <string_view>
+
+namespace data_sync::echo
+{
+
+namespace
+{
+
+/**
+ * @brief The operations logged by the rsync daemon for the applied changes.
+ */
+constexpr std::string_view receivedOp{"recv "};
+constexpr std::string_view deletedOp{"del. "};
+
+/**
+ * @brief The size of a read from the applied changes log.
+ */
+constexpr size_t readChunkSize = 64 * 1024;
+
+/**
+ * @brief The format of the modification time logged by the rsync daemon, in
+ *        the local time.
+ */
+constexpr auto modifiedTimeFormat = "%Y/%m/%d-%H:%M:%S";
+
+/**
+ * @brief Helper to take the next space separated field of the given entry.
+ */
+std::string_view takeField(std::string_view& entry)
+{
+    const auto fieldEnd = std::min(entry.find(' '), entry.size());
+    auto field = entry.substr(0, fieldEnd);
+    entry.remove_prefix(std::min(fieldEnd + 1, entry.size()));
+    return field;
+}
+
+/**
+ * @brief Helper to parse the logged modification time.
+ */
+std::optional<std::time_t> parseModifiedTime(std::string_view field)
+{
+    const std::string modifiedTime(field);
+    std::tm time{};
+    const char* parsedEnd = strptime(modifiedTime.c_str(), modifiedTimeFormat,
+                                     &time);
+    if (parsedEnd == nullptr || *parsedEnd != '\0')
+    {
+        return std::nullopt;
+    }
+    time.tm_isdst = -1;
+    return std::mktime(&time);
+}
+
+/**
+ * @brief Helper to get the status of the path without following the
+ *        symlinks.
+ */
+std::optional<struct stat> getStatus(const fs::path& path)
+{
+    struct stat pathStat{};
+    if (lstat(path.c_str(), &pathStat) == -1)
+    {
+        return std::nullopt;
+    }
+    return pathStat;
+}
+
+} // namespace
+
+EchoSuppressor::EchoSuppressor(fs::path appliedLog) :
+    _appliedLog(std::move(appliedLog))
+{}
+
+void EchoSuppressor::drain(
+    const std::function<bool(const fs::path&)>& isTracked)
+{
+    if (_appliedLog.empty())
+    {
+        return;
+    }
+
+    // Created by the rsync daemon upon its first connection
+    utility::FD fd(open(_appliedLog.c_str(), O_RDONLY | O_CLOEXEC));
+    if (fd() == -1)
+    {
+        return;
+    }
+
+    struct stat logStat{};
+    if (fstat(fd(), &logStat) == -1)
+    {
+        return;
+    }
+    if (logStat.st_ino != _logInode || logStat.st_size < _logOffset)
+    {
+        // Replaced or truncated, hence read it from the start
+        _logInode = logStat.st_ino;
+        _logOffset = 0;
+        _partialLine.clear();
+    }
+
+    std::array<char, readChunkSize> chunk{};
+    while (true)
+    {
+        auto bytes = pread(fd(), chunk.data(), chunk.size(), _logOffset);
+        if (bytes < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (bytes <= 0)
+        {
+            break;
+        }
+        _logOffset += bytes;
+
+        std::string_view data(chunk.data(), static_cast<size_t>(bytes));
+        for (auto newline = data.find('\n'); newline != std::string_view::npos;
+             newline = data.find('\n'))
+        {
+            _partialLine.append(data.substr(0, newline));
+            record(_partialLine, isTracked);
+            _partialLine.clear();
+            data.remove_prefix(newline + 1);
+        }
+        _partialLine.append(data);
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    std::erase_if(_appliedChanges, [&now](const auto& appliedChange) {
+        return now - appliedChange.second.appliedTime > echoWindow;
+    });
+
+    // The daemon appends to the log, hence it is truncated once fully drained
+    if (_logOffset >= maxLogSize && _partialLine.empty() &&
+        fstat(fd(), &logStat) == 0 && logStat.st_size == _logOffset &&
+        truncate(_appliedLog.c_str(), 0) == 0)
+    {
+        _logOffset = 0;
+    }
+}
+
+void EchoSuppressor::record(
+    const std::string& line,
+    const std::function<bool(const fs::path&)>& isTracked)
+{
+    // Eg: "2026/01/01 10:00:00 [123] recv 2026/01/01-09:59:58 42 var/lib/file"
+    auto pidEnd = line.find("] ");
+    if (pidEnd == std::string::npos)
+    {
+        return;
+    }
+    std::string_view entry(line);
+    entry.remove_prefix(pidEnd + 2);
+
+    bool deleted{false};
+    if (entry.starts_with(deletedOp))
+    {
+        deleted = true;
+        entry.remove_prefix(deletedOp.size());
+    }
+    else if (entry.starts_with(receivedOp))
+    {
+        entry.remove_prefix(receivedOp.size());
+    }
+    else
+    {
+        // The connection and the transfer summary lines
+        return;
+    }
+
+    // The state applied by the daemon, not meaningful for the deletions
+    const auto modifiedTime = parseModifiedTime(takeField(entry));
+    uintmax_t size{0};
+    const auto sizeField = takeField(entry);
+    auto [sizeEnd, ec] = std::from_chars(
+        sizeField.data(), sizeField.data() + sizeField.size(), size);
+    if (!modifiedTime.has_value() || ec != std::errc{} ||
+        sizeEnd != sizeField.data() + sizeField.size())
+    {
+        return;
+    }
+
+    // The names with the escaped characters are not tracked, the worst case
+    // being a sync back of the same content.
+    if (entry.empty() || entry.find("\\#") != std::string_view::npos)
+    {
+        return;
+    }
+
+    // The names are relative to the module path, which is the root, and the
+    // directories have a trailing slash.
+    const fs::path loggedPath = fs::path("/") / entry;
+    const auto path = utility::withoutTrailingSlash(loggedPath);
+    if (!isTracked(path))
+    {
+        return;
+    }
+    AppliedChange appliedChange{deleted,
+                                !loggedPath.has_filename(),
+                                modifiedTime.value(),
+                                size,
+                                std::nullopt,
+                                std::chrono::steady_clock::now()};
+
+    // The content is taken only while the file still has the applied state,
+    // otherwise it is changed locally since and isn't an echo anymore.
+    if (!deleted && !appliedChange.directory)
+    {
+        const auto pathStat = getStatus(path);
+        if (!pathStat.has_value() || !isApplied(appliedChange, *pathStat))
+        {
+            _appliedChanges.erase(path);
+            return;
+        }
+        if (S_ISREG(pathStat->st_mode) && size <= maxContentSize)
+        {
+            appliedChange.content = fingerprint::getFingerprint(path);
+        }
+    }
+
+    if (_appliedChanges.size() >= maxEntries && !_appliedChanges.contains(path))
+    {
+        // The changes applied earlier are synced back once at worst
+        _appliedChanges.clear();
+    }
+    _appliedChanges.insert_or_assign(path, appliedChange);
+}
+
+bool EchoSuppressor::isApplied(const AppliedChange& appliedChange,
+                               const struct stat& pathStat)
+{
+    if (appliedChange.directory)
+    {
+        // The entries of a directory change its modification time and size
+        return S_ISDIR(pathStat.st_mode);
+    }
+    return !S_ISDIR(pathStat.st_mode) &&
+           pathStat.st_mtime == appliedChange.modifiedTime &&
+           static_cast<uintmax_t>(pathStat.st_size) == appliedChange.size;
+}
+
+bool EchoSuppressor::isEcho(const fs::path& path,
+                            watch::inotify::DataOps dataOp)
+{
+    auto appliedChange =
+        _appliedChanges.find(utility::withoutTrailingSlash(path));
+    if (appliedChange == _appliedChanges.end())
+    {
+        return false;
+    }
+    const auto& applied = appliedChange->second;
+
+    const auto pathStat = getStatus(utility::withoutTrailingSlash(path));
+    bool echo{false};
+    if (dataOp == watch::inotify::DataOps::DELETE)
+    {
+        // Not re-created locally since the sibling deleted it
+        echo = applied.deleted && !pathStat.has_value();
+    }
+    else if (!applied.deleted && pathStat.has_value() &&
+             isApplied(applied, *pathStat))
+    {
+        // The regular files must still have the content applied by the
+        // sibling, the others and the large files aren't compared beyond
+        // their state.
+        echo = !S_ISREG(pathStat->st_mode) ||
+               applied.size > maxContentSize ||
+               (applied.content.has_value() &&
+                fingerprint::getFingerprint(path) == applied.content);
+    }
+
+    if (!echo)
+    {
+        // Superseded by the local change, Eg: a re-create and delete
+        _appliedChanges.erase(appliedChange);
+        return false;
+    }
+
+    ++_suppressedCount;
+    lg2::debug("Suppressing the sync of {PATH} as the change is applied by "
+               "the sibling BMC",
+               "PATH", path);
+    return true;
+}
+
+} // namespace data_sync::echo
@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "content_fingerprint.hpp"
+#include "data_watcher.hpp"
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+
+namespace data_sync::echo
+{
+
+namespace fs = std::filesystem;
+
+/**
+ * @class EchoSuppressor
+ *
+ * @brief Tracks the changes applied by the sibling BMC through the local rsync
+ *        daemon, so that the watcher events of those changes don't trigger an
+ *        outbound sync back to the sibling.
+ *
+ * The rsync daemon logs every received and deleted path into the applied
+ * changes log along with the modification time and the size it applied, Eg:
+ * "2026/01/01 10:00:00 [123] recv 2026/01/01-09:59:58 42 var/lib/file". The
+ * log is drained before the events are dispatched, and an event is an echo
+ * only while the path still has the state applied by the sibling, so the local
+ * changes made afterwards are still synced, even if made before the drain.
+ */
+class EchoSuppressor
+{
+  public:
+    /**
+     * @brief The time an applied change is remembered to match its events.
+     */
+    static constexpr std::chrono::seconds echoWindow{30};
+
+    /**
+     * @brief The maximum number of applied changes remembered.
+     */
+    static constexpr size_t maxEntries = 4096;
+
+    /**
+     * @brief The size of the drained log above which it is truncated.
+     */
+    static constexpr off_t maxLogSize = 1024 * 1024;
+
+    /**
+     * @brief The size of the received files up to which their content is
+     *        compared, the larger ones are compared by their modification time
+     *        and size only so as not to hash them on the event loop.
+     */
+    static constexpr uintmax_t maxContentSize = 64 * 1024;
+
+    EchoSuppressor(const EchoSuppressor&) = delete;
+    EchoSuppressor& operator=(const EchoSuppressor&) = delete;
+    EchoSuppressor(EchoSuppressor&&) = delete;
+    EchoSuppressor& operator=(EchoSuppressor&&) = delete;
+    ~EchoSuppressor() = default;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] appliedLog - The log of the changes applied by the rsync
+     *                         daemon, an empty path disables the suppression.
+     */
+    explicit EchoSuppressor(fs::path appliedLog);
+
+    /**
+     * @brief API to read the changes logged since the last drain.
+     *
+     * @param[in] isTracked - Checks whether the applied path needs to be
+     *                        tracked, Eg: it is under a Bidirectional
+     *                        configuration.
+     */
+    void drain(const std::function<bool(const fs::path&)>& isTracked);
+
+    /**
+     * @brief API to check whether the given data operation is the echo of a
+     *        change applied by the sibling BMC.
+     *
+     * @param[in] path - The changed path
+     * @param[in] dataOp - The data operation of the path
+     *
+     * @return True if it is an echo; otherwise False.
+     */
+    bool isEcho(const fs::path& path, watch::inotify::DataOps dataOp);
+
+    /**
+     * @brief API to get the number of events suppressed as echoes.
+     */
+    size_t getSuppressedCount() const
+    {
+        return _suppressedCount;
+    }
+
+  private:
+    /**
+     * @brief A change applied by the sibling BMC.
+     */
+    struct AppliedChange
+    {
+        // Whether the path is deleted, otherwise received
+        bool deleted;
+
+        // Whether the received path is a directory
+        bool directory;
+
+        // The modification time of the received path, as applied
+        std::time_t modifiedTime;
+
+        // The size of the received path, as applied
+        uintmax_t size;
+
+        // The content of the received regular file up to maxContentSize,
+        // taken on draining while it still has the applied modification time
+        // and size
+        std::optional<fingerprint::Fingerprint> content;
+
+        // The time the change is drained from the log
+        std::chrono::steady_clock::time_point appliedTime;
+    };
+
+    /**
+     * @brief API to record a line of the applied changes log.
+     *
+     * @param[in] line - The logged line
+     * @param[in] isTracked - Checks whether the path needs to be tracked
+     */
+    void record(const std::string& line,
+                const std::function<bool(const fs::path&)>& isTracked);
+
+    /**
+     * @brief API to check whether the path still has the state applied by
+     *        the sibling BMC.
+     *
+     * @param[in] appliedChange - The applied change of the path
+     * @param[in] pathStat - The current status of the path
+     *
+     * @return True if the state is as applied; otherwise False.
+     */
+    static bool isApplied(const AppliedChange& appliedChange,
+                          const struct stat& pathStat);
+
+    /**
+     * @brief The log of the changes applied by the rsync daemon.
+     */
+    fs::path _appliedLog;
+
+    /**
+     * @brief The inode of the log drained last, to detect its replacement.
+     */
+    ino_t _logInode{0};
+
+    /**
+     * @brief The offset of the log drained so far.
+     */
+    off_t _logOffset{0};
+
+    /**
+     * @brief The trailing partial line of the last drain.
+     */
+    std::string _partialLine;
+
+    /**
+     * @brief The applied changes by the path.
+     */
+    std::map<fs::path, AppliedChange> _appliedChanges;
+
+    /**
+     * @brief The number of events suppressed as echoes.
+     */
+    size_t _suppressedCount{0};
+};
+
+} // namespace data_sync::echo
@@ -2,13 +2,15 @@
 
 #include "error_log.hpp"
 
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <unistd.h>
 
 #include <phosphor-logging/elog.hpp>
 #include <phosphor-logging/lg2.hpp>
 
-#include <filesystem>
-#include <sstream>
+#include <cerrno>
+#include <cstring>
 
 namespace data_sync
 {
@@ -19,50 +21,77 @@ using namespace phosphor::logging;
 
 FFDCFile::FFDCFile(FFDCFormat format, FFDCSubType subType, FFDCVersion version,
                    const std::string& data) :
-    _format(format), _subType(subType), _version(version),
-    _fileName("/tmp/syncDataFFDCFile.XXXXXX"), _fd(-1), _data(data)
+    _format(format), _subType(subType), _version(version), _fd(-1), _data(data)
 {
     prepareFFDCFile();
 }
 
+FFDCFile::FFDCFile(const FFDCSection& section) :
+    FFDCFile(section.format, section.subType, section.version, section.data)
+{}
+
 FFDCFile::~FFDCFile()
 {
-    removeFFDCFile();
+    closeFFDCFile();
 }
 
 void FFDCFile::prepareFFDCFile()
 {
     createFFDCFile();
-    writeFFDCData();
-    resetFFDCFileSeekPos();
+    try
+    {
+        writeFFDCData();
+        sealFFDCFile();
+        resetFFDCFileSeekPos();
+    }
+    catch (...)
+    {
+        // The destructor is not called if the constructor throws
+        closeFFDCFile();
+        throw;
+    }
 }
 
 void FFDCFile::createFFDCFile()
 {
-    _fd = mkstemp(_fileName.data());
+    _fd = memfd_create("syncDataFFDCFile", MFD_CLOEXEC | MFD_ALLOW_SEALING);
 
     if (_fd == -1)
     {
-        lg2::error("Failed to create FFDC file {FILE_NAME}", "FILE_NAME",
-                   _fileName);
+        lg2::error("Failed to create FFDC file, error: {ERROR}", "ERROR",
+                   strerror(errno));
         throw std::runtime_error("Failed to create FFDC file");
     }
 }
 
 void FFDCFile::writeFFDCData()
 {
-    ssize_t rc = write(_fd, _data.data(), _data.size());
-
-    if (rc == -1)
+    size_t written = 0;
+    while (written < _data.size())
     {
-        lg2::error("Failed to write any FFDC info in the file {FILE_NAME}",
-                   "FILE_NAME", _fileName);
-        throw std::runtime_error("Failed to write FFDC info");
+        ssize_t rc = write(_fd, _data.data() + written, _data.size() - written);
+        if (rc == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            lg2::error("Failed to write FFDC info, error: {ERROR}", "ERROR",
+                       strerror(errno));
+            throw std::runtime_error("Failed to write FFDC info");
+        }
+        written += static_cast<size_t>(rc);
     }
-    else if (rc != static_cast<ssize_t>(_data.size()))
+}
+
+void FFDCFile::sealFFDCFile()
+{
+    if (fcntl(_fd, F_ADD_SEALS,
+              F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) == -1)
     {
-        lg2::error("Failed to write all FFDC info in the file {FILE_NAME}",
-                   "FILE_NAME", _fileName);
+        lg2::error("Failed to seal FFDC file, error: {ERROR}", "ERROR",
+                   strerror(errno));
+        throw std::runtime_error("Failed to seal FFDC file");
     }
 }
 
@@ -70,16 +99,19 @@ void FFDCFile::resetFFDCFileSeekPos()
 {
     if (lseek(_fd, 0, SEEK_SET) == (off_t)-1)
     {
-        lg2::error("Failed to set SEEK_SET for FFDC file {FILE_NAME}",
-                   "FILE_NAME", _fileName);
+        lg2::error("Failed to set SEEK_SET for FFDC file, error: {ERROR}",
+                   "ERROR", strerror(errno));
         throw std::runtime_error("Failed to set SEEK_SET for FFDC file");
     }
 }
 
-void FFDCFile::removeFFDCFile()
+void FFDCFile::closeFFDCFile()
 {
-    close(_fd);
-    std::filesystem::remove(_fileName);
+    if (_fd != -1)
+    {
+        close(_fd);
+        _fd = -1;
+    }
 }
 
 } // namespace error_log
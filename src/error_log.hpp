@@ -1,9 +1,12 @@
 // SPDX-License-Identifier: Apache-2.0
 
+#pragma once
+
 #include <nlohmann/json.hpp>
 #include <xyz/openbmc_project/Logging/Create/server.hpp>
 
 #include <cstdint>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -37,10 +40,43 @@ using FFDCFileInfo =
  */
 using FFDCFileInfoSet = std::vector<FFDCFileInfo>;
 
+/**
+ * @brief The FFDC subtype of the callouts section, which is parsed by the
+ *        logging service to add the callouts into the error log.
+ */
+constexpr FFDCSubType calloutsSubType = 0xCA;
+
+/**
+ * @brief The FFDC subtypes of the diagnostic sections of this daemon.
+ */
+constexpr FFDCSubType eventTraceSubType = 0x01;
+constexpr FFDCSubType rsyncOutputSubType = 0x02;
+
+/**
+ * @brief A section of the FFDC data to attach to the error log, each section
+ *        is passed as a separate FFDC file.
+ */
+struct FFDCSection
+{
+    FFDCFormat format;
+    FFDCSubType subType;
+    FFDCVersion version;
+    std::string data;
+};
+
+/**
+ * @brief The FFDC sections to attach to an error log.
+ */
+using FFDCSections = std::vector<FFDCSection>;
+
 /**
  * @class FFDCFile
  *
  * @brief This class is used to create FFDC file with data.
+ *
+ * The FFDC file is an anonymous memory backed file (memfd), sealed once the
+ * data is written so that the logging service gets an immutable copy without
+ * any filesystem I/O on the error path.
  */
 class FFDCFile
 {
@@ -63,7 +99,14 @@ class FFDCFile
              const std::string& data);
 
     /**
-     * @brief Used to remove created FFDC file.
+     * @brief Constructor to create the FFDC file of the given section.
+     *
+     * @param[in] section - The FFDC section to write in the FFDC file.
+     */
+    explicit FFDCFile(const FFDCSection& section);
+
+    /**
+     * @brief Used to close the created FFDC file, which frees its memory.
      */
     ~FFDCFile();
 
@@ -128,6 +171,13 @@ class FFDCFile
      */
     void writeFFDCData();
 
+    /**
+     * @brief Function to seal the FFDC file against any further writes.
+     *
+     * @throws A runtime error on failure
+     */
+    void sealFFDCFile();
+
     /**
      * @brief Function to set the FFDC file seek position to the begging to
      * consume in the error log.
@@ -137,9 +187,9 @@ class FFDCFile
     void resetFFDCFileSeekPos();
 
     /**
-     * @brief Function to remove the create FFDC file.
+     * @brief Function to close the created FFDC file.
      */
-    void removeFFDCFile();
+    void closeFFDCFile();
 
     /**
      * @brief Stores the FFDC format.
@@ -156,11 +206,6 @@ class FFDCFile
      */
     FFDCVersion _version;
 
-    /**
-     * @brief Stores the unique FFDC file name.
-     */
-    std::string _fileName;
-
     /**
      * @brief Stores the created FFDC file descriptor id.
      */
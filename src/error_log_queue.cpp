@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "error_log_queue.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace data_sync::error_log
+{
+
+namespace
+{
+
+/**
+ * @brief Helper to get the path which the error log is about, the additional
+ *        details are expected to have it under the "*_Path" key.
+ */
+std::optional<std::string> getErrorPath(const ErrorLogRequest& request)
+{
+    for (const auto& [key, value] : request.additionalDetails)
+    {
+        if (key.ends_with("_Path"))
+        {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+ErrorLogQueue::ErrorLogQueue(sdbusplus::async::context& ctx,
+                             ext_data::ExternalDataIFaces& extDataIfaces,
+                             std::chrono::seconds window) :
+    _ctx(ctx), _extDataIfaces(extDataIfaces), _window(window), _wakeup(ctx)
+{}
+
+std::string ErrorLogQueue::getErrorType(const ErrorLogRequest& request)
+{
+    std::string errorType = request.errMsg + '|' +
+                            std::to_string(std::to_underlying(
+                                request.errSeverity));
+    // The messages differ per path and output, so only the error code tells
+    // the same failure apart.
+    if (auto it = request.additionalDetails.find("DS_Sync_ErrCode");
+        it != request.additionalDetails.end())
+    {
+        errorType.append('|' + it->second);
+    }
+    return errorType;
+}
+
+void ErrorLogQueue::submit(ErrorLogRequest request, Clock::time_point now)
+{
+    // Either ready to log or may end the window earlier than being waited.
+    _wakeup.notify();
+
+    auto errorType = getErrorType(request);
+    auto it = _buckets.find(errorType);
+
+    // The first error of the window is logged right away
+    if (it == _buckets.end() ||
+        (it->second.count == 0 && now - it->second.windowStart >= _window))
+    {
+        _buckets.insert_or_assign(errorType, Bucket{now, {}, 0, {}, false});
+        _readyLogs.emplace_back(std::move(request));
+        return;
+    }
+
+    auto& bucket = it->second;
+    ++bucket.count;
+    if (auto path = getErrorPath(request); path.has_value())
+    {
+        if (bucket.paths.size() < maxAggregatedPaths)
+        {
+            bucket.paths.emplace(std::move(*path));
+        }
+        else if (!bucket.paths.contains(*path))
+        {
+            bucket.pathsTruncated = true;
+        }
+    }
+    if (!bucket.aggregatedLog.has_value())
+    {
+        bucket.aggregatedLog = std::move(request);
+    }
+}
+
+std::vector<ErrorLogRequest> ErrorLogQueue::takeReadyLogs(Clock::time_point now)
+{
+    std::vector<ErrorLogRequest> readyLogs(
+        std::make_move_iterator(_readyLogs.begin()),
+        std::make_move_iterator(_readyLogs.end()));
+    _readyLogs.clear();
+
+    for (auto it = _buckets.begin(); it != _buckets.end();)
+    {
+        auto& bucket = it->second;
+        if (now - bucket.windowStart < _window)
+        {
+            ++it;
+            continue;
+        }
+
+        if (bucket.count == 0)
+        {
+            it = _buckets.erase(it);
+            continue;
+        }
+
+        auto aggregatedLog = std::move(bucket.aggregatedLog.value());
+        std::string paths;
+        for (const auto& path : bucket.paths)
+        {
+            paths.append(paths.empty() ? path : ", " + path);
+        }
+        if (bucket.pathsTruncated)
+        {
+            paths.append(", ...");
+        }
+
+        auto& additionalDetails = aggregatedLog.additionalDetails;
+        additionalDetails["DS_Aggregated_Count"] = std::to_string(bucket.count);
+        additionalDetails["DS_Aggregated_Window"] =
+            std::to_string(_window.count()) + "s";
+        if (!paths.empty())
+        {
+            additionalDetails["DS_Aggregated_Paths"] = paths;
+        }
+
+        lg2::info("Aggregated {COUNT} [{ERR_MSG}] errors into one error log",
+                  "COUNT", bucket.count, "ERR_MSG", aggregatedLog.errMsg);
+        readyLogs.emplace_back(std::move(aggregatedLog));
+
+        // The aggregated error log starts the next window
+        bucket = Bucket{now, {}, 0, {}, false};
+        ++it;
+    }
+    return readyLogs;
+}
+
+std::optional<Clock::time_point> ErrorLogQueue::getNextDeadline() const
+{
+    std::optional<Clock::time_point> deadline;
+    for (const auto& [errorType, bucket] : _buckets)
+    {
+        if (bucket.count == 0)
+        {
+            // Nothing to log at the end of the window
+            continue;
+        }
+        auto windowEnd = bucket.windowStart + _window;
+        if (!deadline.has_value() || windowEnd < *deadline)
+        {
+            deadline = windowEnd;
+        }
+    }
+    return deadline;
+}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<> ErrorLogQueue::run()
+{
+    while (!_ctx.stop_requested())
+    {
+        for (auto& request : takeReadyLogs(Clock::now()))
+        {
+            co_await _extDataIfaces.createErrorLog(
+                request.errMsg, request.errSeverity, request.additionalDetails,
+                request.ffdcSections);
+        }
+
+        auto idleDeadline = Clock::now() + maxIdleWait;
+        // NOLINTNEXTLINE
+        co_await _wakeup.waitUntil(
+            std::min(getNextDeadline().value_or(idleDeadline), idleDeadline));
+    }
+    co_return;
+}
+
+} // namespace data_sync::error_log
@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "external_data_ifaces.hpp"
+#include "wakeup_event.hpp"
+
+#include <sdbusplus/async.hpp>
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace data_sync::error_log
+{
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief The details of an error log to create.
+ */
+struct ErrorLogRequest
+{
+    std::string errMsg;
+    ext_data::ErrorLevel errSeverity;
+    ext_data::AdditionalData additionalDetails;
+    FFDCSections ffdcSections{};
+};
+
+/**
+ * @class ErrorLogQueue
+ *
+ * @brief Creates the error logs in the background so that the syncs don't
+ *        wait for the logging service, and rate limits them per error type.
+ *
+ * The first error log of a type is created right away, and the same type of
+ * errors occurred within the window are aggregated into a single error log
+ * created at the end of the window, along with their count and paths. So a
+ * window with the repeated errors yields two error logs, where the
+ * "DS_Aggregated_Count" of the second one excludes the first error.
+ *
+ * The errors are of the same type if they have the same error message,
+ * severity and "DS_Sync_ErrCode" additional detail, if any.
+ *
+ * The queue sleeps until an error is submitted or the earliest window with
+ * the aggregated errors elapses, rather than checking periodically.
+ */
+class ErrorLogQueue
+{
+  public:
+    /**
+     * @brief The maximum number of paths listed in an aggregated error log.
+     */
+    static constexpr size_t maxAggregatedPaths = 32;
+
+    /**
+     * @brief The maximum time to sleep without an aggregated error, as the
+     *        eventfd wait doesn't end when the context is stopped.
+     */
+    static constexpr auto maxIdleWait = std::chrono::seconds(1);
+
+    ErrorLogQueue(const ErrorLogQueue&) = delete;
+    ErrorLogQueue& operator=(const ErrorLogQueue&) = delete;
+    ErrorLogQueue(ErrorLogQueue&&) = delete;
+    ErrorLogQueue& operator=(ErrorLogQueue&&) = delete;
+    ~ErrorLogQueue() = default;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] ctx - The async context object
+     * @param[in] extDataIfaces - The interface to create the error logs
+     * @param[in] window - The rate limit window per error type
+     */
+    ErrorLogQueue(sdbusplus::async::context& ctx,
+                  ext_data::ExternalDataIFaces& extDataIfaces,
+                  std::chrono::seconds window);
+
+    /**
+     * @brief API to queue an error log, which doesn't wait for the error log
+     *        creation.
+     *
+     * @param[in] request - The error log to create
+     * @param[in] now - The current time
+     */
+    void submit(ErrorLogRequest request, Clock::time_point now = Clock::now());
+
+    /**
+     * @brief API to take the error logs which are ready to be created, i.e.
+     *        the queued ones and the aggregated ones whose window elapsed.
+     *
+     * @param[in] now - The current time
+     *
+     * @return The error logs to create.
+     */
+    std::vector<ErrorLogRequest> takeReadyLogs(Clock::time_point now);
+
+    /**
+     * @brief API to get the time at which the earliest window with the
+     *        aggregated errors elapses.
+     *
+     * @return The time if any error is aggregated; otherwise std::nullopt.
+     */
+    std::optional<Clock::time_point> getNextDeadline() const;
+
+    /**
+     * @brief API to create the ready error logs until the context is stopped.
+     */
+    sdbusplus::async::task<> run();
+
+  private:
+    /**
+     * @brief The rate limit state of an error type.
+     */
+    struct Bucket
+    {
+        // The start of the current rate limit window
+        Clock::time_point windowStart;
+
+        // The first error aggregated in the current window, used as the
+        // details of the aggregated error log
+        std::optional<ErrorLogRequest> aggregatedLog;
+
+        // The number of the errors aggregated in the current window
+        size_t count{0};
+
+        // The paths of the aggregated errors
+        std::set<std::string> paths;
+
+        // Indicates the paths beyond the maximum are dropped
+        bool pathsTruncated{false};
+    };
+
+    /**
+     * @brief API to get the error type of the given error log, which is the
+     *        error message, severity and the "DS_Sync_ErrCode" if present.
+     *
+     * @param[in] request - The error log
+     */
+    static std::string getErrorType(const ErrorLogRequest& request);
+
+    /**
+     * @brief The async context object.
+     */
+    sdbusplus::async::context& _ctx;
+
+    /**
+     * @brief The interface to create the error logs.
+     */
+    ext_data::ExternalDataIFaces& _extDataIfaces;
+
+    /**
+     * @brief The rate limit window per error type.
+     */
+    std::chrono::seconds _window;
+
+    /**
+     * @brief The error logs to create right away.
+     */
+    std::deque<ErrorLogRequest> _readyLogs;
+
+    /**
+     * @brief The rate limit state per error type.
+     */
+    std::map<std::string, Bucket> _buckets;
+
+    /**
+     * @brief The event to wake up the queue on the submitted errors.
+     */
+    async::WakeupEvent _wakeup;
+};
+
+} // namespace data_sync::error_log
@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "event_aggregator.hpp"
+
+#include "utility.hpp"
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <ranges>
+#include <set>
+#include <vector>
+
+namespace data_sync::watch::inotify
+{
+
+namespace
+{
+
+/**
+ * @brief Helper to get the number of entries in the directory.
+ */
+size_t countEntries(const fs::path& dir)
+{
+    std::error_code ec;
+    fs::directory_iterator entries(dir, ec);
+    if (ec)
+    {
+        return 0;
+    }
+    return static_cast<size_t>(
+        std::distance(fs::begin(entries), fs::end(entries)));
+}
+
+} // namespace
+
+DataOperations
+    collapseBursts(const DataOperations& dataOperations,
+                   const fs::path& configuredPath, const CollapsePolicy& policy,
+                   const std::function<bool(const fs::path&)>& canSyncDir)
+{
+    const auto root = utility::withoutTrailingSlash(configuredPath);
+
+    std::set<fs::path> changedPaths;
+    for (const auto& [path, dataOp] : dataOperations)
+    {
+        if (dataOp != DataOps::RENAME)
+        {
+            changedPaths.emplace(utility::withoutTrailingSlash(path));
+        }
+    }
+
+    std::map<fs::path, size_t> dirEntries;
+    auto isBurst = [&policy, &dirEntries](const fs::path& dir,
+                                          size_t changedChildren) {
+        if (changedChildren < 2)
+        {
+            return false;
+        }
+        if (changedChildren >= policy.threshold)
+        {
+            return true;
+        }
+        auto [entries, _] = dirEntries.try_emplace(dir, countEntries(dir));
+        return changedChildren * 100 >=
+               policy.percent * std::max<size_t>(entries->second, 1);
+    };
+
+    // Collapsed one directory at a time, the deepest first, as a collapsed
+    // directory is a changed child of its parent.
+    std::set<fs::path> collapsedDirs;
+    bool collapsed{true};
+    while (collapsed)
+    {
+        collapsed = false;
+
+        std::map<fs::path, size_t> changedChildren;
+        for (const auto& path : changedPaths)
+        {
+            if (path != root && utility::isSameOrChildOf(path, root))
+            {
+                ++changedChildren[path.parent_path()];
+            }
+        }
+
+        for (const auto& [dir, count] : changedChildren | std::views::reverse)
+        {
+            if (!isBurst(dir, count) || !canSyncDir(dir))
+            {
+                continue;
+            }
+
+            lg2::debug("Collapsing {COUNT} changes under {DIR} into its sync",
+                       "COUNT", count, "DIR", dir);
+            std::erase_if(changedPaths, [&dir](const fs::path& path) {
+                return utility::isSameOrChildOf(path, dir);
+            });
+            std::erase_if(collapsedDirs, [&dir](const fs::path& path) {
+                return utility::isSameOrChildOf(path, dir);
+            });
+            changedPaths.emplace(dir);
+            collapsedDirs.emplace(dir);
+            collapsed = true;
+            break;
+        }
+    }
+
+    if (collapsedDirs.empty())
+    {
+        return dataOperations;
+    }
+
+    DataOperations collapsedOperations;
+    for (const auto& dataOperation : dataOperations)
+    {
+        const auto path = utility::withoutTrailingSlash(dataOperation.first);
+        if (dataOperation.second == DataOps::RENAME ||
+            (changedPaths.contains(path) && !collapsedDirs.contains(path)))
+        {
+            collapsedOperations.emplace_back(dataOperation);
+        }
+    }
+
+    std::error_code ec;
+    for (const auto& dir : collapsedDirs)
+    {
+        // The directory contents are synced, along with the deletes in it
+        collapsedOperations.emplace_back(
+            fs::is_directory(dir, ec) ? dir / "" : dir, DataOps::COPY);
+    }
+
+    lg2::info("Collapsed {COUNT} changes under {PATH} into {SYNCS} syncs",
+              "COUNT", dataOperations.size(), "PATH", configuredPath, "SYNCS",
+              collapsedOperations.size());
+    return collapsedOperations;
+}
+
+} // namespace data_sync::watch::inotify
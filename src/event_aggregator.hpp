@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "data_watcher.hpp"
+
+#include <filesystem>
+#include <functional>
+
+namespace data_sync::watch::inotify
+{
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief The limits to collapse the changes of the children into the sync of
+ *        their directory.
+ */
+struct CollapsePolicy
+{
+    // The number of the changed children to collapse, regardless of the
+    // entries of the directory
+    size_t threshold;
+
+    // The percentage of the entries of the directory changed to collapse
+    size_t percent;
+};
+
+/**
+ * @brief API to collapse the burst of changes under a directory into a
+ *        single recursive sync of the directory, so that the bulk rewrites
+ *        don't spawn an rsync per file.
+ *
+ * The directories are collapsed bottom up, a collapsed directory counts as a
+ * changed child of its parent, until the lowest common ancestor is reached.
+ * The directories above the configured path are never synced, and the
+ * excluded children are still skipped by the rsync exclude list.
+ *
+ * @param[in] dataOperations - The data operations of a batch of events
+ * @param[in] configuredPath - The configured path of the data operations
+ * @param[in] policy - The limits to collapse
+ * @param[in] canSyncDir - Checks whether the whole directory can be synced,
+ *                         Eg: it is in the include list
+ *
+ * @returns The data operations with the collapsed ones replaced by the COPY
+ *          of their directory, the RENAME operations are kept as is.
+ */
+DataOperations
+    collapseBursts(const DataOperations& dataOperations,
+                   const fs::path& configuredPath, const CollapsePolicy& policy,
+                   const std::function<bool(const fs::path&)>& canSyncDir);
+
+} // namespace data_sync::watch::inotify
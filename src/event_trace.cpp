@@ -0,0 +1,232 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "event_trace.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <format>
+#include <map>
+#include <sstream>
+
+namespace data_sync::watch::trace
+{
+
+EventRecorder::EventRecorder(const fs::path& traceFile,
+                             const fs::path& configuredPath) :
+    _traceFile(traceFile, std::ios::out | std::ios::trunc),
+    _startTime(std::chrono::steady_clock::now())
+{
+    if (!_traceFile.is_open())
+    {
+        lg2::error("Failed to open the inotify trace file [{FILE}]", "FILE",
+                   traceFile);
+        throw std::runtime_error("Failed to open the inotify trace file");
+    }
+    _traceFile << record::configuredPath << ' ' << configuredPath.string()
+               << '\n';
+    lg2::info("Recording inotify events of [{PATH}] into [{FILE}]", "PATH",
+              configuredPath, "FILE", traceFile);
+}
+
+void EventRecorder::recordWatchAdded(inotify::WD wd, const fs::path& path)
+{
+    _traceFile << record::watchAdded << ' ' << wd << ' ' << path.string()
+               << '\n';
+}
+
+void EventRecorder::recordWatchRemoved(inotify::WD wd)
+{
+    _traceFile << record::watchRemoved << ' ' << wd << '\n';
+}
+
+void EventRecorder::recordEvents(const std::vector<inotify::EventInfo>& events)
+{
+    auto offset = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - _startTime);
+
+    for (const auto& [wd, name, mask, cookie] : events)
+    {
+        _traceFile << std::format("{} {} {} {:x} {} {}\n", record::event,
+                                  offset.count(), wd, mask, cookie, name);
+    }
+
+    // Flush per batch so that the trace is usable even if the daemon is
+    // killed while recording a burst.
+    _traceFile.flush();
+}
+
+EventReplayer::EventReplayer(sdbusplus::async::context& ctx,
+                             const fs::path& traceFile, double speedFactor) :
+    _ctx(ctx), _speedFactor(speedFactor)
+{
+    load(traceFile);
+}
+
+void EventReplayer::load(const fs::path& traceFile)
+{
+    std::ifstream trace(traceFile);
+    if (!trace.is_open())
+    {
+        throw std::runtime_error("Failed to open the inotify trace file: " +
+                                 traceFile.string());
+    }
+
+    std::string line;
+    size_t lineNo = 0;
+    while (std::getline(trace, line))
+    {
+        ++lineNo;
+        if (line.empty())
+        {
+            continue;
+        }
+
+        std::istringstream fields(line);
+        char recordType{};
+        fields >> recordType;
+
+        // Returns the remaining part of the line without the separator, as
+        // the path and name fields may contain spaces.
+        auto remaining = [&fields]() {
+            std::string rest;
+            fields.get(); // skip the separator
+            std::getline(fields, rest);
+            return rest;
+        };
+
+        switch (recordType)
+        {
+            case record::configuredPath:
+            {
+                _configuredPath = remaining();
+                break;
+            }
+            case record::watchAdded:
+            case record::watchRemoved:
+            {
+                WatchRecord watch{};
+                fields >> watch.wd;
+                if (recordType == record::watchAdded)
+                {
+                    watch.path = remaining();
+                }
+                _records.emplace_back(std::move(watch));
+                break;
+            }
+            case record::event:
+            {
+                int64_t offset{};
+                inotify::WD wd{};
+                inotify::EventMask mask{};
+                inotify::Cookie cookie{};
+                fields >> offset >> wd >> std::hex >> mask >> std::dec >>
+                    cookie;
+                if (fields.fail())
+                {
+                    throw std::runtime_error(
+                        std::format("Malformed event at line {} in {}", lineNo,
+                                    traceFile.string()));
+                }
+
+                // Events read in one go share the offset, so group them
+                // back into the same batch.
+                auto* lastBatch =
+                    _records.empty()
+                        ? nullptr
+                        : std::get_if<EventsRecord>(&_records.back());
+                if (lastBatch == nullptr ||
+                    lastBatch->offset.count() != offset)
+                {
+                    _records.emplace_back(
+                        EventsRecord{std::chrono::microseconds(offset), {}});
+                    lastBatch = std::get_if<EventsRecord>(&_records.back());
+                }
+                lastBatch->events.emplace_back(wd, remaining(), mask, cookie);
+                break;
+            }
+            default:
+            {
+                throw std::runtime_error(
+                    std::format("Unknown record at line {} in {}", lineNo,
+                                traceFile.string()));
+            }
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<> EventReplayer::replay(inotify::DataWatcher& watcher,
+                                               DataOperationsHandler handler)
+{
+    // The recorded watch table, used to translate the recorded watch
+    // descriptors into the ones of the given watcher.
+    std::map<inotify::WD, fs::path> recordedWatches;
+    std::chrono::microseconds previousOffset{0};
+    size_t replayedEvents{0};
+    size_t droppedEvents{0};
+
+    // The replayed overflows are rescanned against the current tree
+    // NOLINTNEXTLINE
+    co_await watcher.initSnapshot();
+
+    for (const auto& traceRecord : _records)
+    {
+        if (_ctx.stop_requested())
+        {
+            break;
+        }
+
+        if (const auto* watch = std::get_if<WatchRecord>(&traceRecord))
+        {
+            if (watch->path.has_value())
+            {
+                recordedWatches.insert_or_assign(watch->wd, *watch->path);
+            }
+            else
+            {
+                recordedWatches.erase(watch->wd);
+            }
+            continue;
+        }
+
+        const auto& batch = std::get<EventsRecord>(traceRecord);
+        if (_speedFactor > 0 && batch.offset > previousOffset)
+        {
+            co_await sdbusplus::async::sleep_for(
+                _ctx, std::chrono::duration_cast<std::chrono::microseconds>(
+                          (batch.offset - previousOffset) / _speedFactor));
+        }
+        previousOffset = batch.offset;
+
+        std::vector<inotify::EventInfo> events;
+        for (const auto& [wd, name, mask, cookie] : batch.events)
+        {
+            std::optional<inotify::WD> liveWD;
+            if (auto it = recordedWatches.find(wd); it != recordedWatches.end())
+            {
+                liveWD = watcher.getWatchDescriptor(it->second);
+            }
+            if (!liveWD.has_value())
+            {
+                ++droppedEvents;
+                continue;
+            }
+            events.emplace_back(*liveWD, name, mask, cookie);
+        }
+        replayedEvents += events.size();
+
+        if (auto dataOperations = watcher.replayEvents(events);
+            !dataOperations.empty())
+        {
+            handler(dataOperations);
+        }
+    }
+
+    lg2::info("Replayed {REPLAYED} inotify events for [{PATH}], dropped "
+              "{DROPPED} events of the unwatched paths",
+              "REPLAYED", replayedEvents, "PATH", _configuredPath, "DROPPED",
+              droppedEvents);
+    co_return;
+}
+
+} // namespace data_sync::watch::trace
@@ -0,0 +1,212 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "data_watcher.hpp"
+
+#include <sdbusplus/async.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <variant>
+#include <vector>
+
+namespace data_sync::watch::trace
+{
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief The trace file layout.
+ *
+ * The trace is a line oriented text file so that it stays compact and can be
+ * inspected or trimmed by hand before replaying. Each line starts with a
+ * record type followed by space separated fields. The path and name fields
+ * are always the last field since they may contain spaces.
+ *
+ *   C <configured path>                           - Path being watched
+ *   W <wd> <path>                                 - Watch added
+ *   R <wd>                                        - Watch removed
+ *   E <offset in us> <wd> <mask in hex> <cookie> <name> - inotify event
+ *
+ * The offset of an event is relative to the start of the recording, and all
+ * the events read from the inotify fd in one go share the same offset.
+ */
+namespace record
+{
+constexpr char configuredPath = 'C';
+constexpr char watchAdded = 'W';
+constexpr char watchRemoved = 'R';
+constexpr char event = 'E';
+} // namespace record
+
+/**
+ * @class EventRecorder
+ *
+ * @brief Writes the raw inotify events received by a DataWatcher along with
+ *        its watch table changes into a trace file.
+ */
+class EventRecorder
+{
+  public:
+    EventRecorder(const EventRecorder&) = delete;
+    EventRecorder& operator=(const EventRecorder&) = delete;
+    EventRecorder(EventRecorder&&) = delete;
+    EventRecorder& operator=(EventRecorder&&) = delete;
+    ~EventRecorder() = default;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] traceFile - The file to write the trace into. An existing
+     *                        file will be truncated.
+     * @param[in] configuredPath - The path monitored by the DataWatcher
+     *
+     * @throws std::runtime_error if the trace file cannot be opened
+     */
+    EventRecorder(const fs::path& traceFile, const fs::path& configuredPath);
+
+    /**
+     * @brief Record a newly added watch.
+     *
+     * @param[in] wd - The watch descriptor
+     * @param[in] path - The path monitored by the watch descriptor
+     */
+    void recordWatchAdded(inotify::WD wd, const fs::path& path);
+
+    /**
+     * @brief Record a removed watch.
+     *
+     * @param[in] wd - The watch descriptor
+     */
+    void recordWatchRemoved(inotify::WD wd);
+
+    /**
+     * @brief Record the events read from the inotify fd in one go.
+     *
+     * @param[in] events - The received events including the uninterested
+     *                     ones, so that the filtering can be tuned on replay.
+     */
+    void recordEvents(const std::vector<inotify::EventInfo>& events);
+
+  private:
+    /**
+     * @brief The trace file stream
+     */
+    std::ofstream _traceFile;
+
+    /**
+     * @brief The time at which the recording started.
+     */
+    std::chrono::steady_clock::time_point _startTime;
+};
+
+/**
+ * @brief A watch table change captured in the trace.
+ *
+ * Holds the path for the added watch and std::nullopt for the removed one.
+ */
+struct WatchRecord
+{
+    inotify::WD wd;
+    std::optional<fs::path> path;
+};
+
+/**
+ * @brief A batch of events read from the inotify fd in one go.
+ */
+struct EventsRecord
+{
+    std::chrono::microseconds offset;
+    std::vector<inotify::EventInfo> events;
+};
+
+using TraceRecord = std::variant<WatchRecord, EventsRecord>;
+
+/**
+ * @class EventReplayer
+ *
+ * @brief Feeds a recorded trace back into a DataWatcher so that the data
+ *        operations pipeline can be exercised without the live system.
+ */
+class EventReplayer
+{
+  public:
+    using DataOperationsHandler =
+        std::function<void(const inotify::DataOperations&)>;
+
+    EventReplayer(const EventReplayer&) = delete;
+    EventReplayer& operator=(const EventReplayer&) = delete;
+    EventReplayer(EventReplayer&&) = delete;
+    EventReplayer& operator=(EventReplayer&&) = delete;
+    ~EventReplayer() = default;
+
+    /**
+     * @brief Constructor which loads the given trace.
+     *
+     * @param[in] ctx - The async context object
+     * @param[in] traceFile - The trace to replay
+     * @param[in] speedFactor - The replay speed relative to the recording.
+     *                          1 replays at the original speed, 10 replays
+     *                          ten times faster and 0 replays without any
+     *                          delay between the events.
+     *
+     * @throws std::runtime_error if the trace cannot be read or parsed
+     */
+    EventReplayer(sdbusplus::async::context& ctx, const fs::path& traceFile,
+                  double speedFactor = 1.0);
+
+    /**
+     * @brief API which returns the path monitored while recording.
+     */
+    const fs::path& getConfiguredPath() const
+    {
+        return _configuredPath;
+    }
+
+    /**
+     * @brief Replay the loaded trace.
+     *
+     * The recorded watch descriptors are translated to the ones in the given
+     * watcher using the recorded path, and the events for the paths which
+     * are not watched by the given watcher are dropped.
+     *
+     * @param[in] watcher - The watcher to feed the events into
+     * @param[in] handler - Invoked with the data operations resulted from
+     *                      each replayed batch of events
+     */
+    sdbusplus::async::task<> replay(inotify::DataWatcher& watcher,
+                                    DataOperationsHandler handler);
+
+  private:
+    /**
+     * @brief API to parse the given trace file
+     *
+     * @param[in] traceFile - The trace to parse
+     */
+    void load(const fs::path& traceFile);
+
+    /**
+     * @brief The async context object
+     */
+    sdbusplus::async::context& _ctx;
+
+    /**
+     * @brief The replay speed relative to the recording.
+     */
+    double _speedFactor;
+
+    /**
+     * @brief The path monitored while recording.
+     */
+    fs::path _configuredPath;
+
+    /**
+     * @brief The records in the order they were captured.
+     */
+    std::vector<TraceRecord> _records;
+};
+
+} // namespace data_sync::watch::trace
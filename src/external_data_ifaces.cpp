@@ -20,7 +20,21 @@ BMCRole ExternalDataIFaces::bmcRole() const
 
 void ExternalDataIFaces::bmcRole(const BMCRole& bmcRole)
 {
+    if (_bmcRole == bmcRole)
+    {
+        return;
+    }
     _bmcRole = bmcRole;
+
+    if (_roleChangedCallback)
+    {
+        _roleChangedCallback(_bmcRole);
+    }
+}
+
+void ExternalDataIFaces::setRoleChangedCallback(RoleChangedCallback callback)
+{
+    _roleChangedCallback = std::move(callback);
 }
 
 BMCRedundancy ExternalDataIFaces::bmcRedundancy() const
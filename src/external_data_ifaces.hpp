@@ -1,12 +1,17 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #pragma once
+
+#include "error_log.hpp"
+
 #include <nlohmann/json.hpp>
 #include <sdbusplus/async.hpp>
 #include <xyz/openbmc_project/Logging/Create/common.hpp>
 #include <xyz/openbmc_project/Logging/Entry/server.hpp>
 #include <xyz/openbmc_project/State/BMC/Redundancy/common.hpp>
 
+#include <functional>
+
 namespace data_sync::ext_data
 {
 
@@ -20,6 +25,7 @@ using AdditionalData = std::map<std::string, std::string>;
 using Logging = sdbusplus::common::xyz::openbmc_project::logging::Create;
 using ErrorLevel =
     sdbusplus::xyz::openbmc_project::Logging::server::Entry::Level;
+using RoleChangedCallback = std::function<void(const BMCRole&)>;
 
 /**
  * @class ExternalDataIFaces
@@ -103,13 +109,13 @@ class ExternalDataIFaces
      * @param[in] errSeverity - Severity level of the error log entry.
      * @param[in] additionalDetails - Optional information to aid in debugging,
      *                                included in the error log entry.
-     * @param[in] calloutsDetails - Optional callout details to be included in
-     *                              the error log entry.
+     * @param[in] ffdcSections - Optional FFDC sections (Eg: callouts, traces)
+     *                           to be attached to the error log entry.
      */
     virtual sdbusplus::async::task<> createErrorLog(
         const std::string& errMsg, const ErrorLevel& errSeverity,
         AdditionalData& additionalDetails,
-        const std::optional<json>& calloutsDetails = std::nullopt) = 0;
+        const error_log::FFDCSections& ffdcSections = {}) = 0;
 
     /**
      * @brief Watch for the Redundancy manager properties.
@@ -118,6 +124,14 @@ class ExternalDataIFaces
      */
     virtual sdbusplus::async::task<> watchRedundancyMgrProps() = 0;
 
+    /**
+     * @brief Used to register the callback to be invoked whenever the BMC
+     *        role changes, Eg: on failover.
+     *
+     * @param[in] callback - The callback which receives the new BMC role.
+     */
+    void setRoleChangedCallback(RoleChangedCallback callback);
+
   protected:
     /**
      * @brief Used to retrieve the BMC role.
@@ -171,6 +185,11 @@ class ExternalDataIFaces
      * @brief hold the BMC Position
      */
     BMCPosition _bmcPosition;
+
+    /**
+     * @brief The callback to notify the BMC role changes.
+     */
+    RoleChangedCallback _roleChangedCallback;
 };
 
 } // namespace data_sync::ext_data
@@ -10,6 +10,8 @@
 #include <xyz/openbmc_project/ObjectMapper/client.hpp>
 #include <xyz/openbmc_project/State/BMC/Redundancy/client.hpp>
 
+#include <memory>
+
 namespace data_sync::ext_data
 {
 
@@ -106,17 +108,20 @@ sdbusplus::async::task<> ExternalDataIFacesImpl::fetchBMCPosition()
 sdbusplus::async::task<> ExternalDataIFacesImpl::createErrorLog(
     const std::string& errMsg, const ErrorLevel& errSeverity,
     AdditionalData& additionalDetails,
-    const std::optional<json>& calloutsDetails)
+    const error_log::FFDCSections& ffdcSections)
 {
     try
     {
+        // The FFDC files must be kept open until the logging service consumed
+        // them, i.e. till the error log creation request completes.
+        std::vector<std::unique_ptr<error_log::FFDCFile>> ffdcFiles;
         error_log::FFDCFileInfoSet ffdcFileInfoSet;
-        if (calloutsDetails.has_value())
+        for (const auto& section : ffdcSections)
         {
-            error_log::FFDCFile file(error_log::FFDCFormat::JSON, 0xCA, 0x01,
-                                     calloutsDetails.value().dump());
-            ffdcFileInfoSet.emplace_back(file.getFormat(), file.getSubType(),
-                                         file.getVersion(), file.getFD());
+            const auto& file = ffdcFiles.emplace_back(
+                std::make_unique<error_log::FFDCFile>(section));
+            ffdcFileInfoSet.emplace_back(file->getFormat(), file->getSubType(),
+                                         file->getVersion(), file->getFD());
         }
 
         additionalDetails["_PID"] = std::to_string(getpid());
@@ -91,13 +91,13 @@ class ExternalDataIFacesImpl : public ExternalDataIFaces
      * @param[in] errSeverity - Severity level of the error log entry.
      * @param[in] additionalDetails - Optional information to aid in debugging,
      *                                included in the error log entry.
-     * @param[in] calloutsDetails - Optional callout details to be included in
-     *                              the error log entry.
+     * @param[in] ffdcSections - Optional FFDC sections (Eg: callouts, traces)
+     *                           to be attached to the error log entry.
      */
-    sdbusplus::async::task<>
-        createErrorLog(const std::string& errMsg, const ErrorLevel& errSeverity,
-                       AdditionalData& additionalDetails,
-                       const std::optional<json>& calloutsDetails) override;
+    sdbusplus::async::task<> createErrorLog(
+        const std::string& errMsg, const ErrorLevel& errSeverity,
+        AdditionalData& additionalDetails,
+        const error_log::FFDCSections& ffdcSections) override;
 
     /**
      * @brief Used to get the async context
@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "inotify_reader.hpp"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+namespace data_sync::watch::inotify
+{
+
+std::vector<EventInfo> parseEvents(std::span<const uint8_t> buffer)
+{
+    std::vector<EventInfo> events;
+    size_t offset = 0;
+    while (offset + sizeof(inotify_event) <= buffer.size())
+    {
+        inotify_event event{};
+        std::memcpy(&event, buffer.data() + offset, sizeof(inotify_event));
+
+        const size_t nameOffset = offset + offsetof(inotify_event, name);
+        std::string name;
+        if (event.len > 0 && nameOffset + event.len <= buffer.size())
+        {
+            // The name is null padded
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            name = reinterpret_cast<const char*>(buffer.data() + nameOffset);
+        }
+        events.emplace_back(event.wd, std::move(name), event.mask,
+                            event.cookie);
+        offset = nameOffset + event.len;
+    }
+    return events;
+}
+
+InotifyReader::Channel::Channel(int inotifyFd, size_t capacity) :
+    inotifyFd(inotifyFd), events(capacity),
+    eventFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+{
+    if (eventFd() == -1)
+    {
+        throw std::runtime_error("Failed to create the eventfd for inotify");
+    }
+}
+
+InotifyReader::InotifyReader() :
+    _epollFd(epoll_create1(EPOLL_CLOEXEC)),
+    _stopFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+{
+    if (_epollFd() == -1 || _stopFd() == -1)
+    {
+        lg2::error("Failed to create the inotify reader, ErrNo : {ERRNO}, "
+                   "ErrMsg : {ERRMSG}",
+                   "ERRNO", errno, "ERRMSG", strerror(errno));
+        throw std::runtime_error("Failed to create the inotify reader");
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = _stopFd();
+    if (epoll_ctl(_epollFd(), EPOLL_CTL_ADD, _stopFd(), &event) == -1)
+    {
+        throw std::runtime_error("Failed to watch the inotify reader stop fd");
+    }
+
+    _reader = std::thread([this]() { readerLoop(); });
+}
+
+InotifyReader::~InotifyReader()
+{
+    uint64_t count{1};
+    [[maybe_unused]] auto rc = write(_stopFd(), &count, sizeof(count));
+    if (_reader.joinable())
+    {
+        _reader.join();
+    }
+}
+
+InotifyReader& InotifyReader::instance()
+{
+    static InotifyReader inotifyReader;
+    return inotifyReader;
+}
+
+std::shared_ptr<InotifyReader::Channel>
+    InotifyReader::add(int inotifyFd, size_t capacity)
+{
+    auto channel = std::make_shared<Channel>(inotifyFd, capacity);
+
+    std::scoped_lock lock(_mutex);
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = inotifyFd;
+    if (epoll_ctl(_epollFd(), EPOLL_CTL_ADD, inotifyFd, &event) == -1)
+    {
+        lg2::error("Failed to watch the inotify fd {FD}, ErrNo : {ERRNO}, "
+                   "ErrMsg : {ERRMSG}",
+                   "FD", inotifyFd, "ERRNO", errno, "ERRMSG", strerror(errno));
+        throw std::runtime_error("Failed to watch the inotify fd");
+    }
+    _channels.insert_or_assign(inotifyFd, channel);
+    return channel;
+}
+
+void InotifyReader::remove(int inotifyFd)
+{
+    std::scoped_lock lock(_mutex);
+    epoll_ctl(_epollFd(), EPOLL_CTL_DEL, inotifyFd, nullptr);
+    _channels.erase(inotifyFd);
+}
+
+void InotifyReader::readerLoop()
+{
+    constexpr int maxEvents = 16;
+    std::array<epoll_event, maxEvents> readyFds{};
+
+    while (true)
+    {
+        const int count = epoll_wait(_epollFd(), readyFds.data(), maxEvents,
+                                     -1);
+        if (count == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            lg2::error("Inotify reader failed to wait, ErrNo : {ERRNO}, "
+                       "ErrMsg : {ERRMSG}",
+                       "ERRNO", errno, "ERRMSG", strerror(errno));
+            return;
+        }
+
+        for (int i = 0; i < count; ++i)
+        {
+            const int readyFd = readyFds.at(i).data.fd;
+            if (readyFd == _stopFd())
+            {
+                return;
+            }
+
+            std::scoped_lock lock(_mutex);
+            auto it = _channels.find(readyFd);
+            if (it != _channels.end())
+            {
+                drain(*it->second);
+            }
+        }
+    }
+}
+
+void InotifyReader::drain(Channel& channel)
+{
+    // Large enough to read many events per read call
+    constexpr size_t bufferSize = 64 * 1024;
+    alignas(inotify_event) static thread_local std::array<uint8_t, bufferSize>
+        buffer;
+
+    bool pushed{false};
+    while (true)
+    {
+        auto bytes = read(channel.inotifyFd, buffer.data(), buffer.size());
+        if (bytes <= 0)
+        {
+            if (bytes == -1 && errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                lg2::error("Failed to read inotify event, error: {ERROR}",
+                           "ERROR", strerror(errno));
+            }
+            break;
+        }
+
+        for (auto& event :
+             parseEvents({buffer.data(), static_cast<size_t>(bytes)}))
+        {
+            if (channel.events.push(std::move(event)))
+            {
+                pushed = true;
+            }
+            else
+            {
+                channel.overflowed.store(true, std::memory_order_release);
+            }
+        }
+    }
+
+    if (pushed || channel.overflowed.load(std::memory_order_acquire))
+    {
+        uint64_t count{1};
+        [[maybe_unused]] auto rc = write(channel.eventFd(), &count,
+                                         sizeof(count));
+    }
+}
+
+} // namespace data_sync::watch::inotify
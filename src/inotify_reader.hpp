@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "mpsc_ring.hpp"
+#include "utility.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace data_sync::watch::inotify
+{
+
+/**
+ * @brief A tuple which has the info related to the occured inotify event
+ *
+ * int         - Watch descriptor corresponds to the event
+ * std::string - name[] in inotify_event struct
+ * uint32_t    - Mask describing event
+ * uint32_t    - Cookie to relate the IN_MOVED_FROM and IN_MOVED_TO events
+ */
+using WD = int;
+using BaseName = std::string;
+using EventMask = uint32_t;
+using Cookie = uint32_t;
+using EventInfo = std::tuple<WD, BaseName, EventMask, Cookie>;
+
+/**
+ * @brief API to parse the inotify events from the bytes read from the inotify
+ *        fd.
+ *
+ * @param[in] buffer - The bytes read from the inotify fd
+ *
+ * @returns The events in the order received.
+ */
+std::vector<EventInfo> parseEvents(std::span<const uint8_t> buffer);
+
+/**
+ * @class InotifyReader
+ *
+ * @brief Reads the registered inotify fds on a dedicated thread, so that the
+ *        kernel event queue is drained even while the event loop is busy
+ *        (Eg: D-Bus traffic, JSON parsing, spawning).
+ *
+ * The events of each inotify fd are pushed into its own bounded lock-free
+ * ring, and its eventfd is signalled for the event loop to consume them in
+ * batches. The events which don't fit in the ring are dropped and flagged,
+ * for the consumer to treat it as an inotify queue overflow.
+ */
+class InotifyReader
+{
+  public:
+    /**
+     * @brief The events read from an inotify fd, towards its consumer.
+     */
+    struct Channel
+    {
+        Channel(int inotifyFd, size_t capacity);
+
+        // The inotify fd to read
+        int inotifyFd;
+
+        // The events read and not yet consumed
+        utility::MpscRing<EventInfo> events;
+
+        // Signalled when the events are pushed
+        utility::FD eventFd;
+
+        // Set when the events are dropped as the ring was full
+        std::atomic<bool> overflowed{false};
+    };
+
+    InotifyReader(const InotifyReader&) = delete;
+    InotifyReader& operator=(const InotifyReader&) = delete;
+    InotifyReader(InotifyReader&&) = delete;
+    InotifyReader& operator=(InotifyReader&&) = delete;
+
+    /**
+     * @brief Constructor, starts the reader thread.
+     *
+     * @throws std::runtime_error if the epoll or eventfd cannot be created
+     */
+    InotifyReader();
+
+    /**
+     * @brief Destructor, stops the reader thread.
+     */
+    ~InotifyReader();
+
+    /**
+     * @brief API to get the inotify reader of the daemon.
+     */
+    static InotifyReader& instance();
+
+    /**
+     * @brief API to start reading the given inotify fd.
+     *
+     * @param[in] inotifyFd - The non blocking inotify fd to read
+     * @param[in] capacity - The number of the events to buffer
+     *
+     * @return The channel to consume the events from.
+     *
+     * @throws std::runtime_error on failure
+     */
+    std::shared_ptr<Channel> add(int inotifyFd, size_t capacity);
+
+    /**
+     * @brief API to stop reading the given inotify fd. The reader doesn't
+     *        touch the fd once returned, so the fd can be closed.
+     *
+     * @param[in] inotifyFd - The inotify fd to stop reading
+     */
+    void remove(int inotifyFd);
+
+  private:
+    /**
+     * @brief The reader thread loop.
+     */
+    void readerLoop();
+
+    /**
+     * @brief API to read all the available events of the given channel into
+     *        its ring.
+     *
+     * @param[in] channel - The channel to read
+     */
+    static void drain(Channel& channel);
+
+    /**
+     * @brief The epoll fd to wait on the registered inotify fds.
+     */
+    utility::FD _epollFd;
+
+    /**
+     * @brief Signalled to stop the reader thread.
+     */
+    utility::FD _stopFd;
+
+    /**
+     * @brief Protects the channels, held while a channel is being read so
+     *        that a removed fd is never read.
+     */
+    std::mutex _mutex;
+
+    /**
+     * @brief The channels by their inotify fd.
+     */
+    std::map<int, std::shared_ptr<Channel>> _channels;
+
+    /**
+     * @brief The reader thread.
+     */
+    std::thread _reader;
+};
+
+} // namespace data_sync::watch::inotify
@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "keyed_serial_executor.hpp"
+
+#include "utility.hpp"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <experimental/scope>
+#include <ranges>
+#include <stdexcept>
+
+namespace data_sync::async
+{
+
+namespace
+{
+
+} // namespace
+
+bool KeyedSerialExecutor::isOverlapping(const fs::path& lhs,
+                                        const fs::path& rhs)
+{
+    const auto lhsPath = utility::withoutTrailingSlash(lhs);
+    const auto rhsPath = utility::withoutTrailingSlash(rhs);
+    auto [lhsEnd, rhsEnd] = std::ranges::mismatch(lhsPath, rhsPath);
+    return lhsEnd == lhsPath.end() || rhsEnd == rhsPath.end();
+}
+
+std::optional<KeyedSerialExecutor::Ticket>
+    KeyedSerialExecutor::enqueue(const fs::path& path)
+{
+    auto key = utility::withoutTrailingSlash(path);
+    if (std::ranges::any_of(_jobs | std::views::values,
+                            [&key](const JobState& job) {
+        return !job.running && job.path == key;
+    }))
+    {
+        return std::nullopt;
+    }
+
+    auto ticket = _nextTicket++;
+    _jobs.emplace(ticket, JobState{std::move(key), false, -1});
+    return ticket;
+}
+
+bool KeyedSerialExecutor::isReady(Ticket ticket) const
+{
+    auto job = _jobs.find(ticket);
+    if (job == _jobs.end())
+    {
+        return false;
+    }
+    return std::ranges::none_of(std::ranges::subrange(_jobs.begin(), job),
+                                [&job](const auto& earlier) {
+        return isOverlapping(earlier.second.path, job->second.path);
+    });
+}
+
+bool KeyedSerialExecutor::tryStart(Ticket ticket)
+{
+    if (!isReady(ticket))
+    {
+        return false;
+    }
+    _jobs.at(ticket).running = true;
+    return true;
+}
+
+std::vector<KeyedSerialExecutor::Ticket>
+    KeyedSerialExecutor::complete(Ticket ticket)
+{
+    _jobs.erase(ticket);
+
+    std::vector<Ticket> readyJobs;
+    for (auto& [waiting, job] : _jobs)
+    {
+        if (job.running || !isReady(waiting))
+        {
+            continue;
+        }
+        readyJobs.emplace_back(waiting);
+        if (job.wakeupFd != -1)
+        {
+            uint64_t count{1};
+            [[maybe_unused]] auto rc = write(job.wakeupFd, &count,
+                                             sizeof(count));
+        }
+    }
+    return readyJobs;
+}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<bool> KeyedSerialExecutor::run(
+    sdbusplus::async::context& ctx, fs::path path, Job job)
+{
+    auto ticket = enqueue(path);
+    if (!ticket.has_value())
+    {
+        lg2::debug("Merged the sync of {PATH} into the one waiting", "PATH",
+                   path);
+        co_return true;
+    }
+
+    using std::experimental::scope_exit;
+    auto completion = scope_exit([this, &ticket]() noexcept {
+        complete(*ticket);
+    });
+
+    if (!tryStart(*ticket))
+    {
+        lg2::debug("The sync of {PATH} waits for the earlier syncs of the "
+                   "overlapping paths",
+                   "PATH", path);
+        data_sync::utility::FD wakeupFd(
+            eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC));
+        if (wakeupFd() == -1)
+        {
+            throw std::runtime_error("Failed to create the eventfd to wait "
+                                     "for the sync of " +
+                                     path.string());
+        }
+        _jobs.at(*ticket).wakeupFd = wakeupFd();
+        sdbusplus::async::fdio fdioInstance(ctx, wakeupFd());
+        while (!tryStart(*ticket))
+        {
+            // NOLINTNEXTLINE
+            co_await fdioInstance.next();
+
+            uint64_t count{0};
+            [[maybe_unused]] auto rc = read(wakeupFd(), &count,
+                                            sizeof(count));
+        }
+        _jobs.at(*ticket).wakeupFd = -1;
+    }
+
+    // NOLINTNEXTLINE
+    co_return co_await job();
+}
+
+} // namespace data_sync::async
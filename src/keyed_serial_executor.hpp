@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <sdbusplus/async.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace data_sync::async
+{
+
+namespace fs = std::filesystem;
+
+/**
+ * @class KeyedSerialExecutor
+ *
+ * @brief Runs the jobs on the overlapping paths, i.e. the same path or an
+ *        ancestor and its descendant, one after another in their submission
+ *        order, while the jobs on the unrelated paths run in parallel.
+ *
+ * A job submitted while a job on the same path is still waiting for its turn
+ * is merged into the waiting one, as the job syncs the path as it is when it
+ * starts.
+ */
+class KeyedSerialExecutor
+{
+  public:
+    using Ticket = uint64_t;
+    using Job = std::function<sdbusplus::async::task<bool>()>;
+
+    KeyedSerialExecutor() = default;
+    KeyedSerialExecutor(const KeyedSerialExecutor&) = delete;
+    KeyedSerialExecutor& operator=(const KeyedSerialExecutor&) = delete;
+    KeyedSerialExecutor(KeyedSerialExecutor&&) = delete;
+    KeyedSerialExecutor& operator=(KeyedSerialExecutor&&) = delete;
+    ~KeyedSerialExecutor() = default;
+
+    /**
+     * @brief API to run the given job once the earlier jobs on the
+     *        overlapping paths are completed.
+     *
+     * @param[in] ctx - The async context object
+     * @param[in] path - The path which the job is about
+     * @param[in] job - The job to run
+     *
+     * @return The result of the job, or True if it is merged into a waiting
+     *         job on the same path.
+     */
+    // NOLINTNEXTLINE
+    sdbusplus::async::task<bool> run(sdbusplus::async::context& ctx,
+                                     fs::path path, Job job);
+
+    /**
+     * @brief API to queue a job on the given path.
+     *
+     * @param[in] path - The path which the job is about
+     *
+     * @return The ticket of the job, or std::nullopt if it is merged into a
+     *         waiting job on the same path.
+     */
+    std::optional<Ticket> enqueue(const fs::path& path);
+
+    /**
+     * @brief API to start the queued job if the earlier jobs on the
+     *        overlapping paths are completed.
+     *
+     * @param[in] ticket - The ticket of the job
+     *
+     * @return True if started; otherwise False.
+     */
+    bool tryStart(Ticket ticket);
+
+    /**
+     * @brief API to complete the started job.
+     *
+     * @param[in] ticket - The ticket of the job
+     *
+     * @return The tickets of the queued jobs which can start now.
+     */
+    std::vector<Ticket> complete(Ticket ticket);
+
+    /**
+     * @brief API to get the number of the queued and running jobs.
+     */
+    size_t size() const
+    {
+        return _jobs.size();
+    }
+
+    /**
+     * @brief API to check whether the paths overlap, i.e. the same path or
+     *        one is an ancestor of the other.
+     *
+     * @param[in] lhs - The path to check
+     * @param[in] rhs - The other path to check
+     */
+    static bool isOverlapping(const fs::path& lhs, const fs::path& rhs);
+
+  private:
+    /**
+     * @brief The state of a queued or running job.
+     */
+    struct JobState
+    {
+        // The path without the trailing slash
+        fs::path path;
+
+        // Indicates the job is started
+        bool running{false};
+
+        // The eventfd to wake up the job waiting for its turn, -1 if none
+        int wakeupFd{-1};
+    };
+
+    /**
+     * @brief API to check whether the queued job is clear to start.
+     *
+     * @param[in] ticket - The ticket of the job
+     */
+    bool isReady(Ticket ticket) const;
+
+    /**
+     * @brief The queued and running jobs, in the submission order.
+     */
+    std::map<Ticket, JobState> _jobs;
+
+    /**
+     * @brief The ticket for the next job.
+     */
+    Ticket _nextTicket{1};
+};
+
+} // namespace data_sync::async
@@ -6,18 +6,28 @@
 
 #include "async_command_exec.hpp"
 #include "data_watcher.hpp"
+#include "event_trace.hpp"
+#include "inotify_reader.hpp"
 #include "notify_sibling.hpp"
+#include "worker_pool.hpp"
+
+#include <sys/inotify.h>
+#include <unistd.h>
 
 #include <nlohmann/json.hpp>
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cstdlib>
+#include <cstring>
 #include <exception>
 #include <experimental/scope>
 #include <fstream>
 #include <iterator>
 #include <string>
 #include <string_view>
+#include <utility>
 
 namespace data_sync
 {
@@ -26,8 +36,16 @@ Manager::Manager(sdbusplus::async::context& ctx,
                  std::unique_ptr<ext_data::ExternalDataIFaces>&& extDataIfaces,
                  const fs::path& dataSyncCfgDir) :
     _ctx(ctx), _extDataIfaces(std::move(extDataIfaces)),
-    _dataSyncCfgDir(dataSyncCfgDir), _syncBMCDataIface(ctx, *this)
+    _dataSyncCfgDir(dataSyncCfgDir), _syncBMCDataIface(ctx, *this),
+    _replicationIface(ctx, *this), _changeJournal(persist::ChangeJournalFile),
+    _circuitBreaker(retry::CircuitBreaker::defaultFailureThreshold,
+                    std::chrono::seconds(DEFAULT_RETRY_INTERVAL)),
+    _errorLogQueue(ctx, *_extDataIfaces,
+                   std::chrono::seconds(ERROR_LOG_WINDOW)),
+    _echoSuppressor(APPLIED_CHANGES_LOG)
 {
+    _ctx.spawn(_errorLogQueue.run());
+    _ctx.spawn(monitorAppliedChanges());
     _ctx.spawn(init());
 }
 
@@ -36,6 +54,12 @@ sdbusplus::async::task<> Manager::init()
 {
     co_await sdbusplus::async::execution::when_all(
         parseConfiguration(), _extDataIfaces->startExtDataFetches());
+    validateConsistencyGroups();
+
+    // Registered once the role is fetched, so that only the later changes
+    // (Eg: failover) are handled.
+    _extDataIfaces->setRoleChangedCallback(
+        [this](const ext_data::BMCRole& bmcRole) { bmcRoleChanged(bmcRole); });
 
 // Sibling notification logic is tested independently in notify_service_test
 // Disabled here to avoid unwanted watch additions while testing manager logic.
@@ -54,12 +78,29 @@ sdbusplus::async::task<> Manager::init()
      * role changes, ensuring data is synchronized according to the new role.
      */
     _ctx.spawn(_extDataIfaces->watchRedundancyMgrProps());
+
+    // The sibling rsync daemon is reached through the local stunnel port.
+    _siblingMonitor = std::make_unique<sibling::SiblingMonitor>(
+        _ctx, "127.0.0.1",
+        static_cast<uint16_t>(std::stoi(_extDataIfaces->bmcPosition() == 0
+                                            ? BMC1_RSYNC_PORT
+                                            : BMC0_RSYNC_PORT)),
+        std::chrono::seconds(SIBLING_PROBE_INTERVAL), SIBLING_PROBE_FAILURES,
+        [this](bool available) { siblingAvailabilityChanged(available); });
+    _ctx.spawn(_siblingMonitor->run());
 #endif
 
     if (!_extDataIfaces->bmcRedundancy() || _syncBMCDataIface.disable_sync())
     {
         lg2::warning(
             "Either Redundancy or Sync is disabled, No sync operations will be performed.");
+
+        // The changes are not watched while the sync is disabled at startup,
+        // hence the full sync is required once it is enabled.
+        if (_extDataIfaces->bmcRedundancy())
+        {
+            _changeJournal.markOverflowed();
+        }
         co_return;
     }
 
@@ -69,6 +110,12 @@ sdbusplus::async::task<> Manager::init()
 
     co_await startSyncEvents();
 
+    if (_startupReplay.has_value())
+    {
+        const auto& [traceFile, speedFactor] = _startupReplay.value();
+        _ctx.spawn(replayEventTrace(traceFile, speedFactor));
+    }
+
     co_return;
 }
 
@@ -79,10 +126,15 @@ sdbusplus::async::task<> Manager::parseConfiguration()
         bool exception{false};
         try
         {
-            std::ifstream file;
-            file.open(configFile.path());
-
-            nlohmann::json configJSON(nlohmann::json::parse(file));
+            // Read and parse off the event loop, as the configuration files
+            // can be large.
+            nlohmann::json configJSON =
+                co_await worker::WorkerPool::instance().run(
+                    _ctx, [configFilePath = configFile.path()]() {
+                std::ifstream file;
+                file.open(configFilePath);
+                return nlohmann::json::parse(file);
+            });
 
             if (configJSON.contains("Files"))
             {
@@ -117,9 +169,9 @@ sdbusplus::async::task<> Manager::parseConfiguration()
                 {"DS_Parser_Msg",
                  "Exception: Failed to parse the data sync configuration"}};
             additionalDetails["DS_Config_File"] = configFile.path();
-            co_await _extDataIfaces->createErrorLog(
-                "xyz.openbmc_project.RBMC_DataSync.Error.ParserFailure",
-                ext_data::ErrorLevel::Warning, additionalDetails);
+            _errorLogQueue.submit(
+                {"xyz.openbmc_project.RBMC_DataSync.Error.ParserFailure",
+                 ext_data::ErrorLevel::Warning, additionalDetails});
         }
         co_return;
     };
@@ -135,6 +187,62 @@ sdbusplus::async::task<> Manager::parseConfiguration()
     co_return;
 }
 
+void Manager::validateConsistencyGroups()
+{
+    std::map<std::string, std::vector<config::DataSyncConfig*>> groups;
+    for (auto& cfg : _dataSyncConfiguration)
+    {
+        if (cfg._consistencyGroup.has_value())
+        {
+            groups[cfg._consistencyGroup.value()].emplace_back(&cfg);
+        }
+    }
+
+    for (const auto& [groupName, members] : groups)
+    {
+        // Synced in a single rsync with the flags of the first path, hence
+        // the paths can't have their own destination or filters.
+        const auto& first = *members.front();
+        if (std::ranges::all_of(members, [&first](const auto* member) {
+            return member->_syncDirection == first._syncDirection &&
+                   member->_destPath == first._destPath &&
+                   !member->_excludeList.has_value() &&
+                   !member->_includeList.has_value();
+        }))
+        {
+            lg2::debug("Consistency group {GROUP} has {COUNT} paths", "GROUP",
+                       groupName, "COUNT", members.size());
+            continue;
+        }
+
+        lg2::error("The paths of the consistency group {GROUP} can't be "
+                   "synced together, syncing them on their own",
+                   "GROUP", groupName);
+        for (auto* member : members)
+        {
+            member->_consistencyGroup.reset();
+        }
+    }
+}
+
+std::vector<const config::DataSyncConfig*> Manager::getConsistencyGroup(
+    const config::DataSyncConfig& dataSyncCfg) const
+{
+    std::vector<const config::DataSyncConfig*> group;
+    if (!dataSyncCfg._consistencyGroup.has_value())
+    {
+        return group;
+    }
+    for (const auto& cfg : _dataSyncConfiguration)
+    {
+        if (cfg._consistencyGroup == dataSyncCfg._consistencyGroup)
+        {
+            group.emplace_back(&cfg);
+        }
+    }
+    return group;
+}
+
 sdbusplus::async::task<> Manager::processPendingNotifications()
 {
     {
@@ -208,9 +316,9 @@ sdbusplus::async::task<> Manager::monitorServiceNotifications()
             {"DS_Notify_DIR", notifyDir},
             {"DS_Notify_Msg",
              "Exception: Failed to create inotify watcher for notify services directory"}};
-        co_await _extDataIfaces->createErrorLog(
-            "xyz.openbmc_project.RBMC_DataSync.Error.NotifyFailure",
-            ext_data::ErrorLevel::Informational, additionalDetails);
+        _errorLogQueue.submit(
+            {"xyz.openbmc_project.RBMC_DataSync.Error.NotifyFailure",
+             ext_data::ErrorLevel::Informational, additionalDetails});
     }
     co_return;
 }
@@ -249,38 +357,106 @@ sdbusplus::async::task<> Manager::startSyncEvents()
             std::views::filter([this](const auto& dataSyncCfg) {
         return this->isSyncEligible(dataSyncCfg);
     }),
-        [this](const auto& dataSyncCfg) {
-        using enum config::SyncType;
-        if (dataSyncCfg._syncType == Immediate)
+        [this](const auto& dataSyncCfg) { spawnSyncEvents(dataSyncCfg); });
+    co_return;
+}
+
+void Manager::spawnSyncEvents(const config::DataSyncConfig& dataSyncCfg)
+{
+    // The events which are already running are kept as is, Eg: on enabling
+    // the sync after disabling it.
+    if (dataSyncCfg._syncEventsRunning)
+    {
+        dataSyncCfg._syncEventsStopRequested = false;
+        return;
+    }
+
+    using enum config::SyncType;
+    if (dataSyncCfg._syncType == Immediate)
+    {
+        try
         {
-            try
-            {
-                this->_ctx.spawn(this->monitorDataToSync(dataSyncCfg));
-            }
-            catch (const std::exception& e)
-            {
-                lg2::error(
-                    "Failed to start immediate sync for {PATH}: {EXCEPTION}",
-                    "EXCEPTION", e, "PATH", dataSyncCfg._path);
-                setSyncEventsHealth(SyncEventsHealth::Critical);
-            }
+            _ctx.spawn(monitorDataToSync(dataSyncCfg));
         }
-        else if (dataSyncCfg._syncType == Periodic)
+        catch (const std::exception& e)
         {
-            try
-            {
-                this->_ctx.spawn(this->monitorTimerToSync(dataSyncCfg));
-            }
-            catch (const std::exception& e)
+            lg2::error("Failed to start immediate sync for {PATH}: {EXCEPTION}",
+                       "EXCEPTION", e, "PATH", dataSyncCfg._path);
+            setSyncEventsHealth(SyncEventsHealth::Critical);
+        }
+    }
+    else if (dataSyncCfg._syncType == Periodic)
+    {
+        try
+        {
+            schedulePeriodicSync(dataSyncCfg);
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error("Failed to start periodic sync for {PATH}: "
+                       "{EXCEPTION}",
+                       "EXCEPTION", e, "PATH", dataSyncCfg._path);
+            setSyncEventsHealth(SyncEventsHealth::Critical);
+        }
+    }
+}
+
+void Manager::bmcRoleChanged(const ext_data::BMCRole& bmcRole)
+{
+    if (!_extDataIfaces->bmcRedundancy())
+    {
+        lg2::info("BMC role changed to {ROLE}, but redundancy is disabled",
+                  "ROLE", _extDataIfaces->bmcRoleInStr());
+        return;
+    }
+
+    lg2::info("BMC role changed to {ROLE}, re-evaluating the sync events",
+              "ROLE", _extDataIfaces->bmcRoleInStr());
+
+    using enum config::SyncDirection;
+    for (const auto& cfg : _dataSyncConfiguration)
+    {
+        // The Bidirectional sync doesn't depend on the role
+        if (cfg._syncDirection == Bidirectional)
+        {
+            continue;
+        }
+
+        const bool wasEligible = cfg._syncEventsRunning &&
+                                 !cfg._syncEventsStopRequested;
+        const bool isEligible = isSyncEligible(cfg);
+
+        if (wasEligible && !isEligible)
+        {
+            lg2::debug("Stopping the sync events of [{PATH}] for the role "
+                       "{ROLE}",
+                       "PATH", cfg._path, "ROLE", bmcRole);
+            cfg._syncEventsStopRequested = true;
+
+            // Woken up to release the watches right away, rather than upon
+            // the next change.
+            if (auto wakeup = _syncEventsWakeups.find(cfg._path);
+                wakeup != _syncEventsWakeups.end())
             {
-                lg2::error("Failed to start periodic sync for {PATH}: "
-                           "{EXCEPTION}",
-                           "EXCEPTION", e, "PATH", dataSyncCfg._path);
-                setSyncEventsHealth(SyncEventsHealth::Critical);
+                wakeup->second();
             }
+
+            // The sibling BMC owns the data now
+            cfg._pendingChanges.clear();
         }
-    });
-    co_return;
+        else if (!wasEligible && isEligible)
+        {
+            lg2::debug("Starting the sync events of [{PATH}] for the role "
+                       "{ROLE}",
+                       "PATH", cfg._path, "ROLE", bmcRole);
+            spawnSyncEvents(cfg);
+
+            // This BMC owns the data now, hence sync the changes made while
+            // it was not the owner.
+            _ctx.spawn(syncData(cfg) |
+                       stdexec::then([]([[maybe_unused]] bool result) {}));
+        }
+    }
 }
 
 bool Manager::isRetryEligible(uint8_t errCode) noexcept
@@ -312,28 +488,57 @@ void Manager::getRsyncCmd(RsyncMode mode,
 {
     using namespace std::string_literals;
 
+    // The paths of a consistency group are always synced together
+    const auto group = (mode == RsyncMode::Sync)
+                           ? getConsistencyGroup(dataSyncCfg)
+                           : std::vector<const config::DataSyncConfig*>{};
+
     cmd.append("rsync --compress --recursive --perms --group --owner --times "
                "--atimes --update"s);
-    if (mode == RsyncMode::Sync)
+    if (mode == RsyncMode::Sync || mode == RsyncMode::Rename)
     {
         // Appending required flags to sync data between BMCs
         // For more details about CLI options, refer rsync man page.
         // https://download.samba.org/pub/rsync/rsync.1#OPTION_SUMMARY
 
-        cmd.append(" --relative --delete --delete-missing-args --stats"s);
+        cmd.append(" --relative --delete --delete-missing-args --stats "
+                   "--itemize-changes"s);
 
         if (dataSyncCfg._excludeList.has_value())
         {
             cmd.append(dataSyncCfg._excludeList->second);
         }
     }
+    if (mode == RsyncMode::Rename)
+    {
+        // The old copy of the renamed path is the basis of the new path, as
+        // it has the same size and time, and it is deleted afterwards. The
+        // delta transfer is the default only for a remote destination.
+        // But the basis is looked up only in the destination directory of
+        // the new path, hence the files of a renamed directory are still
+        // transferred in full.
+        cmd.append(" --fuzzy --delete-delay --no-whole-file"s);
+    }
+    else if (!group.empty())
+    {
+        // The paths of the group are staged on the sibling, and published
+        // together once all of them are transferred.
+        cmd.append(" --delay-updates"s);
+    }
     else if (mode == RsyncMode::Notify)
     {
         // Appending the required flags to notify the siblng
         cmd.append(" --remove-source-files"s);
     }
 
-    if (!srcPath.empty())
+    if (!group.empty())
+    {
+        for (const auto* member : group)
+        {
+            cmd.append(" "s + member->_path.string());
+        }
+    }
+    else if (!srcPath.empty())
     {
         // Append the modified path name as its available
         cmd.append(" "s + srcPath);
@@ -381,7 +586,7 @@ void Manager::getRsyncCmd(RsyncMode mode,
     cmd.append(rsyncdURL);
 #endif
 
-    if (mode == RsyncMode::Sync)
+    if (mode == RsyncMode::Sync || mode == RsyncMode::Rename)
     {
         // Add destination data path if configured
         cmd.append(dataSyncCfg._destPath.value_or(fs::path("")).string());
@@ -392,35 +597,122 @@ void Manager::getRsyncCmd(RsyncMode mode,
     }
 }
 
+std::vector<fs::path>
+    Manager::getNotifyPaths(const config::DataSyncConfig& dataSyncCfg,
+                            const fs::path& syncedPath,
+                            const utility::rsync::TransferStats& transfer)
+{
+    if (!dataSyncCfg._notifySibling.has_value())
+    {
+        return {};
+    }
+    const auto& notifySibling = dataSyncCfg._notifySibling.value();
+
+    if (transfer.changesTruncated)
+    {
+        // The exact changes are unknown, hence notify on the paths which the
+        // sync may have changed.
+        if (!transfer.hasChangesUnder(syncedPath))
+        {
+            return {};
+        }
+        if (notifySibling.needsNotification(syncedPath))
+        {
+            return {syncedPath};
+        }
+        std::vector<fs::path> notifyPaths;
+        for (const auto& path : notifySibling._paths.value())
+        {
+            if (utility::isSameOrChildOf(path, syncedPath))
+            {
+                notifyPaths.emplace_back(path);
+            }
+        }
+        return notifyPaths;
+    }
+
+    auto notifyPaths = transfer.getChangedPathsUnder(syncedPath);
+    std::erase_if(notifyPaths, [&notifySibling](const auto& path) {
+        return !notifySibling.needsNotification(path);
+    });
+    if (notifyPaths.empty())
+    {
+        lg2::debug("Sibling notification not configured for the paths "
+                   "changed under [{SRCPATH}] of the configured Path : "
+                   "[{CFGPATH}]",
+                   "SRCPATH", syncedPath, "CFGPATH", dataSyncCfg._path);
+    }
+    return notifyPaths;
+}
+
 sdbusplus::async::task<void>
     // NOLINTNEXTLINE
-    Manager::triggerSiblingNotification(
-        const config::DataSyncConfig& dataSyncCfg, const std::string& srcPath)
+    Manager::notifySiblingOfChanges(
+        const std::vector<std::pair<const config::DataSyncConfig*, fs::path>>&
+            syncedPaths,
+        const utility::rsync::TransferStats& transfer,
+        tracing::CorrelationId correlationId)
 {
-    std::error_code ec;
-    if (dataSyncCfg._notifySibling.has_value() &&
-        dataSyncCfg._notifySibling.value()._paths.has_value())
+    // The configs notifying the same services are notified together
+    std::vector<std::pair<const config::DataSyncConfig*, std::vector<fs::path>>>
+        notifications;
+    for (const auto& [cfg, syncedPath] : syncedPaths)
     {
-        if (!(dataSyncCfg._notifySibling.value()._paths.value().contains(
-                srcPath)) &&
-            (!fs::equivalent(srcPath, dataSyncCfg._path, ec)))
+        auto notifyPaths = getNotifyPaths(*cfg, syncedPath, transfer);
+        if (notifyPaths.empty())
         {
-            // Modified path doesn't need to notify
-            lg2::debug("Sibling notification not configured for the path : "
-                       "[{SRCPATH}] under the configured Path : [{CFGPATH}]",
-                       "SRCPATH", srcPath, "CFGPATH", dataSyncCfg._path);
-            co_return;
+            continue;
+        }
+        auto notification = std::ranges::find_if(
+            notifications, [cfg](const auto& notification) {
+            return notification.first->_notifySibling.value()._notifyReqInfo ==
+                   cfg->_notifySibling.value()._notifyReqInfo;
+        });
+        if (notification == notifications.end())
+        {
+            notifications.emplace_back(cfg, std::move(notifyPaths));
+        }
+        else
+        {
+            notification->second.insert(notification->second.end(),
+                                        notifyPaths.begin(), notifyPaths.end());
         }
     }
 
+    for (const auto& [cfg, notifyPaths] : notifications)
+    {
+        // NOLINTNEXTLINE
+        co_await triggerSiblingNotification(*cfg, notifyPaths, correlationId);
+    }
+    co_return;
+}
+
+sdbusplus::async::task<void>
+    // NOLINTNEXTLINE
+    Manager::triggerSiblingNotification(
+        const config::DataSyncConfig& dataSyncCfg,
+        const std::vector<fs::path>& modifiedPaths,
+        tracing::CorrelationId correlationId)
+{
+    const std::string srcPath = modifiedPaths.empty()
+                                    ? dataSyncCfg._path.string()
+                                    : modifiedPaths.front().string();
+
     bool exception{false};
 
     try
     {
         // initiate sibling notification
-        notify::NotifySibling notifySibling(dataSyncCfg, srcPath);
+        tracing::ScopedSpan span(correlationId, tracing::Stage::NotifyRequest,
+                                 srcPath);
+        // The notify request file is created off the event loop
+        auto notifySibling = co_await worker::WorkerPool::instance().run(
+            _ctx, [&dataSyncCfg, &modifiedPaths, correlationId]() {
+            return std::make_unique<notify::NotifySibling>(
+                dataSyncCfg, modifiedPaths, correlationId);
+        });
         co_await syncNotifyRequest(dataSyncCfg, srcPath,
-                                   notifySibling.getNotifyFilePath());
+                                   notifySibling->getNotifyFilePath());
     }
     catch (const std::exception& e)
     {
@@ -437,9 +729,9 @@ sdbusplus::async::task<void>
             {"DS_Notify_ModifiedPath", srcPath},
             {"DS_Notify_Msg",
              "Exception: Failed to trigger sibling notification request for the path"}};
-        co_await _extDataIfaces->createErrorLog(
-            "xyz.openbmc_project.RBMC_DataSync.Error.NotifyFailure",
-            ext_data::ErrorLevel::Informational, additionalDetails);
+        _errorLogQueue.submit(
+            {"xyz.openbmc_project.RBMC_DataSync.Error.NotifyFailure",
+             ext_data::ErrorLevel::Informational, additionalDetails});
     }
 
     co_return;
@@ -448,24 +740,40 @@ sdbusplus::async::task<void>
 sdbusplus::async::task<bool>
     // NOLINTNEXTLINE
     Manager::retrySync(const config::DataSyncConfig& cfg, fs::path srcPath,
-                       size_t retryCount)
+                       size_t retryCount, tracing::CorrelationId correlationId)
 {
     const fs::path currentSrcPath = srcPath.empty() ? cfg._path : srcPath;
 
+    // Park the retry until the sibling BMC connection is restored
+    if (_circuitBreaker.isOpen())
+    {
+        _changeJournal.add(cfg._path, currentSrcPath);
+        co_return false;
+    }
+
     if (cfg._retry.has_value() && retryCount++ < cfg._retry->_maxRetryAttempts)
     {
+        const auto retryInterval =
+            retry::backoff(cfg._retry->_retryIntervalInSec, retryCount);
         lg2::debug(
             "Retry [{RETRY_ATTEMPT}/{MAX_ATTEMPTS}] for [{SRC_PATH}] after "
-            "[{RETRY_INTERVAL}s]",
+            "[{RETRY_INTERVAL}ms]",
             "RETRY_ATTEMPT", retryCount, "MAX_ATTEMPTS",
             cfg._retry->_maxRetryAttempts, "SRC_PATH", currentSrcPath,
-            "RETRY_INTERVAL", cfg._retry->_retryIntervalInSec.count());
+            "RETRY_INTERVAL", retryInterval.count());
 
-        co_await sleep_for(_ctx, std::chrono::seconds(
-                                     cfg._retry->_retryIntervalInSec.count()));
+        co_await waitRetryInterval(retryInterval);
+
+        // The BMC role might have changed while waiting, and the sibling BMC
+        // owns the data then.
+        if (!isSyncEligible(cfg))
+        {
+            co_return true;
+        }
 
         // NOLINTNEXTLINE
-        co_return co_await syncData(cfg, std::move(srcPath), retryCount);
+        co_return co_await syncData(cfg, std::move(srcPath), retryCount,
+                                    correlationId);
     }
     co_return false;
 }
@@ -473,14 +781,45 @@ sdbusplus::async::task<bool>
 sdbusplus::async::task<bool>
     // NOLINTNEXTLINE
     Manager::syncData(const config::DataSyncConfig& dataSyncCfg,
-                      fs::path srcPath, size_t retryCount)
+                      fs::path srcPath, size_t retryCount,
+                      tracing::CorrelationId correlationId)
 {
-    // Don't sync if the sync is disabled
-    if (_syncBMCDataIface.disable_sync())
+    // The consistency group is synced as a whole by its first path
+    const auto group = getConsistencyGroup(dataSyncCfg);
+    if (!group.empty())
     {
+        if (group.front() != &dataSyncCfg)
+        {
+            // NOLINTNEXTLINE
+            co_return co_await syncData(*group.front(), {}, retryCount,
+                                        correlationId);
+        }
+        srcPath.clear();
+    }
+
+    // The BMC role might have changed since the change was received, and the
+    // sibling BMC owns the data then.
+    if (!isSyncEligible(dataSyncCfg))
+    {
+        co_return true;
+    }
+
+    // Don't sync if the sync is disabled or the sibling BMC is not available,
+    // but journal the change to sync once it is possible again.
+    if (_syncBMCDataIface.disable_sync() || isSiblingBmcNotAvailable())
+    {
+        _changeJournal.add(dataSyncCfg._path,
+                           srcPath.empty() ? dataSyncCfg._path : srcPath);
         co_return false;
     }
 
+    // The sync which is not originated from the inotify events. Eg: Full and
+    // Periodic sync.
+    if (correlationId == 0)
+    {
+        correlationId = tracing::SpanTracer::instance().newCorrelationId();
+    }
+
     using std::experimental::scope_exit;
     const fs::path currentSrcPath = srcPath.empty() ? dataSyncCfg._path
                                                     : srcPath;
@@ -497,6 +836,11 @@ sdbusplus::async::task<bool>
         {
             lg2::debug("Skipping sync for [{SRC}]: already in progress", "SRC",
                        currentSrcPath);
+            tracing::SpanTracer::instance().record(
+                {correlationId, tracing::Stage::CoalesceQueue,
+                 tracing::Clock::now(), tracing::Clock::duration::zero(),
+                 "Merged into the in-progress sync of " +
+                     currentSrcPath.string()});
             cleanup.release(); // nothing inserted, skip cleanup
             co_return true;
         }
@@ -508,6 +852,7 @@ sdbusplus::async::task<bool>
         cleanup.release();
     }
 
+    const auto syncStartTime = std::chrono::steady_clock::now();
     std::string syncCmd{};
     getRsyncCmd(RsyncMode::Sync, dataSyncCfg, srcPath.string(), syncCmd);
 
@@ -518,11 +863,41 @@ sdbusplus::async::task<bool>
 
     lg2::debug("Rsync command: {CMD}", "CMD", syncCmd);
 
+    if (!_circuitBreaker.allowRequest())
+    {
+        // Parked until the sibling BMC connection is restored
+        _changeJournal.add(dataSyncCfg._path, currentSrcPath);
+        co_return false;
+    }
+
     data_sync::async::AsyncCommandExecutor executor(_ctx);
-    // NOLINTNEXTLINE
-    auto result = co_await executor.execCmd(syncCmd);
+    utility::rsync::OutputParser outputParser;
+    const auto& transfer = outputParser.getStats();
+    std::pair<int, std::string> result;
+    {
+        tracing::ScopedSpan span(correlationId, tracing::Stage::RsyncExit,
+                                 currentSrcPath.string());
+        // NOLINTNEXTLINE
+        result = co_await executor.execCmd(
+            syncCmd, correlationId,
+            [&outputParser](std::string_view output) {
+            outputParser.feed(output);
+        });
+        outputParser.finish();
+        span.setDetail(currentSrcPath.string() +
+                       " ExitCode: " + std::to_string(result.first) +
+                       " Files: " + std::to_string(transfer.filesTransferred) +
+                       " Bytes: " + std::to_string(transfer.literalBytes));
+    }
     lg2::debug("Rsync cmd return code : {RET} : output : {OUTPUT}", "RET",
                result.first, "OUTPUT", result.second);
+    lg2::debug("Rsync transferred {FILES} files of {LITERAL} literal and "
+               "{MATCHED} matched bytes, and deleted {DELETED} paths for "
+               "[{SRC}]",
+               "FILES", transfer.filesTransferred, "LITERAL",
+               transfer.literalBytes, "MATCHED", transfer.matchedBytes,
+               "DELETED", transfer.deletions, "SRC", currentSrcPath);
+    recordSyncResult(result.first);
 
     ext_data::AdditionalData additionalDetails = {
         {"BMC_Role", _extDataIfaces->bmcRoleInStr()},
@@ -538,20 +913,26 @@ sdbusplus::async::task<bool>
     {
         case 0: // Success
         {
-            // Notify only if configured, we know the concrete path,
-            // and bytes > 0
-            if (dataSyncCfg._notifySibling &&
-                utility::rsync::getTransferredDataBytes(result.second) != 0)
+            clearPendingChanges(dataSyncCfg, currentSrcPath, syncStartTime);
+            _fingerprints.commit(currentSrcPath);
+            for (const auto* member : group | std::views::drop(1))
             {
-                // Rsync success alone doesn’t guarantee data got updated on the
-                // remote.
-                // Checking bytes transferred helps to confirm if any data
-                // mismatch was actually synced.
-                // initiate sibling notification
-                // NOLINTNEXTLINE
-                co_await triggerSiblingNotification(dataSyncCfg,
-                                                    currentSrcPath.string());
+                clearPendingChanges(*member, member->_path, syncStartTime);
+                _fingerprints.commit(member->_path);
+            }
+
+            // Rsync success alone doesn’t guarantee data got updated on the
+            // remote, hence notify only for the paths itemized as changed
+            // and configured to notify on.
+            std::vector<std::pair<const config::DataSyncConfig*, fs::path>>
+                syncedPaths{{&dataSyncCfg, currentSrcPath}};
+            for (const auto* member : group | std::views::drop(1))
+            {
+                syncedPaths.emplace_back(member, member->_path);
             }
+            // NOLINTNEXTLINE
+            co_await notifySiblingOfChanges(syncedPaths, transfer,
+                                            correlationId);
             co_return true;
         }
 
@@ -559,6 +940,11 @@ sdbusplus::async::task<bool>
         {
             // TODO: Revisit notification handling for vanished files if partial
             // data got synced
+            clearPendingChanges(dataSyncCfg, currentSrcPath, syncStartTime);
+            for (const auto* member : group | std::views::drop(1))
+            {
+                clearPendingChanges(*member, member->_path, syncStartTime);
+            }
             lg2::debug(
                 "Rsync exited with vanished file error for [{SRC}], treating as success",
                 "SRC", currentSrcPath);
@@ -584,9 +970,10 @@ sdbusplus::async::task<bool>
                 additionalDetails["DS_Sync_Msg"] =
                     "Permanent rsync failure occurred for the path";
 
-                co_await _extDataIfaces->createErrorLog(
-                    "xyz.openbmc_project.RBMC_DataSync.Error.SyncFailure",
-                    ext_data::ErrorLevel::Warning, additionalDetails);
+                _errorLogQueue.submit(
+                    {"xyz.openbmc_project.RBMC_DataSync.Error.SyncFailure",
+                     ext_data::ErrorLevel::Warning, additionalDetails,
+                     getSyncFailureFFDC(correlationId, result.second)});
                 co_return false;
             }
 
@@ -597,7 +984,7 @@ sdbusplus::async::task<bool>
 
             auto retrySuccess = co_await retrySync(
                 dataSyncCfg, srcPath.empty() ? fs::path{} : currentSrcPath,
-                retryCount);
+                retryCount, correlationId);
             if (dataSyncCfg._retry.has_value() && !retrySuccess &&
                 retryCount >= dataSyncCfg._retry->_maxRetryAttempts)
             {
@@ -615,13 +1002,18 @@ sdbusplus::async::task<bool>
                 // critical
                 setSyncEventsHealth(SyncEventsHealth::Critical);
 
+                // Journal the change to sync along with the other missed
+                // changes once the sibling BMC is reachable again.
+                _changeJournal.add(dataSyncCfg._path, currentSrcPath);
+
                 // Error log for exceeding maximum retries
                 additionalDetails["DS_Sync_Msg"] =
                     "Maximum retries exceeded, sync failed for the path";
 
-                co_await _extDataIfaces->createErrorLog(
-                    "xyz.openbmc_project.RBMC_DataSync.Error.SyncFailure",
-                    ext_data::ErrorLevel::Warning, additionalDetails);
+                _errorLogQueue.submit(
+                    {"xyz.openbmc_project.RBMC_DataSync.Error.SyncFailure",
+                     ext_data::ErrorLevel::Warning, additionalDetails,
+                     getSyncFailureFFDC(correlationId, result.second)});
             }
             co_return retrySuccess;
         }
@@ -689,13 +1081,13 @@ sdbusplus::async::task<>
 
         lg2::debug(
             "Notify Request[{NOTIFYPATH}] to sibling BMC failed, scheduling retry"
-            "[{RETRY}/{MAX}] after {INTERVAL}s",
+            "[{RETRY}/{MAX}] with the base interval {INTERVAL}s",
             "NOTIFYPATH", notifyPath, "RETRY", retryAttempts, "MAX",
             cfg._retry->_maxRetryAttempts, "INTERVAL",
             cfg._retry->_retryIntervalInSec.count());
 
-        co_await sleep_for(_ctx, std::chrono::seconds(
-                                     cfg._retry->_retryIntervalInSec.count()));
+        co_await waitRetryInterval(
+            retry::backoff(cfg._retry->_retryIntervalInSec, retryAttempts));
     }
 
     lg2::error("Failed to send notify request[{NOTIFYPATH}] to sibling BMC "
@@ -711,9 +1103,9 @@ sdbusplus::async::task<>
         {"DS_Notify_Path", notifyPath.string()},
         {"DS_Notify_ModifiedPath", modifiedPath.string()},
         {"DS_Notify_Msg", "Failed to send notify request for the path"}};
-    co_await _extDataIfaces->createErrorLog(
-        "xyz.openbmc_project.RBMC_DataSync.Error.NotifyFailure",
-        ext_data::ErrorLevel::Informational, additionalDetails);
+    _errorLogQueue.submit(
+        {"xyz.openbmc_project.RBMC_DataSync.Error.NotifyFailure",
+         ext_data::ErrorLevel::Informational, additionalDetails});
 
     co_return;
 }
@@ -722,37 +1114,81 @@ sdbusplus::async::task<>
     // NOLINTNEXTLINE
     Manager::monitorDataToSync(const config::DataSyncConfig& dataSyncCfg)
 {
+    using std::experimental::scope_exit;
+    dataSyncCfg._syncEventsRunning = true;
+    auto eventsStopped = scope_exit([&dataSyncCfg]() noexcept {
+        dataSyncCfg._syncEventsRunning = false;
+        dataSyncCfg._syncEventsStopRequested = false;
+    });
+
     bool exception{false};
     try
     {
-        uint32_t eventMasksToWatch = IN_CLOSE_WRITE | IN_MOVE | IN_DELETE_SELF;
-        if (dataSyncCfg._isPathDir)
+        if (PARENT_DIR_WATCH && canWatchParentDir(dataSyncCfg) &&
+            co_await monitorParentDir(dataSyncCfg))
+        {
+            co_return;
+        }
+
+        std::shared_ptr<watch::inotify::DataWatcher> dataWatcher =
+            createDataWatcher(dataSyncCfg);
+        _syncEventsWakeups.insert_or_assign(
+            dataSyncCfg._path,
+            [watcher = dataWatcher.get()]() { watcher->wakeUp(); });
+        auto wakeupDone = scope_exit([this, &dataSyncCfg]() noexcept {
+            _syncEventsWakeups.erase(dataSyncCfg._path);
+        });
+
+        if (constexpr std::string_view traceDir{INOTIFY_TRACE_DIR};
+            !traceDir.empty())
+        {
+            startEventRecording(*dataWatcher, dataSyncCfg, traceDir);
+        }
+
+        // The subtrees beyond the inotify watch budget are scanned instead,
+        // and the watcher might move the subtrees to the scan anytime later.
+        // The scan runs only while there is any such subtree.
+        auto startPolling = [this, &dataSyncCfg,
+                             watcher = std::weak_ptr(dataWatcher),
+                             polling = std::make_shared<bool>(false)]() {
+            if (!*polling)
+            {
+                *polling = true;
+                // NOLINTNEXTLINE
+                _ctx.spawn(monitorPolledSubtrees(dataSyncCfg, watcher,
+                                                 polling));
+            }
+        };
+        dataWatcher->setPollingStartedCallback(startPolling);
+        if (dataWatcher->hasPolledSubtrees())
         {
-            eventMasksToWatch |= IN_CREATE | IN_DELETE;
+            startPolling();
         }
 
-        auto excludeList =
-            dataSyncCfg._excludeList.has_value()
-                ? std::make_optional<std::unordered_set<fs::path>>(
-                      dataSyncCfg._excludeList.value().first)
-                : std::nullopt;
-        watch::inotify::DataWatcher dataWatcher(
-            _ctx, IN_NONBLOCK, eventMasksToWatch, dataSyncCfg._path,
-            excludeList, dataSyncCfg._includeList);
+        auto pending = std::make_shared<PendingOperations>(_ctx);
+        _pendingOperations.insert_or_assign(dataSyncCfg._path, pending);
+        auto pendingDone = scope_exit([this, &dataSyncCfg]() noexcept {
+            _pendingOperations.erase(dataSyncCfg._path);
+        });
 
-        while (!_ctx.stop_requested() && !_syncBMCDataIface.disable_sync())
+        // Keep watching even if the sync is disabled, the changes are
+        // journaled to sync once it is enabled.
+        while (!_ctx.stop_requested() && !dataSyncCfg._syncEventsStopRequested)
         {
             // NOLINTNEXTLINE
-            if (auto dataOperations = co_await dataWatcher.onDataChange();
-                !dataOperations.empty())
+            auto dataOperations = co_await dataWatcher->onDataChange();
+
+            // The stop might be requested while waiting for the events
+            if (dataSyncCfg._syncEventsStopRequested)
             {
-                for (const auto& [path, dataOp] : dataOperations)
-                {
-                    // NOLINTNEXTLINE
-                    _ctx.spawn(
-                        syncData(dataSyncCfg, path) |
-                        stdexec::then([]([[maybe_unused]] bool result) {}));
-                }
+                break;
+            }
+
+            if (!dataOperations.empty())
+            {
+                accumulateDataOperations(dataSyncCfg, pending, dataOperations,
+                                         dataWatcher->getCorrelationId(),
+                                         dataWatcher->getRenames());
             }
         }
     }
@@ -769,67 +1205,1539 @@ sdbusplus::async::task<>
             {"DS_Events_Path", dataSyncCfg._path.string()},
             {"DS_Events_Msg",
              "Exception: Failed to create inotify watcher for the configured path"}};
-        co_await _extDataIfaces->createErrorLog(
-            "xyz.openbmc_project.RBMC_DataSync.Error.SyncEventsFailure",
-            ext_data::ErrorLevel::Warning, additionalDetails);
+        _errorLogQueue.submit(
+            {"xyz.openbmc_project.RBMC_DataSync.Error.SyncEventsFailure",
+             ext_data::ErrorLevel::Warning, additionalDetails});
     }
     co_return;
 }
 
-sdbusplus::async::task<>
+bool Manager::canWatchParentDir(const config::DataSyncConfig& dataSyncCfg)
+{
+    std::error_code ec;
+    return !dataSyncCfg._isPathDir && !dataSyncCfg._includeList.has_value() &&
+           !dataSyncCfg._excludeList.has_value() &&
+           fs::is_directory(dataSyncCfg._path.parent_path(), ec);
+}
+
+sdbusplus::async::task<bool>
     // NOLINTNEXTLINE
-    Manager::monitorTimerToSync(const config::DataSyncConfig& dataSyncCfg)
+    Manager::monitorParentDir(const config::DataSyncConfig& dataSyncCfg)
 {
-    while (!_ctx.stop_requested() && !_syncBMCDataIface.disable_sync() &&
-           dataSyncCfg._periodicityInSec.has_value())
+    const auto dir = dataSyncCfg._path.parent_path();
+    auto parentDirWatch = _parentDirWatches.find(dir);
+    if (parentDirWatch == _parentDirWatches.end() ||
+        !parentDirWatch->second->isWatching())
     {
-        co_await sdbusplus::async::sleep_for(
-            _ctx, dataSyncCfg._periodicityInSec.value());
+        try
+        {
+            auto watch = std::make_unique<watch::inotify::ParentDirWatch>(_ctx,
+                                                                          dir);
+            parentDirWatch =
+                _parentDirWatches.insert_or_assign(dir, std::move(watch))
+                    .first;
+            // NOLINTNEXTLINE
+            _ctx.spawn(parentDirWatch->second->run());
+        }
+        catch (const std::exception& e)
+        {
+            lg2::warning("Failed to watch {DIR} for {PATH}, watching the file "
+                         "itself. Error : {ERROR}",
+                         "DIR", dir, "PATH", dataSyncCfg._path, "ERROR", e);
+            co_return false;
+        }
+    }
+
+    auto subscription = parentDirWatch->second->subscribe(dataSyncCfg._path);
+    _syncEventsWakeups.insert_or_assign(
+        dataSyncCfg._path,
+        [subscription = subscription.get()]() { subscription->wakeUp(); });
+    using std::experimental::scope_exit;
+    auto wakeupDone = scope_exit([this, &dataSyncCfg]() noexcept {
+        _syncEventsWakeups.erase(dataSyncCfg._path);
+    });
+    while (!_ctx.stop_requested() && !dataSyncCfg._syncEventsStopRequested)
+    {
+        // NOLINTNEXTLINE
+        auto dataOperations = co_await subscription->onDataChange();
+        if (!dataOperations.has_value())
+        {
+            co_return false;
+        }
+
+        // The stop might be requested while waiting for the events
+        if (dataSyncCfg._syncEventsStopRequested)
+        {
+            break;
+        }
+
         // NOLINTNEXTLINE
-        co_await syncData(dataSyncCfg);
+        co_await dispatchDataOperations(
+            dataSyncCfg, std::move(*dataOperations),
+            tracing::SpanTracer::instance().newCorrelationId());
     }
-    co_return;
+    co_return true;
 }
 
-void Manager::disableSyncPropChanged(bool disableSync)
+sdbusplus::async::task<>
+    // NOLINTNEXTLINE
+    Manager::monitorPolledSubtrees(
+        const config::DataSyncConfig& dataSyncCfg,
+        std::weak_ptr<watch::inotify::DataWatcher> dataWatcher,
+        std::shared_ptr<bool> polling)
 {
-    if (disableSync)
+    using std::experimental::scope_exit;
+    auto pollingDone = scope_exit([&polling]() noexcept { *polling = false; });
+
+    while (!_ctx.stop_requested())
     {
-        // TODO: Disable all sync events using Sender Receiver.
-        lg2::info("Sync is Disabled, Stopping events");
+        co_await sdbusplus::async::sleep_for(
+            _ctx, std::chrono::seconds(POLL_SCAN_INTERVAL));
+
+        auto watcher = dataWatcher.lock();
+        if (!watcher || dataSyncCfg._syncEventsStopRequested)
+        {
+            break;
+        }
+
+        auto correlationId = tracing::SpanTracer::instance().newCorrelationId();
+        if (auto dataOperations = watcher->pollSubtrees();
+            !dataOperations.empty())
+        {
+            // NOLINTNEXTLINE
+            co_await dispatchDataOperations(
+                dataSyncCfg, std::move(dataOperations), correlationId);
+        }
+
+        // Started again once a subtree is moved to the scan
+        if (!watcher->hasPolledSubtrees())
+        {
+            break;
+        }
     }
-    else
+    co_return;
+}
+
+std::unique_ptr<watch::inotify::DataWatcher>
+    Manager::createDataWatcher(const config::DataSyncConfig& dataSyncCfg)
+{
+    uint32_t eventMasksToWatch = IN_CLOSE_WRITE | IN_MOVE | IN_DELETE_SELF;
+    if (dataSyncCfg._isPathDir)
     {
-        lg2::info("Sync is Enabled, Starting events");
-        _ctx.spawn(startSyncEvents());
+        eventMasksToWatch |= IN_CREATE | IN_DELETE;
     }
+
+    auto excludeList =
+        dataSyncCfg._excludeList.has_value()
+            ? std::make_optional<std::unordered_set<fs::path>>(
+                  dataSyncCfg._excludeList.value().first)
+            : std::nullopt;
+    return std::make_unique<watch::inotify::DataWatcher>(
+        _ctx, IN_NONBLOCK, eventMasksToWatch, dataSyncCfg._path, excludeList,
+        dataSyncCfg._includeList);
 }
 
-void Manager::setFullSyncStatus(const FullSyncStatus& fullSyncStatus)
+void Manager::accumulateDataOperations(
+    const config::DataSyncConfig& dataSyncCfg,
+    const std::shared_ptr<PendingOperations>& pending,
+    const watch::inotify::DataOperations& dataOperations,
+    tracing::CorrelationId correlationId,
+    const watch::inotify::Renames& renames)
 {
-    if (_syncBMCDataIface.full_sync_status() == fullSyncStatus)
+    if constexpr (COLLAPSE_WINDOW == 0)
     {
+        // NOLINTNEXTLINE
+        _ctx.spawn(dispatchDataOperations(dataSyncCfg, dataOperations,
+                                          correlationId, renames));
         return;
     }
-    _syncBMCDataIface.full_sync_status(fullSyncStatus);
 
-    // Don't persist InProgress status as it's a transient state
-    if (fullSyncStatus == FullSyncStatus::FullSyncInProgress)
+    const auto changeTime = std::chrono::steady_clock::now();
+    if (pending->dataOperations.empty())
+    {
+        pending->correlationId = correlationId;
+        pending->changeTime = changeTime;
+    }
+
+    // Pending already while in the window, so that the replication lag and a
+    // flush account for them.
+    for (const auto& [path, dataOp] : dataOperations)
+    {
+        markPendingChange(dataSyncCfg, path, changeTime);
+    }
+    for (const auto& [to, from] : renames)
+    {
+        markPendingChange(dataSyncCfg, from, changeTime);
+    }
+
+    // The latest operation of a path supersedes its earlier one
+    std::set<fs::path> changedPaths;
+    std::ranges::transform(dataOperations,
+                           std::inserter(changedPaths, changedPaths.end()),
+                           [](const auto& dataOp) { return dataOp.first; });
+    std::erase_if(pending->dataOperations,
+                  [&changedPaths](const auto& dataOp) {
+        return changedPaths.contains(dataOp.first);
+    });
+    std::ranges::copy(dataOperations,
+                      std::back_inserter(pending->dataOperations));
+    for (const auto& [to, from] : renames)
+    {
+        pending->renames.insert_or_assign(to, from);
+    }
+
+    if (!pending->dispatchScheduled)
+    {
+        pending->dispatchScheduled = true;
+        // NOLINTNEXTLINE
+        _ctx.spawn(dispatchPendingOperations(dataSyncCfg, pending));
+    }
+}
+
+sdbusplus::async::task<>
+    // NOLINTNEXTLINE
+    Manager::dispatchPendingOperations(
+        const config::DataSyncConfig& dataSyncCfg,
+        std::shared_ptr<PendingOperations> pending)
+{
+    using std::experimental::scope_exit;
+    auto dispatchDone = scope_exit([&pending]() noexcept {
+        pending->dispatchScheduled = false;
+    });
+
+    // The windows are dispatched one after another, so that the syncs of a
+    // later window aren't dispatched ahead of an earlier one.
+    while (!pending->dataOperations.empty())
+    {
+        // NOLINTNEXTLINE
+        co_await pending->windowEnd.waitUntil(
+            std::chrono::steady_clock::now() +
+            std::chrono::milliseconds(COLLAPSE_WINDOW));
+        if (_ctx.stop_requested())
+        {
+            break;
+        }
+
+        // The BMC role might have changed while waiting, and the sibling BMC
+        // owns the data then.
+        if (!isSyncEligible(dataSyncCfg))
+        {
+            pending->dataOperations.clear();
+            pending->renames.clear();
+            break;
+        }
+
+        auto dataOperations = std::exchange(pending->dataOperations, {});
+        auto renames = std::exchange(pending->renames, {});
+        // NOLINTNEXTLINE
+        co_await dispatchDataOperations(dataSyncCfg, std::move(dataOperations),
+                                        pending->correlationId,
+                                        std::move(renames),
+                                        pending->changeTime);
+    }
+    co_return;
+}
+
+sdbusplus::async::task<std::map<fs::path, fingerprint::TimedFingerprint>>
+    // NOLINTNEXTLINE
+    Manager::fingerprintWrites(
+        const config::DataSyncConfig& dataSyncCfg,
+        const watch::inotify::DataOperations& dataOperations)
+{
+    // The rewrites of a file with the same content are dropped. Not for the
+    // bidirectional sync, as the sibling might have changed its copy.
+    std::vector<fs::path> writtenFiles;
+    if (dataSyncCfg._syncDirection != config::SyncDirection::Bidirectional)
+    {
+        for (const auto& [path, dataOp] : dataOperations)
+        {
+            if (dataOp == watch::inotify::DataOps::COPY && path.has_filename())
+            {
+                writtenFiles.emplace_back(path);
+            }
+        }
+    }
+    if (writtenFiles.empty())
+    {
+        co_return std::map<fs::path, fingerprint::TimedFingerprint>{};
+    }
+
+    // Hashing a large file takes long, hence off the event loop
+    co_return co_await worker::WorkerPool::instance().run(
+        _ctx, [writtenFiles = std::move(writtenFiles)]() {
+        std::map<fs::path, fingerprint::TimedFingerprint> fingerprints;
+        for (const auto& file : writtenFiles)
+        {
+            fingerprints.emplace(file, fingerprint::getTimedFingerprint(file));
+        }
+        return fingerprints;
+    });
+}
+
+sdbusplus::async::task<>
+    // NOLINTNEXTLINE
+    Manager::dispatchDataOperations(
+        const config::DataSyncConfig& dataSyncCfg,
+        watch::inotify::DataOperations dataOperations,
+        tracing::CorrelationId correlationId, watch::inotify::Renames renames,
+        std::chrono::steady_clock::time_point changeTime)
+{
+    // The bulk rewrites are synced per directory instead of per file, but
+    // only the directories which are wholly included.
+    auto canSyncDir = [&dataSyncCfg](const fs::path& dir) {
+        return !dataSyncCfg._includeList.has_value() ||
+               std::ranges::any_of(dataSyncCfg._includeList.value(),
+                                   [&dir](const fs::path& includePath) {
+            return utility::isSameOrChildOf(dir, includePath);
+        });
+    };
+    const auto localOperations = suppressEchoes(dataSyncCfg, dataOperations,
+                                                renames);
+    if (localOperations.size() != dataOperations.size())
+    {
+        // The echoes marked pending in the collapse window aren't synced
+        const std::set<watch::inotify::DataOperation> localOps(
+            localOperations.begin(), localOperations.end());
+        for (const auto& dataOperation : dataOperations)
+        {
+            if (localOps.contains(dataOperation))
+            {
+                continue;
+            }
+            unmarkPendingChange(dataSyncCfg, dataOperation.first, changeTime);
+            if (auto renamedFrom = renames.find(dataOperation.first);
+                renamedFrom != renames.end())
+            {
+                unmarkPendingChange(dataSyncCfg, renamedFrom->second,
+                                    changeTime);
+            }
+        }
+    }
+    const auto collapsedOperations = watch::inotify::collapseBursts(
+        localOperations, dataSyncCfg._path,
+        {COLLAPSE_THRESHOLD, COLLAPSE_PERCENT}, canSyncDir);
+
+    // NOLINTNEXTLINE
+    const auto fingerprints = co_await fingerprintWrites(dataSyncCfg,
+                                                         collapsedOperations);
+
+    for (const auto& [path, dataOp] : collapsedOperations)
+    {
+        auto renamedFrom = renames.find(path);
+        const bool isRename = (dataOp == watch::inotify::DataOps::RENAME) &&
+                              (renamedFrom != renames.end());
+
+        if (auto fingerprint = fingerprints.find(path);
+            fingerprint != fingerprints.end() &&
+            _fingerprints.isUnchanged(path, fingerprint->second))
+        {
+            lg2::debug("Skipping the sync of {PATH} as its content is "
+                       "unchanged",
+                       "PATH", path);
+            unmarkPendingChange(dataSyncCfg, path, changeTime);
+            continue;
+        }
+        if (dataOp != watch::inotify::DataOps::COPY)
+        {
+            _fingerprints.forget(path);
+            if (isRename)
+            {
+                _fingerprints.forget(renamedFrom->second);
+            }
+        }
+
+        markPendingChange(dataSyncCfg, path, changeTime);
+        if (isRename)
+        {
+            markPendingChange(dataSyncCfg, renamedFrom->second, changeTime);
+        }
+
+        if (_syncBMCDataIface.disable_sync())
+        {
+            // Paused, hence just journal the change
+            _changeJournal.add(dataSyncCfg._path, path);
+            if (isRename)
+            {
+                _changeJournal.add(dataSyncCfg._path, renamedFrom->second);
+            }
+            continue;
+        }
+
+        tracing::ScopedSpan span(correlationId, tracing::Stage::Dispatch,
+                                 path.string());
+        if (dataSyncCfg._consistencyGroup.has_value())
+        {
+            // Merged into the group sync waiting for its changes to settle
+            if (_settlingGroups.emplace(dataSyncCfg._consistencyGroup.value())
+                    .second)
+            {
+                // NOLINTNEXTLINE
+                _ctx.spawn(syncConsistencyGroup(dataSyncCfg, correlationId) |
+                           stdexec::then([]([[maybe_unused]] bool result) {}));
+            }
+            continue;
+        }
+        if (isRename)
+        {
+            // Ordered along with the syncs of both the old and the new path
+            auto [fromEnd, _] = std::ranges::mismatch(renamedFrom->second,
+                                                      path);
+            fs::path commonParent;
+            for (const auto& part :
+                 std::ranges::subrange(renamedFrom->second.begin(), fromEnd))
+            {
+                commonParent /= part;
+            }
+            // NOLINTNEXTLINE
+            _ctx.spawn(_syncOrder.run(_ctx, commonParent,
+                                      [this, &dataSyncCfg,
+                                       from = renamedFrom->second, to = path,
+                                       correlationId]() {
+                return syncRename(dataSyncCfg, from, to, correlationId);
+            }) | stdexec::then([]([[maybe_unused]] bool result) {}));
+            continue;
+        }
+        // The syncs of the overlapping paths run in the order of the events,
+        // Eg: a delete and re-create of the same path.
+        // NOLINTNEXTLINE
+        _ctx.spawn(_syncOrder.run(_ctx, path,
+                                  [this, &dataSyncCfg, path, correlationId]() {
+            return syncData(dataSyncCfg, path, 0, correlationId);
+        }) | stdexec::then([]([[maybe_unused]] bool result) {}));
+    }
+    co_return;
+}
+
+sdbusplus::async::task<bool>
+    // NOLINTNEXTLINE
+    Manager::syncConsistencyGroup(const config::DataSyncConfig& dataSyncCfg,
+                                  tracing::CorrelationId correlationId)
+{
+    // The paths of a group are usually written back to back, Eg: a data file
+    // and then its checksum.
+    constexpr auto settleTime = std::chrono::milliseconds(GROUP_SETTLE_TIME);
+    co_await sdbusplus::async::sleep_for(_ctx, settleTime);
+    _settlingGroups.erase(dataSyncCfg._consistencyGroup.value_or(""));
+
+    // Ordered along with the syncs of all the paths of the group
+    const auto group = getConsistencyGroup(dataSyncCfg);
+    fs::path commonParent;
+    for (const auto* member : group)
+    {
+        const auto memberPath = member->_path.has_filename()
+                                    ? member->_path
+                                    : member->_path.parent_path();
+        if (commonParent.empty())
+        {
+            commonParent = memberPath;
+            continue;
+        }
+        auto [parentEnd, _] = std::ranges::mismatch(commonParent, memberPath);
+        fs::path parent;
+        for (const auto& part :
+             std::ranges::subrange(commonParent.begin(), parentEnd))
+        {
+            parent /= part;
+        }
+        commonParent = std::move(parent);
+    }
+
+    // NOLINTNEXTLINE
+    co_return co_await _syncOrder.run(_ctx, commonParent,
+                                      [this, &dataSyncCfg, correlationId]() {
+        return syncData(dataSyncCfg, {}, 0, correlationId);
+    });
+}
+
+watch::inotify::DataOperations Manager::suppressEchoes(
+    const config::DataSyncConfig& dataSyncCfg,
+    const watch::inotify::DataOperations& dataOperations,
+    const watch::inotify::Renames& renames)
+{
+    using enum config::SyncDirection;
+    using enum watch::inotify::DataOps;
+
+    if (dataSyncCfg._syncDirection != Bidirectional)
+    {
+        return dataOperations;
+    }
+
+    drainAppliedChanges();
+
+    watch::inotify::DataOperations localOperations;
+    std::ranges::copy_if(
+        dataOperations, std::back_inserter(localOperations),
+        [this, &renames](const auto& dataOperation) {
+        const auto& [path, dataOp] = dataOperation;
+        if (dataOp == RENAME)
+        {
+            auto renamedFrom = renames.find(path);
+            return renamedFrom == renames.end() ||
+                   !_echoSuppressor.isEcho(path, COPY) ||
+                   !_echoSuppressor.isEcho(renamedFrom->second, DELETE);
+        }
+        return !_echoSuppressor.isEcho(path, dataOp);
+    });
+    return localOperations;
+}
+
+void Manager::drainAppliedChanges()
+{
+    // Only the changes under the Bidirectional configurations can echo
+    _echoSuppressor.drain([this](const fs::path& path) {
+        return std::ranges::any_of(_dataSyncConfiguration,
+                                   [&path](const auto& cfg) {
+            return cfg._syncDirection == config::SyncDirection::Bidirectional &&
+                   utility::isSameOrChildOf(path, cfg._path);
+        });
+    });
+}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<> Manager::monitorAppliedChanges()
+{
+    const fs::path appliedLog{APPLIED_CHANGES_LOG};
+    if (appliedLog.empty())
+    {
+        co_return;
+    }
+
+    utility::FD inotifyFd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC));
+    if (inotifyFd() == -1)
+    {
+        lg2::error("Failed to watch the applied changes log, error: {ERROR}",
+                   "ERROR", strerror(errno));
+        co_return;
+    }
+
+    // Wakes up periodically to watch the log once the rsync daemon creates
+    // it, and to end on the stop.
+    constexpr auto watchRetryInterval = std::chrono::seconds(1);
+    sdbusplus::async::fdio fdioInstance(_ctx, inotifyFd(), watchRetryInterval);
+    bool watching{false};
+    while (!_ctx.stop_requested())
+    {
+        if (!watching)
+        {
+            watching = inotify_add_watch(inotifyFd(), appliedLog.c_str(),
+                                         IN_MODIFY | IN_DELETE_SELF |
+                                             IN_MOVE_SELF) != -1;
+            if (watching)
+            {
+                drainAppliedChanges();
+            }
+        }
+
+        try
+        {
+            // NOLINTNEXTLINE
+            co_await fdioInstance.next();
+        }
+        catch (const sdbusplus::exception::FdioTimeoutError&)
+        {
+            continue;
+        }
+
+        std::array<uint8_t, 4096> buffer{};
+        ssize_t bytes{0};
+        while ((bytes = read(inotifyFd(), buffer.data(), buffer.size())) > 0)
+        {
+            for (const auto& [wd, name, mask, cookie] :
+                 watch::inotify::parseEvents(
+                     {buffer.data(), static_cast<size_t>(bytes)}))
+            {
+                if ((mask & (IN_DELETE_SELF | IN_MOVE_SELF)) != 0U)
+                {
+                    // Replaced, hence watch the new log once created
+                    inotify_rm_watch(inotifyFd(), wd);
+                    watching = false;
+                }
+            }
+        }
+        drainAppliedChanges();
+    }
+    co_return;
+}
+
+sdbusplus::async::task<bool>
+    // NOLINTNEXTLINE
+    Manager::syncRename(const config::DataSyncConfig& dataSyncCfg,
+                        fs::path from, fs::path to,
+                        tracing::CorrelationId correlationId)
+{
+    // The separate syncs take care of journaling, parking and retrying
+    if (!_syncBMCDataIface.disable_sync() && !isSiblingBmcNotAvailable() &&
+        !_circuitBreaker.isOpen())
+    {
+        const auto syncStartTime = std::chrono::steady_clock::now();
+        std::string syncCmd{};
+        getRsyncCmd(RsyncMode::Rename, dataSyncCfg,
+                    from.string() + " " + to.string(), syncCmd);
+        lg2::debug("Rsync command: {CMD}", "CMD", syncCmd);
+
+        data_sync::async::AsyncCommandExecutor executor(_ctx);
+        utility::rsync::OutputParser outputParser;
+        std::pair<int, std::string> result;
+        {
+            tracing::ScopedSpan span(correlationId, tracing::Stage::RsyncExit,
+                                     from.string() + " -> " + to.string());
+            // NOLINTNEXTLINE
+            result = co_await executor.execCmd(
+                syncCmd, correlationId,
+                [&outputParser](std::string_view output) {
+                outputParser.feed(output);
+            });
+            outputParser.finish();
+            span.setDetail(from.string() + " -> " + to.string() +
+                           " ExitCode: " + std::to_string(result.first));
+        }
+        recordSyncResult(result.first);
+
+        if (result.first == 0 || result.first == 24)
+        {
+            const auto& transfer = outputParser.getStats();
+            lg2::debug("Synced the rename of [{FROM}] to [{TO}], transferred "
+                       "{BYTES} bytes",
+                       "FROM", from, "TO", to, "BYTES", transfer.literalBytes);
+            _renameTransfers.filesTransferred += transfer.filesTransferred;
+            _renameTransfers.literalBytes += transfer.literalBytes;
+            _renameTransfers.matchedBytes += transfer.matchedBytes;
+            _renameTransfers.deletions += transfer.deletions;
+            clearPendingChanges(dataSyncCfg, from, syncStartTime);
+            clearPendingChanges(dataSyncCfg, to, syncStartTime);
+            // The sibling data is changed even if nothing is transferred
+            if (dataSyncCfg._notifySibling)
+            {
+                std::vector<fs::path> notifyPaths;
+                for (const auto& path : {to, from})
+                {
+                    if (dataSyncCfg._notifySibling->needsNotification(path))
+                    {
+                        notifyPaths.emplace_back(path);
+                    }
+                }
+                if (!notifyPaths.empty())
+                {
+                    // NOLINTNEXTLINE
+                    co_await triggerSiblingNotification(
+                        dataSyncCfg, notifyPaths, correlationId);
+                }
+            }
+            co_return true;
+        }
+
+        lg2::debug("Failed to sync the rename of [{FROM}] to [{TO}], ErrCode: "
+                   "{ERRCODE}, syncing them separately",
+                   "FROM", from, "TO", to, "ERRCODE", result.first);
+    }
+
+    // NOLINTNEXTLINE
+    const bool deleted = co_await syncData(dataSyncCfg, from, 0,
+                                           correlationId);
+    // NOLINTNEXTLINE
+    const bool copied = co_await syncData(dataSyncCfg, to, 0, correlationId);
+    co_return deleted && copied;
+}
+
+void Manager::startEventRecording(watch::inotify::DataWatcher& dataWatcher,
+                                  const config::DataSyncConfig& dataSyncCfg,
+                                  const fs::path& traceDir)
+{
+    // One trace per configured path, named after the path itself.
+    // Eg: /var/lib/phosphor-data-sync/ => _var_lib_phosphor-data-sync_.trace
+    std::string traceName = dataSyncCfg._path.string();
+    std::ranges::replace(traceName, '/', '_');
+
+    try
+    {
+        fs::create_directories(traceDir);
+        dataWatcher.startRecording(traceDir / (traceName + ".trace"));
+    }
+    catch (const std::exception& e)
+    {
+        // Recording is a debug aid, so don't fail the sync events.
+        lg2::error("Failed to start recording the inotify events for "
+                   "[{PATH}], Error : {ERROR}",
+                   "PATH", dataSyncCfg._path, "ERROR", e);
+    }
+}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<> Manager::replayEventTrace(const fs::path& traceFile,
+                                                   double speedFactor)
+{
+    bool exception{false};
+    try
+    {
+        watch::trace::EventReplayer replayer(_ctx, traceFile, speedFactor);
+
+        auto cfg = std::ranges::find_if(
+            _dataSyncConfiguration, [&replayer](const auto& dataSyncCfg) {
+            return dataSyncCfg._path == replayer.getConfiguredPath();
+        });
+        if (cfg == _dataSyncConfiguration.end())
+        {
+            lg2::error("The traced path [{PATH}] is not configured for sync, "
+                       "skipping the replay of [{TRACE}]",
+                       "PATH", replayer.getConfiguredPath(), "TRACE",
+                       traceFile);
+            co_return;
+        }
+
+        lg2::info("Replaying the inotify events of [{PATH}] from [{TRACE}]",
+                  "PATH", cfg->_path, "TRACE", traceFile);
+
+        const auto& dataSyncCfg = *cfg;
+        auto dataWatcher = createDataWatcher(dataSyncCfg);
+        co_await replayer.replay(
+            *dataWatcher,
+            [this, &dataSyncCfg, &dataWatcher](
+                const watch::inotify::DataOperations& dataOperations) {
+            // NOLINTNEXTLINE
+            _ctx.spawn(dispatchDataOperations(dataSyncCfg, dataOperations,
+                                              dataWatcher->getCorrelationId()));
+        });
+    }
+    catch (const std::exception& e)
+    {
+        lg2::error("Failed to replay the inotify trace [{TRACE}], Error : "
+                   "{ERROR}",
+                   "TRACE", traceFile, "ERROR", e);
+        exception = true;
+    }
+    if (exception)
+    {
+        ext_data::AdditionalData additionalDetails = {
+            {"DS_Events_Path", traceFile.string()},
+            {"DS_Events_Msg", "Exception: Failed to replay the inotify trace"}};
+        _errorLogQueue.submit(
+            {"xyz.openbmc_project.RBMC_DataSync.Error.SyncEventsFailure",
+             ext_data::ErrorLevel::Informational, additionalDetails});
+    }
+    co_return;
+}
+
+void Manager::schedulePeriodicSync(const config::DataSyncConfig& dataSyncCfg)
+{
+    if (!dataSyncCfg._periodicityInSec.has_value())
+    {
+        return;
+    }
+    dataSyncCfg._syncEventsRunning = true;
+
+    // The changes are not watched for the periodic sync, hence consider the
+    // data as changed since the start.
+    const auto now = std::chrono::steady_clock::now();
+    markPendingChange(dataSyncCfg, dataSyncCfg._path, now);
+    dataSyncCfg._periodicDirty = true;
+    _changeProbes.insert_or_assign(dataSyncCfg._path,
+                                   std::make_shared<ChangeProbes>());
+
+    _timerWheel.add(dataSyncCfg._path, dataSyncCfg._periodicityInSec.value(),
+                    now);
+
+    // The running wheel sleeps until its earliest due time, hence a new
+    // runner takes over if this one is due earlier.
+    const auto nextDue = _timerWheel.getNextDue();
+    if (!_timerWheelWakeup.has_value() || nextDue < _timerWheelWakeup)
+    {
+        _timerWheelWakeup = nextDue;
+        _ctx.spawn(runTimerWheel(++_timerWheelGeneration));
+    }
+}
+
+void Manager::unschedulePeriodicSync(const config::DataSyncConfig& dataSyncCfg)
+{
+    _timerWheel.remove(dataSyncCfg._path);
+    _changeProbes.erase(dataSyncCfg._path);
+    dataSyncCfg._syncEventsRunning = false;
+    dataSyncCfg._syncEventsStopRequested = false;
+}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<> Manager::runTimerWheel(size_t generation)
+{
+    // Keep the timer armed even if the sync is disabled, the sync journals
+    // the configured path to sync once it is enabled.
+    while (!_ctx.stop_requested() && generation == _timerWheelGeneration)
+    {
+        const auto nextDue = _timerWheel.getNextDue();
+        if (!nextDue.has_value())
+        {
+            break;
+        }
+        _timerWheelWakeup = nextDue;
+
+        const auto now = std::chrono::steady_clock::now();
+        if (nextDue.value() > now)
+        {
+            co_await sdbusplus::async::sleep_for(
+                _ctx, std::chrono::duration_cast<std::chrono::milliseconds>(
+                          nextDue.value() - now));
+        }
+
+        // Superseded by a runner waking up earlier while sleeping
+        if (generation != _timerWheelGeneration)
+        {
+            co_return;
+        }
+
+        std::vector<const config::DataSyncConfig*> batch;
+        for (const auto& path :
+             _timerWheel.popDue(std::chrono::steady_clock::now()))
+        {
+            auto dataSyncCfg = std::ranges::find(
+                _dataSyncConfiguration, path, &config::DataSyncConfig::_path);
+            if (dataSyncCfg == _dataSyncConfiguration.end())
+            {
+                _timerWheel.remove(path);
+                continue;
+            }
+
+            // The stop might be requested while sleeping
+            if (dataSyncCfg->_syncEventsStopRequested)
+            {
+                unschedulePeriodicSync(*dataSyncCfg);
+                continue;
+            }
+            batch.emplace_back(&(*dataSyncCfg));
+        }
+
+        if (!batch.empty())
+        {
+            _ctx.spawn(syncPeriodicBatch(std::move(batch)));
+        }
+    }
+
+    if (generation == _timerWheelGeneration)
+    {
+        _timerWheelWakeup.reset();
+    }
+    co_return;
+}
+
+sdbusplus::async::task<>
+    // NOLINTNEXTLINE
+    Manager::syncPeriodicBatch(
+        std::vector<const config::DataSyncConfig*> batch)
+{
+    // The interval due while the previous one is still syncing is skipped,
+    // the changes are found by the next probe.
+    std::erase_if(batch, [this](const auto* dataSyncCfg) {
+        return _periodicSyncsInProgress.contains(dataSyncCfg->_path) ||
+               !_changeProbes.contains(dataSyncCfg->_path);
+    });
+
+    std::vector<std::pair<const config::DataSyncConfig*,
+                          std::shared_ptr<ChangeProbes>>>
+        probes;
+    for (const auto* dataSyncCfg : batch)
+    {
+        _periodicSyncsInProgress.emplace(dataSyncCfg->_path);
+        probes.emplace_back(dataSyncCfg, _changeProbes.at(dataSyncCfg->_path));
+    }
+
+    // The paths handed over to a sync of their own are released by it
+    using std::experimental::scope_exit;
+    auto releaseBatch = scope_exit([this, &batch]() noexcept {
+        for (const auto* dataSyncCfg : batch)
+        {
+            _periodicSyncsInProgress.erase(dataSyncCfg->_path);
+        }
+    });
+
+    // Probe on every interval to keep the baseline current, even if the
+    // data is already known to be dirty. The first probe takes the baseline.
+    const auto probeTime = std::chrono::steady_clock::now();
+    // NOLINTNEXTLINE
+    const auto changedCfgs = co_await worker::WorkerPool::instance().run(
+        _ctx, [probes]() {
+        std::set<const config::DataSyncConfig*> changedCfgs;
+        for (const auto& [dataSyncCfg, changeProbes] : probes)
+        {
+            bool changed{changeProbes->empty()};
+            if (changed)
+            {
+                *changeProbes = createChangeProbes(*dataSyncCfg);
+            }
+            for (auto& probe : *changeProbes)
+            {
+                changed = !probe->scan().empty() || changed;
+            }
+            if (changed)
+            {
+                changedCfgs.emplace(dataSyncCfg);
+            }
+        }
+        return changedCfgs;
+    });
+
+    // The configs sharing the destination are synced in a single rsync
+    std::map<fs::path, std::vector<const config::DataSyncConfig*>> transfers;
+    std::vector<const config::DataSyncConfig*> separateCfgs;
+    for (const auto* dataSyncCfg : batch)
+    {
+        if (!changedCfgs.contains(dataSyncCfg) && !dataSyncCfg->_periodicDirty)
+        {
+            // The data is as synced, the pending change is only carried to
+            // bound the replication lag by the interval.
+            lg2::debug("Skipping the periodic sync of [{PATH}], no changes "
+                       "since the last interval",
+                       "PATH", dataSyncCfg->_path);
+            clearPendingChanges(*dataSyncCfg, dataSyncCfg->_path, probeTime);
+            continue;
+        }
+
+        // The changes made during the sync are found by the next probe
+        dataSyncCfg->_periodicDirty = false;
+        if (canShareTransfer(*dataSyncCfg))
+        {
+            transfers[dataSyncCfg->_destPath.value_or(fs::path{})]
+                .emplace_back(dataSyncCfg);
+        }
+        else
+        {
+            separateCfgs.emplace_back(dataSyncCfg);
+        }
+    }
+
+    for (const auto& [destPath, dataSyncCfgs] : transfers)
+    {
+        // NOLINTNEXTLINE
+        if (dataSyncCfgs.size() > 1 && co_await syncTogether(dataSyncCfgs))
+        {
+            continue;
+        }
+        separateCfgs.insert(separateCfgs.end(), dataSyncCfgs.begin(),
+                            dataSyncCfgs.end());
+    }
+
+    for (const auto* dataSyncCfg : separateCfgs)
+    {
+        std::erase(batch, dataSyncCfg);
+        _ctx.spawn(syncPeriodic(*dataSyncCfg));
+    }
+    co_return;
+}
+
+sdbusplus::async::task<>
+    // NOLINTNEXTLINE
+    Manager::syncPeriodic(const config::DataSyncConfig& dataSyncCfg)
+{
+    using std::experimental::scope_exit;
+    auto release = scope_exit([this, &dataSyncCfg]() noexcept {
+        _periodicSyncsInProgress.erase(dataSyncCfg._path);
+    });
+
+    // NOLINTNEXTLINE
+    if (!co_await syncData(dataSyncCfg))
+    {
+        dataSyncCfg._periodicDirty = true;
+    }
+    co_return;
+}
+
+bool Manager::canShareTransfer(const config::DataSyncConfig& dataSyncCfg)
+{
+    return !dataSyncCfg._excludeList.has_value() &&
+           !dataSyncCfg._includeList.has_value() &&
+           !dataSyncCfg._consistencyGroup.has_value();
+}
+
+sdbusplus::async::task<bool>
+    // NOLINTNEXTLINE
+    Manager::syncTogether(
+        const std::vector<const config::DataSyncConfig*>& dataSyncCfgs)
+{
+    // The separate syncs take care of journaling, parking and retrying
+    if (_syncBMCDataIface.disable_sync() || isSiblingBmcNotAvailable() ||
+        _circuitBreaker.isOpen() ||
+        std::ranges::any_of(dataSyncCfgs, [](const auto* dataSyncCfg) {
+        return dataSyncCfg->_syncInProgressPaths.contains(dataSyncCfg->_path);
+    }))
+    {
+        co_return false;
+    }
+
+    std::string srcPaths;
+    for (const auto* dataSyncCfg : dataSyncCfgs)
+    {
+        srcPaths.append((srcPaths.empty() ? "" : " ") +
+                        dataSyncCfg->_path.string());
+        dataSyncCfg->_syncInProgressPaths.emplace(dataSyncCfg->_path);
+    }
+    using std::experimental::scope_exit;
+    auto cleanup = scope_exit([&dataSyncCfgs]() noexcept {
+        for (const auto* dataSyncCfg : dataSyncCfgs)
+        {
+            dataSyncCfg->_syncInProgressPaths.erase(dataSyncCfg->_path);
+        }
+    });
+
+    const auto syncStartTime = std::chrono::steady_clock::now();
+    const auto correlationId =
+        tracing::SpanTracer::instance().newCorrelationId();
+    std::string syncCmd{};
+    getRsyncCmd(RsyncMode::Sync, *dataSyncCfgs.front(), srcPaths, syncCmd);
+    lg2::debug("Rsync command: {CMD}", "CMD", syncCmd);
+
+    data_sync::async::AsyncCommandExecutor executor(_ctx);
+    utility::rsync::OutputParser outputParser;
+    const auto& transfer = outputParser.getStats();
+    std::pair<int, std::string> result;
+    {
+        tracing::ScopedSpan span(correlationId, tracing::Stage::RsyncExit,
+                                 srcPaths);
+        // NOLINTNEXTLINE
+        result = co_await executor.execCmd(
+            syncCmd, correlationId,
+            [&outputParser](std::string_view output) {
+            outputParser.feed(output);
+        });
+        outputParser.finish();
+        span.setDetail(srcPaths + " ExitCode: " + std::to_string(result.first) +
+                       " Files: " + std::to_string(transfer.filesTransferred) +
+                       " Bytes: " + std::to_string(transfer.literalBytes));
+    }
+    recordSyncResult(result.first);
+
+    if (result.first != 0 && result.first != 24)
+    {
+        lg2::debug("Failed to sync the periodic paths [{SRC}] together, "
+                   "ErrCode: {ERRCODE}, syncing them separately",
+                   "SRC", srcPaths, "ERRCODE", result.first);
+        co_return false;
+    }
+
+    lg2::debug("Synced the periodic paths [{SRC}] together, transferred "
+               "{FILES} files of {BYTES} bytes",
+               "SRC", srcPaths, "FILES", transfer.filesTransferred, "BYTES",
+               transfer.literalBytes);
+    std::vector<std::pair<const config::DataSyncConfig*, fs::path>>
+        syncedPaths;
+    for (const auto* dataSyncCfg : dataSyncCfgs)
+    {
+        clearPendingChanges(*dataSyncCfg, dataSyncCfg->_path, syncStartTime);
+        _fingerprints.commit(dataSyncCfg->_path);
+        syncedPaths.emplace_back(dataSyncCfg, dataSyncCfg->_path);
+    }
+    // NOLINTNEXTLINE
+    co_await notifySiblingOfChanges(syncedPaths, transfer, correlationId);
+    co_return true;
+}
+
+Manager::ChangeProbes
+    Manager::createChangeProbes(const config::DataSyncConfig& dataSyncCfg)
+{
+    // Only the included paths are probed, as the rest of the configured path
+    // may change frequently without being synced. Eg: /var/log/
+    std::vector<fs::path> roots{dataSyncCfg._path};
+    if (dataSyncCfg._includeList.has_value())
+    {
+        roots.assign(dataSyncCfg._includeList.value().begin(),
+                     dataSyncCfg._includeList.value().end());
+    }
+
+    auto isExcluded = [&dataSyncCfg](const fs::path& path) {
+        return dataSyncCfg._excludeList.has_value() &&
+               std::ranges::any_of(dataSyncCfg._excludeList.value().first,
+                                   [&path](const fs::path& excludePath) {
+            return utility::isSameOrChildOf(path, excludePath);
+        });
+    };
+
+    ChangeProbes changeProbes;
+    for (auto& root : roots)
     {
-        return;
+        changeProbes.emplace_back(std::make_unique<watch::scan::SubtreeScanner>(
+            std::move(root), isExcluded));
     }
+    return changeProbes;
+}
 
-    try
+sdbusplus::async::task<>
+    // NOLINTNEXTLINE
+    Manager::waitRetryInterval(std::chrono::milliseconds interval)
+{
+    // Don't wait if a flush is requested, or if the sibling BMC is down or
+    // the circuit is open as the retry would be deferred anyway. These wake
+    // up the wait if they happen meanwhile.
+    if (_flushRequests > 0 || isSiblingBmcNotAvailable() ||
+        _circuitBreaker.isOpen())
     {
-        data_sync::persist::update(data_sync::persist::key::fullSyncStatus,
-                                   fullSyncStatus);
+        co_return;
     }
-    catch (const std::exception& e)
+
+    async::WakeupEvent wakeup(_ctx);
+    _retryWakeups.insert(&wakeup);
+    using std::experimental::scope_exit;
+    auto waitDone = scope_exit([this, &wakeup]() noexcept {
+        _retryWakeups.erase(&wakeup);
+    });
+
+    // NOLINTNEXTLINE
+    co_await wakeup.waitUntil(std::chrono::steady_clock::now() + interval);
+    co_return;
+}
+
+void Manager::wakeUpRetries()
+{
+    for (auto* wakeup : _retryWakeups)
     {
-        lg2::error(
-            "Error writing fullSyncStatus property to JSON file: {ERROR}",
-            "ERROR", e);
+        wakeup->notify();
+    }
+}
+
+void Manager::recordSyncResult(int errCode)
+{
+    if (retry::isLinkFailure(errCode))
+    {
+        if (_circuitBreaker.recordFailure())
+        {
+            wakeUpRetries();
+            _ctx.spawn(probeCircuitBreaker());
+        }
+    }
+    else if (_circuitBreaker.recordSuccess())
+    {
+        _ctx.spawn(replayChangeJournal());
+    }
+}
+
+error_log::FFDCSections
+    Manager::getSyncFailureFFDC(tracing::CorrelationId correlationId,
+                                const std::string& rsyncOutput)
+{
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    error_log::FFDCSections ffdcSections;
+
+    if (correlationId != 0)
+    {
+        nlohmann::json eventTrace = nlohmann::json::array();
+        for (const auto& span : tracing::SpanTracer::instance().getSpans())
+        {
+            if (span.correlationId != correlationId)
+            {
+                continue;
+            }
+            eventTrace.push_back(
+                {{"Stage", std::string(tracing::stageInStr(span.stage))},
+                 {"DurationUs",
+                  duration_cast<microseconds>(span.duration).count()},
+                 {"Detail", span.detail}});
+        }
+        if (!eventTrace.empty())
+        {
+            ffdcSections.emplace_back(
+                error_log::FFDCFormat::JSON, error_log::eventTraceSubType, 0x01,
+                nlohmann::json{{"CorrelationId", correlationId},
+                               {"Spans", eventTrace}}
+                    .dump());
+        }
+    }
+
+    if (!rsyncOutput.empty())
+    {
+        ffdcSections.emplace_back(error_log::FFDCFormat::Text,
+                                  error_log::rsyncOutputSubType, 0x01,
+                                  rsyncOutput);
+    }
+    return ffdcSections;
+}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<> Manager::probeCircuitBreaker()
+{
+    while (!_ctx.stop_requested() && _circuitBreaker.isOpen())
+    {
+        co_await sdbusplus::async::sleep_for(_ctx,
+                                             _circuitBreaker.getCooldown());
+        if (!_circuitBreaker.isOpen())
+        {
+            break;
+        }
+
+        // A single parked change is synced as the probe, and the rest are
+        // synced once the circuit gets closed. If nothing is parked, one of
+        // the configurations is synced.
+        const config::DataSyncConfig* probeCfg{nullptr};
+        fs::path probePath;
+        for (const auto& [cfgPath, paths] : _changeJournal.getEntries())
+        {
+            auto cfg = std::ranges::find(_dataSyncConfiguration, cfgPath,
+                                         &config::DataSyncConfig::_path);
+            if (cfg != _dataSyncConfiguration.end() && isSyncEligible(*cfg))
+            {
+                probeCfg = &(*cfg);
+                probePath = *paths.begin();
+                break;
+            }
+        }
+        if (probeCfg == nullptr)
+        {
+            auto cfg = std::ranges::find_if(
+                _dataSyncConfiguration,
+                [this](const auto& cfg) { return isSyncEligible(cfg); });
+            if (cfg == _dataSyncConfiguration.end())
+            {
+                continue;
+            }
+            probeCfg = &(*cfg);
+            probePath = cfg->_path;
+        }
+
+        // NOLINTNEXTLINE
+        if (co_await syncData(*probeCfg, probePath == probeCfg->_path
+                                             ? fs::path{}
+                                             : probePath))
+        {
+            _changeJournal.remove(probeCfg->_path, probePath);
+        }
+    }
+    co_return;
+}
+
+void Manager::markPendingChange(
+    const config::DataSyncConfig& dataSyncCfg, const fs::path& path,
+    std::chrono::steady_clock::time_point changeTime)
+{
+    // Retain the time of the oldest change
+    dataSyncCfg._pendingChanges.try_emplace(path, changeTime);
+}
+
+void Manager::unmarkPendingChange(
+    const config::DataSyncConfig& dataSyncCfg, const fs::path& path,
+    std::chrono::steady_clock::time_point changeTime)
+{
+    if (auto change = dataSyncCfg._pendingChanges.find(path);
+        change != dataSyncCfg._pendingChanges.end() &&
+        change->second >= changeTime)
+    {
+        dataSyncCfg._pendingChanges.erase(change);
+    }
+}
+
+void Manager::clearPendingChanges(
+    const config::DataSyncConfig& dataSyncCfg, const fs::path& syncedPath,
+    std::chrono::steady_clock::time_point syncStartTime)
+{
+    const auto syncedDir = (syncedPath / "").string();
+    std::erase_if(dataSyncCfg._pendingChanges,
+                  [&syncedPath, &syncedDir, syncStartTime](const auto& change) {
+        const auto& [path, changeTime] = change;
+        return (changeTime <= syncStartTime) &&
+               ((path == syncedPath) || path.string().starts_with(syncedDir));
+    });
+
+    // Any change after the sync start to the periodically synced data will be
+    // replicated only in the next interval.
+    if (dataSyncCfg._syncType == config::SyncType::Periodic)
+    {
+        markPendingChange(dataSyncCfg, dataSyncCfg._path, syncStartTime);
+    }
+}
+
+std::chrono::milliseconds Manager::getReplicationLag()
+{
+    const auto now = std::chrono::steady_clock::now();
+    std::chrono::milliseconds replicationLag{0};
+
+    for (const auto& cfg : _dataSyncConfiguration |
+                               std::views::filter([this](const auto& cfg) {
+        return isSyncEligible(cfg);
+    }))
+    {
+        for (const auto& [path, changeTime] : cfg._pendingChanges)
+        {
+            replicationLag = std::max(
+                replicationLag,
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    now - changeTime));
+        }
+    }
+    return replicationLag;
+}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<std::vector<fs::path>>
+    Manager::flush(std::chrono::milliseconds timeout)
+{
+    const auto flushStartTime = std::chrono::steady_clock::now();
+    const auto deadline = flushStartTime + timeout;
+
+    lg2::info("Flushing the pending changes, timeout : {TIMEOUT}ms", "TIMEOUT",
+              timeout.count());
+
+    // Wake up the pending retries to run right away
+    ++_flushRequests;
+    using std::experimental::scope_exit;
+    auto flushDone = scope_exit([this]() noexcept { --_flushRequests; });
+    wakeUpRetries();
+
+    // The spawned syncs may outlive this coroutine on timeout, hence the
+    // counter is shared.
+    auto spawnedTasks = std::make_shared<size_t>(0);
+
+    // The changes buffered in the collapse windows are dispatched right away
+    // rather than synced again below.
+    std::set<fs::path> dispatchedPaths;
+    for (const auto& pending : _pendingOperations | std::views::values)
+    {
+        if (_syncBMCDataIface.disable_sync() ||
+            pending->dataOperations.empty())
+        {
+            continue;
+        }
+        std::ranges::copy(pending->dataOperations | std::views::keys,
+                          std::inserter(dispatchedPaths,
+                                        dispatchedPaths.end()));
+        std::ranges::copy(pending->renames | std::views::values,
+                          std::inserter(dispatchedPaths,
+                                        dispatchedPaths.end()));
+        pending->windowEnd.notify();
+    }
+
+    auto eligibleCfgs = _dataSyncConfiguration |
+                        std::views::filter([this](const auto& cfg) {
+        return isSyncEligible(cfg);
+    });
+
+    if (!_syncBMCDataIface.disable_sync())
+    {
+        for (const auto& cfg : eligibleCfgs)
+        {
+            std::vector<fs::path> pathsToSync;
+            std::ranges::copy(cfg._pendingChanges | std::views::keys,
+                              std::back_inserter(pathsToSync));
+
+            for (const auto& path : pathsToSync)
+            {
+                // The in-flight syncs are waited below
+                if (cfg._syncInProgressPaths.contains(path) ||
+                    dispatchedPaths.contains(path))
+                {
+                    continue;
+                }
+                _ctx.spawn(
+                    syncData(cfg, path == cfg._path ? fs::path{} : path) |
+                    stdexec::then([spawnedTasks]([[maybe_unused]] bool result) {
+                    --(*spawnedTasks);
+                }));
+                ++(*spawnedTasks);
+            }
+        }
+    }
+
+    // The dispatched syncs might still be queued behind the overlapping
+    // ones, hence waited till their changes are replicated.
+    auto isSyncInFlight = [&eligibleCfgs, &spawnedTasks, &dispatchedPaths,
+                           flushStartTime]() {
+        return (*spawnedTasks > 0) ||
+               std::ranges::any_of(eligibleCfgs, [&](const auto& cfg) {
+            return !cfg._syncInProgressPaths.empty() ||
+                   std::ranges::any_of(cfg._pendingChanges,
+                                       [&](const auto& change) {
+                return change.second < flushStartTime &&
+                       dispatchedPaths.contains(change.first);
+            });
+        });
+    };
+
+    while (!_ctx.stop_requested() && isSyncInFlight() &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+        co_await sdbusplus::async::sleep_for(_ctx,
+                                             std::chrono::milliseconds(50));
+    }
+
+    // The changes occurred before the flush and still pending are failed to
+    // replicate.
+    std::vector<fs::path> failedPaths;
+    for (const auto& cfg : eligibleCfgs)
+    {
+        for (const auto& [path, changeTime] : cfg._pendingChanges)
+        {
+            if (changeTime < flushStartTime)
+            {
+                failedPaths.emplace_back(path);
+            }
+        }
+    }
+
+    if (failedPaths.empty())
+    {
+        lg2::info("Flushed all the pending changes");
+    }
+    else
+    {
+        lg2::error("Failed to flush the changes of {COUNT} paths", "COUNT",
+                   failedPaths.size());
+    }
+    co_return failedPaths;
+}
+
+void Manager::disableSyncPropChanged(bool disableSync)
+{
+    if (disableSync)
+    {
+        // The sync events are kept running and the changes get journaled
+        // until the sync is enabled.
+        lg2::info("Sync is Disabled, Pausing events");
+    }
+    else
+    {
+        // Starts only the events which are not running yet, Eg: if the sync
+        // was disabled at startup.
+        lg2::info("Sync is Enabled, Resuming events");
+        _ctx.spawn(startSyncEvents());
+        _ctx.spawn(replayChangeJournal());
+    }
+}
+
+void Manager::siblingAvailabilityChanged(bool available)
+{
+    if (available)
+    {
+        _ctx.spawn(replayChangeJournal());
+    }
+    else
+    {
+        wakeUpRetries();
+    }
+}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<> Manager::replayChangeJournal()
+{
+    // A concurrent replay would take the syncs in progress by this one as
+    // succeeded and drop their entries even if they fail, hence replay again
+    // once this one is done.
+    if (_replayInProgress)
+    {
+        _replayRequested = true;
+        co_return;
+    }
+
+    _replayInProgress = true;
+    using std::experimental::scope_exit;
+    auto replayDone = scope_exit([this]() noexcept {
+        _replayInProgress = false;
+    });
+
+    do
+    {
+        _replayRequested = false;
+        // NOLINTNEXTLINE
+        co_await replayJournalEntries();
+    } while (_replayRequested && !_ctx.stop_requested());
+    co_return;
+}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<> Manager::replayJournalEntries()
+{
+    if (_changeJournal.empty() || _syncBMCDataIface.disable_sync() ||
+        isSiblingBmcNotAvailable())
+    {
+        co_return;
+    }
+
+    if (_changeJournal.isOverflowed())
+    {
+        lg2::info("The missed changes are not journaled, starting the full "
+                  "sync to recover");
+        // The journal gets cleared once the full sync succeeds.
+        co_await startFullSync();
+        co_return;
+    }
+
+    lg2::info("Replaying the {COUNT} journaled changes", "COUNT",
+              _changeJournal.size());
+
+    // Copy, as the journal gets updated while the syncs are in progress.
+    const journal::JournalEntries entries = _changeJournal.getEntries();
+
+    // Shared with the workers rather than referred, as they outlive this
+    // coroutine if it is unwound on the stop request.
+    auto queue = std::make_shared<ReplayQueue>();
+    for (const auto& [cfgPath, paths] : entries)
+    {
+        auto cfg = std::ranges::find(_dataSyncConfiguration, cfgPath,
+                                     &config::DataSyncConfig::_path);
+        if (cfg == _dataSyncConfiguration.end() || !isSyncEligible(*cfg))
+        {
+            // The configuration is removed or not applicable to the current
+            // role anymore, hence the changes don't need to be synced.
+            for (const auto& path : paths)
+            {
+                _changeJournal.remove(cfgPath, path);
+            }
+            continue;
+        }
+
+        for (const auto& path : paths)
+        {
+            queue->emplace_back(&(*cfg), path);
+        }
+    }
+
+    auto runningWorkers = std::make_shared<size_t>(0);
+    const auto workers = std::min(queue->size(), maxConcurrentReplaySyncs);
+    for (size_t worker = 0; worker < workers; ++worker)
+    {
+        ++(*runningWorkers);
+        _ctx.spawn(replayJournalWorker(queue) |
+                   stdexec::then([runningWorkers]() { --(*runningWorkers); }));
+    }
+
+    while (*runningWorkers > 0)
+    {
+        co_await sdbusplus::async::sleep_for(_ctx,
+                                             std::chrono::milliseconds(50));
+    }
+
+    lg2::info("Replayed the journaled changes, {COUNT} changes are yet to be "
+              "synced",
+              "COUNT", _changeJournal.size());
+    co_return;
+}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<>
+    Manager::replayJournalWorker(std::shared_ptr<ReplayQueue> queue)
+{
+    while (!queue->empty() && !_ctx.stop_requested())
+    {
+        auto [cfg, path] = std::move(queue->front());
+        queue->pop_front();
+
+        // NOLINTNEXTLINE
+        if (co_await syncData(*cfg, path == cfg->_path ? fs::path{} : path))
+        {
+            _changeJournal.remove(cfg->_path, path);
+        }
+    }
+    co_return;
+}
+
+void Manager::setFullSyncStatus(const FullSyncStatus& fullSyncStatus)
+{
+    if (_syncBMCDataIface.full_sync_status() == fullSyncStatus)
+    {
+        return;
+    }
+    _syncBMCDataIface.full_sync_status(fullSyncStatus);
+
+    // Don't persist InProgress status as it's a transient state
+    if (fullSyncStatus == FullSyncStatus::FullSyncInProgress)
+    {
+        return;
     }
+
+    persistProperty(data_sync::persist::key::fullSyncStatus,
+                    std::to_underlying(fullSyncStatus));
 }
 
 void Manager::setSyncEventsHealth(const SyncEventsHealth& syncEventsHealth)
@@ -839,17 +2747,51 @@ void Manager::setSyncEventsHealth(const SyncEventsHealth& syncEventsHealth)
         return;
     }
     _syncBMCDataIface.sync_events_health(syncEventsHealth);
-    try
+    persistProperty(data_sync::persist::key::syncEventsHealth,
+                    std::to_underlying(syncEventsHealth));
+}
+
+void Manager::persistProperty(std::string_view key, nlohmann::json value)
+{
+    _propertiesToPersist.insert_or_assign(std::string(key), std::move(value));
+    if (!_persistingProperties)
     {
-        data_sync::persist::update(data_sync::persist::key::syncEventsHealth,
-                                   syncEventsHealth);
+        _persistingProperties = true;
+        _ctx.spawn(writePersistedProperties());
     }
-    catch (const std::exception& e)
+}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<> Manager::writePersistedProperties()
+{
+    while (!_propertiesToPersist.empty())
     {
-        lg2::error(
-            "Error writing syncEventsHealth property to JSON file: {ERROR}",
-            "ERROR", e);
+        auto properties = std::exchange(_propertiesToPersist, {});
+        try
+        {
+            // A single writer at a time, as the file is read, updated and
+            // written back.
+            co_await worker::WorkerPool::instance().run(
+                _ctx, [properties = std::move(properties)]() {
+                auto json = data_sync::persist::readFile(
+                                data_sync::persist::DBusPropDataFile)
+                                .value_or(nlohmann::json::object());
+                for (const auto& [key, value] : properties)
+                {
+                    json[key] = value;
+                }
+                data_sync::persist::util::writeFile(
+                    json, data_sync::persist::DBusPropDataFile);
+            });
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error("Error writing the properties to JSON file: {ERROR}",
+                       "ERROR", e);
+        }
     }
+    _persistingProperties = false;
+    co_return;
 }
 
 // NOLINTNEXTLINE
@@ -867,6 +2809,12 @@ sdbusplus::async::task<void> Manager::startFullSync()
     {
         // TODO: add receiver logic to stop fullsync when disable sync is set to
         // true.
+        // The consistency group is synced along with its first path
+        if (auto group = getConsistencyGroup(cfg);
+            !group.empty() && group.front() != &cfg)
+        {
+            continue;
+        }
         try
         {
             if (isSyncEligible(cfg))
@@ -909,6 +2857,9 @@ sdbusplus::async::task<void> Manager::startFullSync()
             "DURATION_SECONDS", FullsyncElapsedTime.count());
         setFullSyncStatus(FullSyncStatus::FullSyncCompleted);
         setSyncEventsHealth(SyncEventsHealth::Ok);
+
+        // The full sync covers all the journaled changes
+        _changeJournal.clear();
     }
     else
     {
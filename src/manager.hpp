@@ -2,14 +2,37 @@
 
 #pragma once
 
+#include "change_journal.hpp"
+#include "content_fingerprint.hpp"
 #include "data_sync_config.hpp"
+#include "data_watcher.hpp"
+#include "echo_suppressor.hpp"
+#include "error_log_queue.hpp"
+#include "event_aggregator.hpp"
 #include "external_data_ifaces.hpp"
+#include "keyed_serial_executor.hpp"
 #include "notify_service.hpp"
+#include "parent_dir_watch.hpp"
 #include "persistent.hpp"
+#include "retry_policy.hpp"
+#include "rsync_output_parser.hpp"
+#include "sibling_monitor.hpp"
 #include "sync_bmc_data_ifaces.hpp"
+#include "timer_wheel.hpp"
+#include "tracing.hpp"
+#include "wakeup_event.hpp"
 
+#include <deque>
 #include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
 #include <ranges>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace data_sync
@@ -24,8 +47,9 @@ namespace fs = std::filesystem;
 
 enum class RsyncMode
 {
-    Sync,  // perform sync
-    Notify // perform sibling notification
+    Sync,   // perform sync
+    Notify, // perform sibling notification
+    Rename  // perform sync of a renamed path, reusing its old copy
 };
 
 /**
@@ -81,15 +105,14 @@ class Manager
     /**
      * @brief Helper API that retrieves the sibling BMC availability
      *
+     *        The sibling BMC is treated as available until the sibling
+     *        monitor finds it otherwise.
+     *
      * @return True if sibling BMC is not available; otherwise False.
      */
-    static bool isSiblingBmcNotAvailable()
+    bool isSiblingBmcNotAvailable() const
     {
-        // TODO: It should be decided based on
-        //       the xyz.openbmc_project.Network.Neighbor DBus interface,
-        //       managed by the network daemon.
-        //       For now, return as false to treat the sibling BMC is available.
-        return false;
+        return _siblingMonitor && !_siblingMonitor->isAvailable();
     }
 
     /**
@@ -108,9 +131,12 @@ class Manager
     void setFullSyncStatus(const FullSyncStatus& fullSyncStatus);
 
     /**
-     * @brief Helper API to start events when Disable sync property is changed.
-     *        - If the Disable sync property is set to true, it stops all sync
-     *          events. Otherwise, it starts all sync events.
+     * @brief Helper API to pause/resume events when Disable sync property is
+     *        changed.
+     *        - If the Disable sync property is set to true, the sync events
+     *          keep running but the changes are journaled instead of synced.
+     *        - Otherwise, it starts the sync events which are not running
+     *          yet and syncs the journaled changes.
      *
      * @param[in] disableSync - The Disable sync property value being set.
      */
@@ -127,6 +153,14 @@ class Manager
         _syncBMCDataIface.disable_sync(disableSync);
     }
 
+    /**
+     * @brief Helper API fetches the Disable sync Dbus property.
+     */
+    bool isSyncDisabled() const
+    {
+        return _syncBMCDataIface.disable_sync();
+    }
+
     /**
      * @brief Helper API fetches the sync events health Dbus property.
      *        Specifically, for unit testing purposes.
@@ -144,6 +178,123 @@ class Manager
      */
     void setSyncEventsHealth(const SyncEventsHealth& syncEventsHealth);
 
+    /**
+     * @brief API to persist a D-Bus property value off the event loop.
+     *
+     *        The values persisted meanwhile are written together, in the
+     *        order they are set.
+     *
+     * @param[in] key - The key to persist the value under
+     * @param[in] value - The value to persist
+     */
+    void persistProperty(std::string_view key, nlohmann::json value);
+
+    /**
+     * @brief API to replay the inotify events recorded for a configured path.
+     *
+     *        - The recorded events are fed into a new watcher created for the
+     *          traced path, and the resulted data operations are synced the
+     *          same way as the live events.
+     *        - The traced path should be part of the data sync configuration.
+     *
+     * @param[in] traceFile - The recorded trace to replay
+     * @param[in] speedFactor - The replay speed relative to the recording,
+     *                          0 to replay without any delay.
+     */
+    sdbusplus::async::task<> replayEventTrace(const fs::path& traceFile,
+                                              double speedFactor = 1.0);
+
+    /**
+     * @brief API to replay the given inotify trace once the sync events are
+     *        started, Eg: to reproduce an event burst in a benchmark.
+     *
+     * @note To be called before running the async context.
+     *
+     * @param[in] traceFile - The recorded trace to replay
+     * @param[in] speedFactor - The replay speed relative to the recording,
+     *                          0 to replay without any delay.
+     */
+    void replayEventTraceOnStart(const fs::path& traceFile,
+                                 double speedFactor)
+    {
+        _startupReplay.emplace(traceFile, speedFactor);
+    }
+
+    /**
+     * @brief API to get the replication lag, i.e. the age of the oldest change
+     *        which is not yet replicated to the sibling BMC across all the
+     *        configurations eligible to sync.
+     *
+     *        For the Periodic sync, the changes are not watched. Hence the
+     *        time since the last successful sync start, or since the last
+     *        interval found without changes, is considered, which is the
+     *        upper bound of the lag.
+     *
+     * @return The replication lag, zero if everything is replicated.
+     */
+    std::chrono::milliseconds getReplicationLag();
+
+    /**
+     * @brief API to get the totals of the transfers by the rename syncs,
+     *        without the itemized changes.
+     */
+    const utility::rsync::TransferStats& getRenameTransfers() const
+    {
+        return _renameTransfers;
+    }
+
+    /**
+     * @brief API to replicate all the pending changes right away and to wait
+     *        for all the in-flight syncs to complete.
+     *
+     *        - Syncs the paths having pending changes and the Periodic
+     *          configurations without waiting for their interval.
+     *        - Cuts short the waits of the pending retries.
+     *        - Intended to be used before a planned failover to ensure the
+     *          sibling BMC is current.
+     *
+     * @param[in] timeout - The maximum time to wait for the syncs to complete
+     *
+     * @return The paths whose changes couldn't be replicated before the
+     *         timeout, empty if all the changes are replicated.
+     */
+    sdbusplus::async::task<std::vector<fs::path>>
+        flush(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief API to get the schedule of the periodic syncs.
+     *
+     * @return The configured path, the periodicity and the next sync time of
+     *         the Periodic configurations, in the order of their next sync.
+     */
+    std::vector<schedule::TimerWheel::Entry> getPeriodicSchedule() const
+    {
+        return _timerWheel.getSchedule();
+    }
+
+    /**
+     * @brief API to sync the changes journaled while the sync was disabled
+     *        or the sibling BMC was not available.
+     *
+     *        - Syncs only the journaled paths, and removes them from the
+     *          journal once synced.
+     *        - Falls back to the full sync if the journal is overflowed.
+     *        - Intended to be called on re-enabling the sync and on the
+     *          sibling BMC becoming available again.
+     *        - Runs one replay at a time, and replays again once done if it
+     *          is called meanwhile.
+     */
+    sdbusplus::async::task<> replayChangeJournal();
+
+    /**
+     * @brief Helper API to get the change journal.
+     *        Specifically, for unit testing purposes.
+     */
+    const journal::ChangeJournal& getChangeJournal() const
+    {
+        return _changeJournal;
+    }
+
   private:
     /**
      * @brief A helper API to start the data sync operation.
@@ -157,6 +308,25 @@ class Manager
      */
     sdbusplus::async::task<> parseConfiguration();
 
+    /**
+     * @brief API to validate the consistency groups of the parsed
+     *        configurations. The groups whose paths can't be synced in a
+     *        single rsync are dropped, and their paths synced on their own.
+     */
+    void validateConsistencyGroups();
+
+    /**
+     * @brief API to get the configurations in the consistency group of the
+     *        given configuration, in the configured order. The first one
+     *        syncs the group on behalf of the others.
+     *
+     * @param[in] dataSyncCfg - The data sync config to get its group
+     *
+     * @return The configurations of the group, empty if it is not grouped.
+     */
+    std::vector<const config::DataSyncConfig*>
+        getConsistencyGroup(const config::DataSyncConfig& dataSyncCfg) const;
+
     /**
      * @brief API to process the unprocessed notify requests if any during
      *        startup.
@@ -182,25 +352,92 @@ class Manager
     sdbusplus::async::task<> startSyncEvents();
 
     /**
-     * @brief API responsible to trigger sibling notification if required.
+     * @brief A helper API to start the sync events of the given configuration
+     *        based on its sync type, unless they are already running.
+     *
+     * @param[in] dataSyncCfg - The data sync config to start the events for
+     */
+    void spawnSyncEvents(const config::DataSyncConfig& dataSyncCfg);
+
+    /**
+     * @brief A helper API to re-evaluate the sync events on the BMC role
+     *        change.
+     *
+     *        - Stops the events of the configurations which aren't eligible
+     *          to sync anymore, and starts the events of the configurations
+     *          which became eligible.
+     *        - Syncs the configurations which became eligible, as this BMC
+     *          owns their data now.
+     *        - The Bidirectional configurations are left untouched.
+     *
+     * @param[in] bmcRole - The new BMC role
+     */
+    void bmcRoleChanged(const ext_data::BMCRole& bmcRole);
+
+    /**
+     * @brief A helper API to handle the sibling BMC availability change.
+     *        The changes deferred while the sibling BMC was not available
+     *        are synced once it is available.
+     *
+     * @param[in] available - The sibling BMC availability
+     */
+    void siblingAvailabilityChanged(bool available);
+
+    /**
+     * @brief API responsible to trigger sibling notification.
      *
      * @param[in] dataSyncCfg - The data sync config to sync
-     * @param[in] srcPath - The modified path inside the cfg path.
-     *                      Will be empty if not available.
+     * @param[in] modifiedPaths - The modified paths inside the cfg path which
+     *                            need the notification.
+     * @param[in] correlationId - The correlation id of the synced change
      *
      * @return : none
      */
     sdbusplus::async::task<void>
         triggerSiblingNotification(const config::DataSyncConfig& dataSyncCfg,
-                                   const std::string& srcPath);
+                                   const std::vector<fs::path>& modifiedPaths,
+                                   tracing::CorrelationId correlationId);
+
+    /**
+     * @brief API to notify the sibling of the paths changed by a sync, once
+     *        per the set of the services to be notified.
+     *
+     * @param[in] syncedPaths - The configs synced together along with the
+     *                          path synced for each of them
+     * @param[in] transfer - The result of the sync
+     * @param[in] correlationId - The correlation id of the synced change
+     *
+     * @return : none
+     */
+    sdbusplus::async::task<void> notifySiblingOfChanges(
+        const std::vector<
+            std::pair<const config::DataSyncConfig*, fs::path>>& syncedPaths,
+        const utility::rsync::TransferStats& transfer,
+        tracing::CorrelationId correlationId);
+
+    /**
+     * @brief A helper API to get the paths changed by a sync which need the
+     *        sibling notification as per the NotifyOnPaths of the config.
+     *
+     * @param[in] dataSyncCfg - The data sync config synced
+     * @param[in] syncedPath - The path synced inside the cfg path
+     * @param[in] transfer - The result of the sync
+     *
+     * @return The changed paths to notify, empty if nothing to notify.
+     */
+    static std::vector<fs::path>
+        getNotifyPaths(const config::DataSyncConfig& dataSyncCfg,
+                       const fs::path& syncedPath,
+                       const utility::rsync::TransferStats& transfer);
 
     /**
      * @brief API to frame the RSYNC CLI command
      *
-     * @param[in] mode - enum RsyncMode : sync or notify
+     * @param[in] mode - enum RsyncMode : sync, notify or rename
      * @param[in] dataSyncCfg - The data sync config to sync
      * @param[in] srcPath - The modified path inside the cfg path.
      *                      Will be empty if not available.
+     *                      The old and the new path for the rename.
      * @param[out] cmd - string where the framed RSYNC command holds.
      */
     // Disabled because this function conditionally accesses class members when
@@ -217,13 +454,16 @@ class Manager
      * @param[in] dataSyncCfg - The data sync config to sync
      * @param[in] srcPath - The modified path inside the cfg path, if available.
      * @param[in] retryCount - The current retry attempt count
+     * @param[in] correlationId - The correlation id of the change being
+     *                            synced, a new one is allocated if 0.
      *
      * @return Returns true if sync succeeds; otherwise, returns false
      *
      */
     sdbusplus::async::task<bool>
         syncData(const config::DataSyncConfig& dataSyncCfg,
-                 fs::path srcPath = fs::path{}, size_t retryCount = 0);
+                 fs::path srcPath = fs::path{}, size_t retryCount = 0,
+                 tracing::CorrelationId correlationId = 0);
 
     /**
      * @brief Wrapper API to frame and issue RSYNC command to sync the generated
@@ -247,11 +487,13 @@ class Manager
      * @param[in] cfg - Data sync configuration
      * @param[in] srcPath - Source path to be synced
      * @param[in] retryCount - Current retry attempt number
+     * @param[in] correlationId - The correlation id of the change being synced
      *
      * @return true if the retry succeeds or can be skipped, false if failed
      */
-    sdbusplus::async::task<bool> retrySync(const config::DataSyncConfig& cfg,
-                                           fs::path srcPath, size_t retryCount);
+    sdbusplus::async::task<bool>
+        retrySync(const config::DataSyncConfig& cfg, fs::path srcPath,
+                  size_t retryCount, tracing::CorrelationId correlationId);
 
     /**
      * @brief A helper to API to monitor data to sync if its changed
@@ -263,12 +505,303 @@ class Manager
         monitorDataToSync(const config::DataSyncConfig& dataSyncCfg);
 
     /**
-     * @brief A helper to API to sync data periodically.
+     * @brief A helper API to check whether the given configuration can be
+     *        watched through the shared watch of its parent directory.
+     *
+     * @param[in] dataSyncCfg - The data sync config to watch
+     */
+    static bool canWatchParentDir(const config::DataSyncConfig& dataSyncCfg);
+
+    /**
+     * @brief A helper API to monitor the configured file through the shared
+     *        watch of its parent directory.
+     *
+     * @param[in] dataSyncCfg - The data sync config to sync
+     *
+     * @return True if monitored until the stop is requested, False if the
+     *         file needs to be watched by itself.
+     */
+    sdbusplus::async::task<bool>
+        monitorParentDir(const config::DataSyncConfig& dataSyncCfg);
+
+    /**
+     * @brief A helper API to scan the subtrees which are not watched due to
+     *        the inotify watch budget, until none is left or the watcher is
+     *        gone.
+     *
+     * @param[in] dataSyncCfg - The data sync config being watched
+     * @param[in] dataWatcher - The watcher of the configuration
+     * @param[in] polling - Indicates the scan is running, reset on its end
+     */
+    sdbusplus::async::task<> monitorPolledSubtrees(
+        const config::DataSyncConfig& dataSyncCfg,
+        std::weak_ptr<watch::inotify::DataWatcher> dataWatcher,
+        std::shared_ptr<bool> polling);
+
+    /**
+     * @brief A helper API to create the inotify watcher for the given
+     *        configuration.
+     *
+     * @param[in] dataSyncCfg - The data sync config to watch
+     *
+     * @return The created watcher
+     */
+    std::unique_ptr<watch::inotify::DataWatcher>
+        createDataWatcher(const config::DataSyncConfig& dataSyncCfg);
+
+    /**
+     * @brief A helper API to initiate the sync for the data operations
+     *        resulted from the inotify events.
+     *
+     *        The written files are hashed on the worker threads to drop the
+     *        rewrites with the same content, before dispatching.
+     *
+     * @param[in] dataSyncCfg - The data sync config to sync
+     * @param[in] dataOperations - The data operations to sync
+     * @param[in] correlationId - The correlation id of the events resulted
+     *                            in the data operations
+     * @param[in] renames - The old paths of the RENAME data operations
+     * @param[in] changeTime - The time the changes are marked pending at
+     */
+    sdbusplus::async::task<> dispatchDataOperations(
+        const config::DataSyncConfig& dataSyncCfg,
+        watch::inotify::DataOperations dataOperations,
+        tracing::CorrelationId correlationId,
+        watch::inotify::Renames renames = {},
+        std::chrono::steady_clock::time_point changeTime =
+            std::chrono::steady_clock::now());
+
+    /**
+     * @brief A helper API to fingerprint the written files of the given data
+     *        operations on the worker threads.
+     *
+     * @param[in] dataSyncCfg - The data sync config of the data operations
+     * @param[in] dataOperations - The data operations to check
+     *
+     * @return The fingerprints of the written files.
+     */
+    sdbusplus::async::task<std::map<fs::path, fingerprint::TimedFingerprint>>
+        fingerprintWrites(const config::DataSyncConfig& dataSyncCfg,
+                          const watch::inotify::DataOperations& dataOperations);
+
+    /**
+     * @brief The data operations of a configuration accumulated across the
+     *        inotify wakeups, until they are dispatched.
+     */
+    struct PendingOperations
+    {
+        explicit PendingOperations(sdbusplus::async::context& ctx) :
+            windowEnd(ctx)
+        {}
+
+        // The accumulated data operations, the latest per path
+        watch::inotify::DataOperations dataOperations;
+
+        // The old paths of the accumulated RENAME data operations
+        watch::inotify::Renames renames;
+
+        // The correlation id of the first accumulated events
+        tracing::CorrelationId correlationId{0};
+
+        // The time of the first accumulated events, which are marked pending
+        std::chrono::steady_clock::time_point changeTime;
+
+        // Indicates the dispatch at the end of the window is scheduled
+        bool dispatchScheduled{false};
+
+        // Ends the window right away, Eg: upon a flush request
+        async::WakeupEvent windowEnd;
+    };
+
+    /**
+     * @brief A helper API to accumulate the data operations of a wakeup, and
+     *        to schedule their dispatch at the end of the collapse window so
+     *        that a burst spread across the wakeups is collapsed as a whole.
+     *        The changes are marked pending right away, for the replication
+     *        lag and the flush.
+     *
+     * @param[in] dataSyncCfg - The data sync config to sync
+     * @param[in] pending - The data operations accumulated so far
+     * @param[in] dataOperations - The data operations of the wakeup
+     * @param[in] correlationId - The correlation id of the wakeup
+     * @param[in] renames - The old paths of the RENAME data operations
+     */
+    void accumulateDataOperations(
+        const config::DataSyncConfig& dataSyncCfg,
+        const std::shared_ptr<PendingOperations>& pending,
+        const watch::inotify::DataOperations& dataOperations,
+        tracing::CorrelationId correlationId,
+        const watch::inotify::Renames& renames);
+
+    /**
+     * @brief A helper API to dispatch the accumulated data operations once
+     *        the collapse window ends, until none is accumulated meanwhile.
+     *
+     * @param[in] dataSyncCfg - The data sync config to sync
+     * @param[in] pending - The data operations accumulated so far
+     */
+    sdbusplus::async::task<>
+        dispatchPendingOperations(const config::DataSyncConfig& dataSyncCfg,
+                                  std::shared_ptr<PendingOperations> pending);
+
+    /**
+     * @brief A helper API to sync the consistency group of the given config
+     *        once the changes of its paths settle, so that the paths written
+     *        back to back go in the same rsync.
+     *
+     * @param[in] dataSyncCfg - The data sync config whose path changed
+     * @param[in] correlationId - The correlation id of the change
+     *
+     * @return True if the group is synced; otherwise False.
+     */
+    sdbusplus::async::task<bool>
+        syncConsistencyGroup(const config::DataSyncConfig& dataSyncCfg,
+                             tracing::CorrelationId correlationId);
+
+    /**
+     * @brief A helper API to drop the data operations which are the echoes of
+     *        the changes applied by the sibling BMC, only for the
+     *        Bidirectional configurations.
+     *
+     * @param[in] dataSyncCfg - The data sync config of the data operations
+     * @param[in] dataOperations - The data operations to check
+     * @param[in] renames - The old paths of the RENAME data operations
+     *
+     * @return The data operations which are the local changes.
+     */
+    watch::inotify::DataOperations
+        suppressEchoes(const config::DataSyncConfig& dataSyncCfg,
+                       const watch::inotify::DataOperations& dataOperations,
+                       const watch::inotify::Renames& renames);
+
+    /**
+     * @brief A helper API to read the changes applied by the sibling BMC from
+     *        the applied changes log, tracking only the ones which can echo.
+     */
+    void drainAppliedChanges();
+
+    /**
+     * @brief A helper API to drain the applied changes log as the rsync
+     *        daemon writes it, so that the log is truncated even if no local
+     *        change is dispatched, Eg: on the passive BMC.
+     */
+    sdbusplus::async::task<> monitorAppliedChanges();
+
+    /**
+     * @brief A helper API to sync a renamed path in a single rsync, which
+     *        deletes the old path on the sibling BMC after transferring the
+     *        new path using the old copy as the basis, so that only the
+     *        metadata is transferred. The files of a renamed directory have
+     *        no basis in their new directory, hence are transferred in full.
+     *
+     *        Falls back to the separate syncs of the old and the new path if
+     *        it fails, for their retries and error handling.
+     *
+     * @param[in] dataSyncCfg - The data sync config to sync
+     * @param[in] from - The old path
+     * @param[in] to - The new path
+     * @param[in] correlationId - The correlation id of the rename
+     *
+     * @return Returns true if sync succeeds; otherwise, returns false
+     */
+    sdbusplus::async::task<bool>
+        syncRename(const config::DataSyncConfig& dataSyncCfg, fs::path from,
+                   fs::path to, tracing::CorrelationId correlationId);
+
+    /**
+     * @brief A helper API to record the inotify events received for the given
+     *        configuration into the given trace directory.
+     *
+     * @param[in] dataWatcher - The watcher of the configuration
+     * @param[in] dataSyncCfg - The data sync config being watched
+     * @param[in] traceDir - The directory to create the trace in
+     */
+    static void startEventRecording(watch::inotify::DataWatcher& dataWatcher,
+                                    const config::DataSyncConfig& dataSyncCfg,
+                                    const fs::path& traceDir);
+
+    /**
+     * @brief The probes of the changes of a periodic sync config, created on
+     *        its first interval.
+     */
+    using ChangeProbes =
+        std::vector<std::unique_ptr<watch::scan::SubtreeScanner>>;
+
+    /**
+     * @brief A helper API to schedule the periodic sync of the given config on
+     *        the timer wheel, and to wake up the wheel earlier if required.
+     *
+     * @param[in] dataSyncCfg - The data sync config to sync
+     */
+    void schedulePeriodicSync(const config::DataSyncConfig& dataSyncCfg);
+
+    /**
+     * @brief A helper API to stop the periodic sync of the given config.
+     *
+     * @param[in] dataSyncCfg - The data sync config
+     */
+    void unschedulePeriodicSync(const config::DataSyncConfig& dataSyncCfg);
+
+    /**
+     * @brief API to dispatch the periodic syncs as they become due on the
+     *        timer wheel, the ones due together are dispatched as a batch.
+     *
+     * @param[in] generation - The generation of the wheel runner, it stops
+     *                         once a later one is started to wake up earlier.
+     */
+    sdbusplus::async::task<> runTimerWheel(size_t generation);
+
+    /**
+     * @brief API to sync the periodic configs due together, skipping the ones
+     *        without changes, and syncing the ones which can share a transfer
+     *        in a single rsync.
+     *
+     * @param[in] batch - The periodic configs due together
+     */
+    sdbusplus::async::task<>
+        syncPeriodicBatch(std::vector<const config::DataSyncConfig*> batch);
+
+    /**
+     * @brief API to sync a periodic config on its own, and to keep it dirty
+     *        if the sync fails.
      *
      * @param[in] dataSyncCfg - The data sync config to sync
      */
     sdbusplus::async::task<>
-        monitorTimerToSync(const config::DataSyncConfig& dataSyncCfg);
+        syncPeriodic(const config::DataSyncConfig& dataSyncCfg);
+
+    /**
+     * @brief API to sync the configured paths of the given configs in a
+     *        single rsync.
+     *
+     * @param[in] dataSyncCfgs - The configs sharing the destination path
+     *
+     * @return True if synced; otherwise False, to sync them separately which
+     *         takes care of the journaling and the retries.
+     */
+    sdbusplus::async::task<bool> syncTogether(
+        const std::vector<const config::DataSyncConfig*>& dataSyncCfgs);
+
+    /**
+     * @brief A helper API to check whether the configured path can be synced
+     *        in a single rsync along with the other paths, i.e. the rsync
+     *        command doesn't depend on the configuration.
+     *
+     * @param[in] dataSyncCfg - The data sync config
+     */
+    static bool canShareTransfer(const config::DataSyncConfig& dataSyncCfg);
+
+    /**
+     * @brief A helper API to create the probes which find whether the data of
+     *        a periodic sync config is changed since the previous interval by
+     *        the modification times, as the periodic data is not watched.
+     *
+     * @param[in] dataSyncCfg - The periodic data sync config
+     *
+     * @return The probes per included path, or of the configured path.
+     */
+    static ChangeProbes
+        createChangeProbes(const config::DataSyncConfig& dataSyncCfg);
 
     /**
      * @brief A helper to API Checks if the data can be synchronize.
@@ -293,6 +826,125 @@ class Manager
      */
     static bool isRetryEligible(uint8_t errCode) noexcept;
 
+    /**
+     * @brief A helper API to wait for the retry interval, which returns
+     *        earlier if a flush is requested, the sibling BMC goes down or
+     *        the circuit gets opened meanwhile.
+     *
+     * @param[in] interval - The retry interval
+     */
+    sdbusplus::async::task<>
+        waitRetryInterval(std::chrono::milliseconds interval);
+
+    /**
+     * @brief A helper API to feed the rsync result into the circuit breaker.
+     *
+     *        - Starts probing the sibling BMC once the circuit gets opened.
+     *        - Syncs the parked changes once the circuit gets closed.
+     *
+     * @param[in] errCode - The rsync exit code
+     */
+    void recordSyncResult(int errCode);
+
+    /**
+     * @brief A helper API to get the FFDC sections of a sync failure, i.e.
+     *        the traced pipeline stages of the change and the rsync output.
+     *
+     * @param[in] correlationId - The correlation id of the failed change
+     * @param[in] rsyncOutput - The rsync output of the failed sync
+     *
+     * @return The FFDC sections to attach to the error log.
+     */
+    static error_log::FFDCSections
+        getSyncFailureFFDC(tracing::CorrelationId correlationId,
+                           const std::string& rsyncOutput);
+
+    /**
+     * @brief A helper API to probe the sibling BMC connection after every
+     *        cooldown while the circuit is open, by syncing one of the parked
+     *        changes.
+     */
+    sdbusplus::async::task<> probeCircuitBreaker();
+
+    /**
+     * @brief The journaled changes yet to be synced by a replay, with the
+     *        data sync config of each.
+     */
+    using ReplayQueue =
+        std::deque<std::pair<const config::DataSyncConfig*, fs::path>>;
+
+    /**
+     * @brief The maximum number of the journaled changes synced concurrently
+     *        by a replay, so that a large journal doesn't spawn an rsync per
+     *        change at once.
+     */
+    static constexpr size_t maxConcurrentReplaySyncs = 4;
+
+    /**
+     * @brief A helper API to sync the journaled changes once, and to remove
+     *        them from the journal once synced.
+     */
+    sdbusplus::async::task<> replayJournalEntries();
+
+    /**
+     * @brief A helper API to sync the queued journaled changes one by one,
+     *        until none is left.
+     *
+     * @param[in] queue - The journaled changes shared by the replay workers
+     */
+    sdbusplus::async::task<>
+        replayJournalWorker(std::shared_ptr<ReplayQueue> queue);
+
+    /**
+     * @brief A helper API to wake up the retries waiting for their interval.
+     */
+    void wakeUpRetries();
+
+    /**
+     * @brief API to write the properties to persist on a worker thread,
+     *        until none is left.
+     */
+    sdbusplus::async::task<> writePersistedProperties();
+
+    /**
+     * @brief A helper API to record a change which is not yet replicated.
+     *
+     * @param[in] dataSyncCfg - The data sync config of the changed path
+     * @param[in] path - The changed path
+     * @param[in] changeTime - The time of the change
+     */
+    static void markPendingChange(
+        const config::DataSyncConfig& dataSyncCfg, const fs::path& path,
+        std::chrono::steady_clock::time_point changeTime);
+
+    /**
+     * @brief A helper API to drop the pending change of a path which is not
+     *        synced after all, Eg: an echo. An earlier change of the path is
+     *        still pending, hence retained.
+     *
+     * @param[in] dataSyncCfg - The data sync config of the changed path
+     * @param[in] path - The changed path
+     * @param[in] changeTime - The time the change is marked pending at
+     */
+    static void unmarkPendingChange(
+        const config::DataSyncConfig& dataSyncCfg, const fs::path& path,
+        std::chrono::steady_clock::time_point changeTime);
+
+    /**
+     * @brief A helper API to clear the pending changes replicated by a
+     *        successful sync.
+     *
+     * @param[in] dataSyncCfg - The data sync config which is synced
+     * @param[in] syncedPath - The synced path, all the pending changes of
+     *                         the path and its children are cleared.
+     * @param[in] syncStartTime - The time at which the sync started. The
+     *                            changes after it may not be replicated,
+     *                            hence retained.
+     */
+    static void clearPendingChanges(
+        const config::DataSyncConfig& dataSyncCfg, const fs::path& syncedPath,
+        std::chrono::steady_clock::time_point syncStartTime);
+
     /**
      * @brief The async context object used to perform operations asynchronously
      *        as required.
@@ -319,12 +971,156 @@ class Manager
      */
     dbus_ifaces::SyncBMCDataIface _syncBMCDataIface;
 
+    /**
+     * @brief Replication Server Interface object
+     */
+    dbus_ifaces::ReplicationIface _replicationIface;
+
     /**
      * @brief To store the list of notification requests.
      *        Auto cleanup will be done once notification
      *        completes.
      */
     std::vector<std::unique_ptr<notify::NotifyService>> _notifyReqs;
+
+    /**
+     * @brief The journal of the changes which couldn't be synced, to replay
+     *        them instead of the full sync once the sync is possible again.
+     */
+    journal::ChangeJournal _changeJournal;
+
+    /**
+     * @brief Indicates the change journal is being replayed.
+     */
+    bool _replayInProgress{false};
+
+    /**
+     * @brief Indicates the change journal is to be replayed again once the
+     *        running replay is done.
+     */
+    bool _replayRequested{false};
+
+    /**
+     * @brief The sibling BMC availability monitor, created once the BMC
+     *        position is known.
+     */
+    std::unique_ptr<sibling::SiblingMonitor> _siblingMonitor;
+
+    /**
+     * @brief The circuit breaker shared by all the syncs towards the sibling
+     *        BMC, to park the syncs during an outage.
+     */
+    retry::CircuitBreaker _circuitBreaker;
+
+    /**
+     * @brief The queue to create the error logs in the background, rate
+     *        limited per error type.
+     */
+    error_log::ErrorLogQueue _errorLogQueue;
+
+    /**
+     * @brief The fingerprints of the synced files, to drop the writes which
+     *        didn't change their content.
+     */
+    fingerprint::FingerprintCache _fingerprints;
+
+    /**
+     * @brief The changes applied by the sibling BMC, to not sync them back
+     *        for the Bidirectional configurations.
+     */
+    echo::EchoSuppressor _echoSuppressor;
+
+    /**
+     * @brief Orders the syncs initiated by the events on the overlapping
+     *        paths, so that the sibling BMC receives the changes in order.
+     */
+    async::KeyedSerialExecutor _syncOrder;
+
+    /**
+     * @brief The consistency groups waiting for the changes of their paths
+     *        to settle before syncing.
+     */
+    std::set<std::string> _settlingGroups;
+
+    /**
+     * @brief The shared watches of the directories of the configured files,
+     *        by the directory.
+     */
+    std::map<fs::path, std::unique_ptr<watch::inotify::ParentDirWatch>>
+        _parentDirWatches;
+
+    /**
+     * @brief The wakeups of the sync events waiting for the changes, by the
+     *        configured path, to stop them right away upon the request.
+     */
+    std::map<fs::path, std::function<void()>> _syncEventsWakeups;
+
+    /**
+     * @brief The data operations accumulated in the collapse window, by the
+     *        configured path, to dispatch them right away upon a flush.
+     */
+    std::map<fs::path, std::shared_ptr<PendingOperations>> _pendingOperations;
+
+    /**
+     * @brief The number of the flush requests in progress. The retry waits
+     *        are cut short while it is non-zero.
+     */
+    size_t _flushRequests{0};
+
+    /**
+     * @brief The events of the retries waiting for their interval, to wake
+     *        them up earlier.
+     */
+    std::set<async::WakeupEvent*> _retryWakeups;
+
+    /**
+     * @brief The totals of the transfers by the rename syncs.
+     */
+    utility::rsync::TransferStats _renameTransfers;
+
+    /**
+     * @brief The property values yet to be persisted, by their key.
+     */
+    std::map<std::string, nlohmann::json, std::less<>> _propertiesToPersist;
+
+    /**
+     * @brief Indicates the properties are being persisted.
+     */
+    bool _persistingProperties{false};
+
+    /**
+     * @brief The schedule of all the periodic syncs, by the configured path.
+     */
+    schedule::TimerWheel _timerWheel;
+
+    /**
+     * @brief The generation of the running timer wheel runner.
+     */
+    size_t _timerWheelGeneration{0};
+
+    /**
+     * @brief The time the running timer wheel runner wakes up at,
+     *        std::nullopt if it is not running.
+     */
+    std::optional<std::chrono::steady_clock::time_point> _timerWheelWakeup;
+
+    /**
+     * @brief The probes of the changes of the periodic syncs, by the
+     *        configured path.
+     */
+    std::map<fs::path, std::shared_ptr<ChangeProbes>> _changeProbes;
+
+    /**
+     * @brief The configured paths whose periodic sync is in progress, to skip
+     *        the intervals due while the previous one is still syncing.
+     */
+    std::set<fs::path> _periodicSyncsInProgress;
+
+    /**
+     * @brief The inotify trace and its speed factor to replay once the sync
+     *        events are started, std::nullopt if none.
+     */
+    std::optional<std::pair<fs::path, double>> _startupReplay;
 };
 
 } // namespace data_sync
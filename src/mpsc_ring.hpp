@@ -0,0 +1,213 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace data_sync::utility
+{
+
+/**
+ * @class MpscRing
+ *
+ * @brief A bounded lock-free multi producer single consumer ring buffer.
+ *
+ * Each slot carries a sequence number which tells whether it is free for the
+ * producer of the given position or holds the value for the consumer, so the
+ * producers only contend on the enqueue position and never on the consumer.
+ * A push into the full ring fails instead of blocking the producer, and is
+ * counted as an overflow.
+ */
+template <typename T>
+class MpscRing
+{
+  public:
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+    MpscRing(MpscRing&&) = delete;
+    MpscRing& operator=(MpscRing&&) = delete;
+    ~MpscRing() = default;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] capacity - The number of slots, rounded up to a power of two
+     */
+    explicit MpscRing(size_t capacity) :
+        _capacity(std::bit_ceil(std::max<size_t>(capacity, 2))),
+        _slots(std::make_unique<Slot[]>(_capacity))
+    {
+        for (size_t i = 0; i < _capacity; ++i)
+        {
+            _slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief API to push a value, safe to call from any thread.
+     *
+     * @param[in] value - The value to push
+     *
+     * @return True if pushed; False if the ring is full.
+     */
+    bool push(T value)
+    {
+        size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        while (true)
+        {
+            slot = &_slots[pos & (_capacity - 1)];
+            const size_t sequence =
+                slot->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(sequence) -
+                              static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (_enqueuePos.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                _overflows.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else
+            {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->value = std::move(value);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+
+        const size_t occupancy = pos + 1 -
+                                 _dequeuePos.load(std::memory_order_relaxed);
+        size_t highWatermark = _highWatermark.load(std::memory_order_relaxed);
+        while (occupancy > highWatermark &&
+               !_highWatermark.compare_exchange_weak(
+                   highWatermark, occupancy, std::memory_order_relaxed))
+        {}
+        return true;
+    }
+
+    /**
+     * @brief API to pop the oldest value, must be called only from the
+     *        consumer thread.
+     *
+     * @return The value if available; otherwise std::nullopt.
+     */
+    std::optional<T> pop()
+    {
+        const size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+        Slot& slot = _slots[pos & (_capacity - 1)];
+        const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(sequence) -
+                static_cast<intptr_t>(pos + 1) <
+            0)
+        {
+            return std::nullopt;
+        }
+
+        std::optional<T> value{std::move(slot.value)};
+        slot.sequence.store(pos + _capacity, std::memory_order_release);
+        _dequeuePos.store(pos + 1, std::memory_order_relaxed);
+        return value;
+    }
+
+    /**
+     * @brief API to get the number of the values in the ring, which is
+     *        approximate while the producers are pushing.
+     */
+    size_t size() const
+    {
+        const size_t enqueuePos = _enqueuePos.load(std::memory_order_relaxed);
+        const size_t dequeuePos = _dequeuePos.load(std::memory_order_relaxed);
+        return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+    }
+
+    /**
+     * @brief API to check whether the ring is empty.
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /**
+     * @brief API to get the number of slots.
+     */
+    size_t capacity() const
+    {
+        return _capacity;
+    }
+
+    /**
+     * @brief API to get the highest occupancy seen so far.
+     */
+    size_t highWatermark() const
+    {
+        return _highWatermark.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief API to get the number of the values dropped as the ring was
+     *        full.
+     */
+    uint64_t overflows() const
+    {
+        return _overflows.load(std::memory_order_relaxed);
+    }
+
+  private:
+    /**
+     * @brief A slot of the ring along with its sequence number.
+     */
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    /**
+     * @brief The number of slots, a power of two.
+     */
+    const size_t _capacity;
+
+    /**
+     * @brief The slots.
+     */
+    std::unique_ptr<Slot[]> _slots;
+
+    /**
+     * @brief The position of the next push, kept on its own cache line as
+     *        the producers contend on it.
+     */
+    alignas(64) std::atomic<size_t> _enqueuePos{0};
+
+    /**
+     * @brief The position of the next pop.
+     */
+    alignas(64) std::atomic<size_t> _dequeuePos{0};
+
+    /**
+     * @brief The highest occupancy seen so far.
+     */
+    std::atomic<size_t> _highWatermark{0};
+
+    /**
+     * @brief The number of the values dropped as the ring was full.
+     */
+    std::atomic<uint64_t> _overflows{0};
+};
+
+} // namespace data_sync::utility
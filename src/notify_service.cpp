@@ -5,6 +5,8 @@
 #include "notify_service.hpp"
 
 #include "external_data_ifaces.hpp"
+#include "tracing.hpp"
+#include "worker_pool.hpp"
 
 #include <nlohmann/json.hpp>
 #include <phosphor-logging/lg2.hpp>
@@ -81,17 +83,40 @@ sdbusplus::async::task<>
 {
     const auto services = notifyRqstJson["NotifyInfo"]["NotifyServices"]
                               .get<std::vector<std::string>>();
-    const std::string& modifiedPath =
+    std::string modifiedPath =
         notifyRqstJson["ModifiedDataPath"].get<std::string>();
+    if (notifyRqstJson.contains("ModifiedDataPaths"))
+    {
+        // The services are notified once for all the paths modified by a sync
+        modifiedPath +=
+            " (+" +
+            std::to_string(notifyRqstJson["ModifiedDataPaths"].size() - 1) +
+            " paths)";
+    }
     const std::string& systemdMethod =
         ((notifyRqstJson["NotifyInfo"]["Method"].get<std::string>()) == "Reload"
              ? "ReloadUnit"
              : "RestartUnit");
 
+    // Use the correlation id of the sibling if available, so that the restart
+    // can be matched with the change on the sibling BMC.
+    const auto correlationId =
+        notifyRqstJson.contains("CorrelationId")
+            ? notifyRqstJson["CorrelationId"].get<tracing::CorrelationId>()
+            : tracing::SpanTracer::instance().newCorrelationId();
+
     for (const auto& service : services)
     {
         // Will notify each service sequentially assuming they are dependent
-        bool result = co_await sendSystemdNotification(service, systemdMethod);
+        bool result{false};
+        {
+            tracing::ScopedSpan span(correlationId,
+                                     tracing::Stage::RemoteRestart,
+                                     service + " " + modifiedPath);
+            result = co_await sendSystemdNotification(service, systemdMethod);
+            span.setDetail(service + " " + modifiedPath +
+                           (result ? " Success" : " Failed"));
+        }
 
         // Create PEL if notify failed
         if (!result)
@@ -123,7 +148,10 @@ sdbusplus::async::task<> NotifyService::init(fs::path notifyFilePath)
     nlohmann::json notifyRqstJson{};
     try
     {
-        notifyRqstJson = file_operations::readFromFile(notifyFilePath);
+        notifyRqstJson = co_await worker::WorkerPool::instance().run(
+            _ctx, [notifyFilePath]() {
+            return file_operations::readFromFile(notifyFilePath);
+        });
     }
     catch (const std::exception& exc)
     {
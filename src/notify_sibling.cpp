@@ -64,15 +64,32 @@ fs::path writeToFile(const auto& jsonData)
 } // namespace file_operations
 
 NotifySibling::NotifySibling(const config::DataSyncConfig& dataSyncConfig,
-                             const fs::path& modifiedDataPath)
+                             const fs::path& modifiedDataPath,
+                             tracing::CorrelationId correlationId) :
+    NotifySibling(dataSyncConfig, std::vector<fs::path>{modifiedDataPath},
+                  correlationId)
+{}
+
+NotifySibling::NotifySibling(const config::DataSyncConfig& dataSyncConfig,
+                             const std::vector<fs::path>& modifiedDataPaths,
+                             tracing::CorrelationId correlationId)
 {
     try
     {
-        const fs::path& modifiedPath =
-            modifiedDataPath.empty() ? dataSyncConfig._path : modifiedDataPath;
+        std::vector<fs::path> modifiedPaths;
+        for (const auto& modifiedDataPath : modifiedDataPaths)
+        {
+            modifiedPaths.emplace_back(modifiedDataPath.empty()
+                                           ? dataSyncConfig._path
+                                           : modifiedDataPath);
+        }
+        if (modifiedPaths.empty())
+        {
+            modifiedPaths.emplace_back(dataSyncConfig._path);
+        }
 
-        nlohmann::json notifyInfoJson = frameNotifyReq(dataSyncConfig,
-                                                       modifiedPath);
+        nlohmann::json notifyInfoJson =
+            frameNotifyReq(dataSyncConfig, modifiedPaths, correlationId);
         _notifyInfoFile = file_operations::writeToFile(notifyInfoJson);
 
         lg2::debug(
@@ -92,18 +109,34 @@ fs::path NotifySibling::getNotifyFilePath() const
     return _notifyInfoFile;
 }
 
-nlohmann::json
-    NotifySibling::frameNotifyReq(const config::DataSyncConfig& dataSyncConfig,
-                                  const fs::path& modifiedDataPath)
+nlohmann::json NotifySibling::frameNotifyReq(
+    const config::DataSyncConfig& dataSyncConfig,
+    const std::vector<fs::path>& modifiedDataPaths,
+    tracing::CorrelationId correlationId)
 {
     try
     {
-        return nlohmann::json::object(
-            {{"ModifiedDataPath", modifiedDataPath},
+        auto notifyReq = nlohmann::json::object(
+            {{"ModifiedDataPath", modifiedDataPaths.front()},
              {"NotifyInfo",
               dataSyncConfig._notifySibling.has_value()
                   ? dataSyncConfig._notifySibling.value()._notifyReqInfo
                   : nullptr}});
+
+        // All the modified paths are carried when a sync modified more than
+        // one, the sibling still notifies each service only once.
+        if (modifiedDataPaths.size() > 1)
+        {
+            notifyReq["ModifiedDataPaths"] = modifiedDataPaths;
+        }
+
+        // Carry the correlation id to the sibling so that its service
+        // restart can be traced against the same change.
+        if (correlationId != 0)
+        {
+            notifyReq["CorrelationId"] = correlationId;
+        }
+        return notifyReq;
     }
     catch (const std::exception& e)
     {
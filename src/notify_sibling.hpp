@@ -3,8 +3,10 @@
 #pragma once
 
 #include "data_sync_config.hpp"
+#include "tracing.hpp"
 
 #include <filesystem>
+#include <vector>
 
 namespace data_sync::notify
 {
@@ -24,9 +26,27 @@ class NotifySibling
      * @param[in] dataSyncConfig - Reference to the DataSyncConfig object
      * @param[in] modifiedDataPath - The absolute path of the data which is
      *                               modified inside the configured path
+     * @param[in] correlationId - The correlation id of the modification to
+     *                            trace the sibling side handling against,
+     *                            0 if not available.
      */
     NotifySibling(const config::DataSyncConfig& dataSyncConfig,
-                  const fs::path& modifiedDataPath);
+                  const fs::path& modifiedDataPath,
+                  tracing::CorrelationId correlationId = 0);
+
+    /**
+     * @brief The constructor to notify the sibling once for the multiple
+     *        paths modified by a sync.
+     *
+     * @param[in] dataSyncConfig - Reference to the DataSyncConfig object
+     * @param[in] modifiedDataPaths - The absolute paths of the data which are
+     *                                modified inside the configured path
+     * @param[in] correlationId - The correlation id of the modification,
+     *                            0 if not available.
+     */
+    NotifySibling(const config::DataSyncConfig& dataSyncConfig,
+                  const std::vector<fs::path>& modifiedDataPaths,
+                  tracing::CorrelationId correlationId = 0);
 
     /**
      * @brief API which returns the notify file path
@@ -38,12 +58,14 @@ class NotifySibling
      * @brief API to frame the sibling notification request in JSON form.
      *
      * @param[in] dataSyncConfig - Reference to the DataSyncConfig object
-     * @param[in] modifiedDataPath - The absolute path of the data which is
-     *                               modified inside the configured path
+     * @param[in] modifiedDataPaths - The absolute paths of the data which are
+     *                                modified inside the configured path
+     * @param[in] correlationId - The correlation id of the modification
      */
     static nlohmann::json
         frameNotifyReq(const config::DataSyncConfig& dataSyncConfig,
-                       const fs::path& modifiedDataPath);
+                       const std::vector<fs::path>& modifiedDataPaths,
+                       tracing::CorrelationId correlationId);
 
     /**
      * @brief The path of the json file which contains the framed notify
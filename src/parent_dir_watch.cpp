@@ -0,0 +1,293 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "parent_dir_watch.hpp"
+
+#include "watch_budget.hpp"
+
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <array>
+#include <cstring>
+
+namespace data_sync::watch::inotify
+{
+
+namespace
+{
+
+/**
+ * @brief The maximum number of moved hidden files remembered, the moves
+ *        without a matching IN_MOVED_TO are forgotten beyond it.
+ */
+constexpr size_t maxHiddenMoveCookies = 128;
+
+} // namespace
+
+FileSubscription::FileSubscription(sdbusplus::async::context& ctx,
+                                   fs::path file) :
+    _file(std::move(file)), _eventFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+{
+    if (_eventFd() == -1)
+    {
+        throw std::runtime_error("eventfd failed for " + _file.string());
+    }
+    _fdioInstance = std::make_unique<sdbusplus::async::fdio>(ctx, _eventFd());
+}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<std::optional<DataOperations>>
+    FileSubscription::onDataChange()
+{
+    while (_dataOperations.empty() && !_closed && !_wokenUp)
+    {
+        // NOLINTNEXTLINE
+        co_await _fdioInstance->next();
+
+        uint64_t count{0};
+        [[maybe_unused]] auto rc = read(_eventFd(), &count, sizeof(count));
+    }
+    _wokenUp = false;
+
+    if (_dataOperations.empty())
+    {
+        co_return _closed ? std::nullopt
+                          : std::make_optional<DataOperations>();
+    }
+    co_return takeDataOperations();
+}
+
+void FileSubscription::push(DataOps dataOp)
+{
+    // The earlier changes are superseded, the file is synced as it is now
+    _dataOperations.clear();
+    _dataOperations.emplace_back(_file, dataOp);
+    notify();
+}
+
+void FileSubscription::close()
+{
+    _closed = true;
+    notify();
+}
+
+void FileSubscription::wakeUp()
+{
+    _wokenUp = true;
+    notify();
+}
+
+DataOperations FileSubscription::takeDataOperations()
+{
+    return std::exchange(_dataOperations, {});
+}
+
+void FileSubscription::notify()
+{
+    uint64_t count{1};
+    [[maybe_unused]] auto rc = write(_eventFd(), &count, sizeof(count));
+}
+
+ParentDirWatch::ParentDirWatch(sdbusplus::async::context& ctx, fs::path dir) :
+    _ctx(ctx), _dir(std::move(dir)),
+    _inotifyFileDescriptor(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+{
+    if (_inotifyFileDescriptor() == -1)
+    {
+        throw std::runtime_error("inotify_init1 failed for " + _dir.string());
+    }
+
+    if (!WatchBudget::instance().tryAcquire())
+    {
+        throw std::runtime_error("No inotify watch available for " +
+                                 _dir.string());
+    }
+
+    auto wd = inotify_add_watch(_inotifyFileDescriptor(), _dir.c_str(),
+                                eventMasks | IN_ONLYDIR);
+    if (wd == -1)
+    {
+        WatchBudget::instance().release();
+        lg2::error("inotify_add_watch call failed for {PATH} with ErrNo : "
+                   "{ERRNO}, ErrMsg : {ERRMSG}",
+                   "PATH", _dir, "ERRNO", errno, "ERRMSG", strerror(errno));
+        throw std::runtime_error("Failed to watch " + _dir.string());
+    }
+    _watchDescriptor = wd;
+    lg2::debug("Watching {PATH} for its configured files, wd : {WD}", "PATH",
+               _dir, "WD", wd);
+}
+
+ParentDirWatch::~ParentDirWatch()
+{
+    if (_watchDescriptor.has_value())
+    {
+        inotify_rm_watch(_inotifyFileDescriptor(), *_watchDescriptor);
+        WatchBudget::instance().release();
+    }
+}
+
+std::shared_ptr<FileSubscription>
+    ParentDirWatch::subscribe(const fs::path& file)
+{
+    auto subscription = std::make_shared<FileSubscription>(_ctx, file);
+    if (!isWatching())
+    {
+        subscription->close();
+        return subscription;
+    }
+
+    // The unsubscribed files are cleaned up on the way
+    std::erase_if(_subscriptions, [](const auto& entry) {
+        return entry.second.expired();
+    });
+    _subscriptions.emplace(file.filename().string(), subscription);
+    return subscription;
+}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<> ParentDirWatch::run()
+{
+    sdbusplus::async::fdio fdioInstance(_ctx, _inotifyFileDescriptor());
+
+    // Enough for a burst of the events of the files in the directory
+    constexpr size_t bufferSize = 16 * (sizeof(struct inotify_event) +
+                                        NAME_MAX + 1);
+    alignas(struct inotify_event) std::array<uint8_t, bufferSize> buffer{};
+
+    while (!_ctx.stop_requested() && isWatching())
+    {
+        // NOLINTNEXTLINE
+        co_await fdioInstance.next();
+
+        auto bytes = read(_inotifyFileDescriptor(), buffer.data(),
+                          buffer.size());
+        if (bytes < 0)
+        {
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                lg2::error("Failed to read the inotify events of {PATH}, "
+                           "ErrNo : {ERRNO}, ErrMsg : {ERRMSG}",
+                           "PATH", _dir, "ERRNO", errno, "ERRMSG",
+                           strerror(errno));
+                stopWatching();
+            }
+            continue;
+        }
+        dispatch(parseEvents(std::span<const uint8_t>(
+            buffer.data(), static_cast<size_t>(bytes))));
+    }
+    co_return;
+}
+
+void ParentDirWatch::dispatch(const std::vector<EventInfo>& events)
+{
+    for (const auto& [wd, baseName, eventMask, cookie] : events)
+    {
+        if ((eventMask & IN_Q_OVERFLOW) != 0)
+        {
+            // The changes are unknown, hence sync the files as they are now
+            lg2::warning("Inotify event queue overflowed for {PATH}", "PATH",
+                         _dir);
+            for (const auto& [_, subscription] : _subscriptions)
+            {
+                if (auto file = subscription.lock(); file)
+                {
+                    file->push(fs::exists(file->getFile()) ? DataOps::COPY
+                                                           : DataOps::DELETE);
+                }
+            }
+            continue;
+        }
+
+        if (baseName.empty())
+        {
+            if ((eventMask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) !=
+                0)
+            {
+                // The files are watched by themselves from now on, which
+                // takes care of watching the directory once it is back.
+                lg2::info("{PATH} is removed or moved, the files in it are "
+                          "watched separately",
+                          "PATH", _dir);
+                stopWatching();
+                return;
+            }
+            continue;
+        }
+
+        if (baseName.starts_with("."))
+        {
+            // rsync updates a file by renaming its hidden temporary copy
+            if ((eventMask & IN_MOVED_FROM) != 0)
+            {
+                if (_hiddenMoveCookies.size() >= maxHiddenMoveCookies)
+                {
+                    _hiddenMoveCookies.clear();
+                }
+                _hiddenMoveCookies.insert(cookie);
+            }
+            continue;
+        }
+
+        std::optional<DataOps> dataOp;
+        if ((eventMask & IN_MOVED_TO) != 0)
+        {
+            if (_hiddenMoveCookies.erase(cookie) != 0)
+            {
+                lg2::debug("Ignoring the IN_MOVED_TO for {PATH} as update is "
+                           "done by RSYNC",
+                           "PATH", _dir / baseName);
+                continue;
+            }
+            dataOp = DataOps::COPY;
+        }
+        else if ((eventMask & IN_CLOSE_WRITE) != 0)
+        {
+            dataOp = DataOps::COPY;
+        }
+        else if ((eventMask & (IN_MOVED_FROM | IN_DELETE)) != 0 &&
+                 (eventMask & IN_ISDIR) == 0)
+        {
+            dataOp = DataOps::DELETE;
+        }
+        if (!dataOp.has_value())
+        {
+            continue;
+        }
+
+        auto [first, last] = _subscriptions.equal_range(baseName);
+        for (const auto& [_, subscription] : std::ranges::subrange(first, last))
+        {
+            if (auto file = subscription.lock(); file)
+            {
+                file->push(*dataOp);
+            }
+        }
+    }
+}
+
+void ParentDirWatch::stopWatching()
+{
+    if (_watchDescriptor.has_value())
+    {
+        // The kernel might have removed it already, which is harmless
+        inotify_rm_watch(_inotifyFileDescriptor(), *_watchDescriptor);
+        WatchBudget::instance().release();
+        _watchDescriptor.reset();
+    }
+
+    for (const auto& [_, subscription] : _subscriptions)
+    {
+        if (auto file = subscription.lock(); file)
+        {
+            file->close();
+        }
+    }
+    _subscriptions.clear();
+}
+
+} // namespace data_sync::watch::inotify
@@ -0,0 +1,252 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "data_watcher.hpp"
+#include "inotify_reader.hpp"
+#include "utility.hpp"
+
+#include <sdbusplus/async.hpp>
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace data_sync::watch::inotify
+{
+
+namespace fs = std::filesystem;
+
+/**
+ * @class FileSubscription
+ *
+ * @brief The changes of a configured file, received through the watch of its
+ *        parent directory.
+ */
+class FileSubscription
+{
+  public:
+    FileSubscription(const FileSubscription&) = delete;
+    FileSubscription& operator=(const FileSubscription&) = delete;
+    FileSubscription(FileSubscription&&) = delete;
+    FileSubscription& operator=(FileSubscription&&) = delete;
+    ~FileSubscription() = default;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] ctx - The async context object
+     * @param[in] file - The configured file
+     */
+    FileSubscription(sdbusplus::async::context& ctx, fs::path file);
+
+    /**
+     * @brief API to wait for the changes of the file.
+     *
+     * @returns The data operations for the changes, or std::nullopt if the
+     *          parent directory watch is gone and the file needs to be
+     *          watched by itself.
+     */
+    // NOLINTNEXTLINE
+    sdbusplus::async::task<std::optional<DataOperations>> onDataChange();
+
+    /**
+     * @brief API to queue a change of the file, only the last change is kept
+     *        until it is taken.
+     *
+     * @param[in] dataOp - The operation for the change
+     */
+    void push(DataOps dataOp);
+
+    /**
+     * @brief API to indicate that the parent directory watch is gone.
+     */
+    void close();
+
+    /**
+     * @brief API to wake up the waiting onDataChange() without any change,
+     *        which returns no data operations then. Eg: to stop waiting
+     *        right away rather than upon the next change.
+     */
+    void wakeUp();
+
+    /**
+     * @brief API to take the queued changes of the file.
+     */
+    DataOperations takeDataOperations();
+
+    /**
+     * @brief API to check whether the parent directory watch is gone.
+     */
+    bool isClosed() const
+    {
+        return _closed;
+    }
+
+    /**
+     * @brief API to get the configured file.
+     */
+    const fs::path& getFile() const
+    {
+        return _file;
+    }
+
+  private:
+    /**
+     * @brief API to signal the waiting onDataChange().
+     */
+    void notify();
+
+    /**
+     * @brief The configured file.
+     */
+    fs::path _file;
+
+    /**
+     * @brief Signalled when a change is queued or the watch is gone.
+     */
+    utility::FD _eventFd;
+
+    /**
+     * @brief The instance to wait on the eventfd.
+     */
+    std::unique_ptr<sdbusplus::async::fdio> _fdioInstance;
+
+    /**
+     * @brief The queued changes.
+     */
+    DataOperations _dataOperations;
+
+    /**
+     * @brief Indicates the parent directory watch is gone.
+     */
+    bool _closed{false};
+
+    /**
+     * @brief Indicates the waiting onDataChange() is woken up without any
+     *        change.
+     */
+    bool _wokenUp{false};
+};
+
+/**
+ * @class ParentDirWatch
+ *
+ * @brief Watches a directory once for all the configured files in it, and
+ *        routes the events to the files by their basename.
+ *
+ * The writers which save a file by renaming a temporary file over it replace
+ * the inode of the file, which costs the watches of the file itself to be
+ * removed and added again on every save. The directory watch stays the same,
+ * and such a save is a single IN_MOVED_TO event.
+ */
+class ParentDirWatch
+{
+  public:
+    /**
+     * @brief The events watched on the directory.
+     */
+    static constexpr uint32_t eventMasks = IN_CLOSE_WRITE | IN_MOVE |
+                                           IN_DELETE | IN_DELETE_SELF |
+                                           IN_MOVE_SELF;
+
+    ParentDirWatch(const ParentDirWatch&) = delete;
+    ParentDirWatch& operator=(const ParentDirWatch&) = delete;
+    ParentDirWatch(ParentDirWatch&&) = delete;
+    ParentDirWatch& operator=(ParentDirWatch&&) = delete;
+    ~ParentDirWatch();
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] ctx - The async context object
+     * @param[in] dir - The directory to watch
+     *
+     * @throws std::runtime_error if the directory can't be watched
+     */
+    ParentDirWatch(sdbusplus::async::context& ctx, fs::path dir);
+
+    /**
+     * @brief API to subscribe to the changes of a file in the directory.
+     *
+     * @param[in] file - The configured file
+     *
+     * @returns The subscription, valid until the directory watch is gone.
+     */
+    std::shared_ptr<FileSubscription> subscribe(const fs::path& file);
+
+    /**
+     * @brief API to read and route the events until the context is stopped
+     *        or the directory watch is gone.
+     */
+    // NOLINTNEXTLINE
+    sdbusplus::async::task<> run();
+
+    /**
+     * @brief API to route the given events to the subscribed files, also
+     *        used to replay the events.
+     *
+     * @param[in] events - The events received for the directory
+     */
+    void dispatch(const std::vector<EventInfo>& events);
+
+    /**
+     * @brief API to check whether the directory is still watched.
+     */
+    bool isWatching() const
+    {
+        return _watchDescriptor.has_value();
+    }
+
+    /**
+     * @brief API to get the watched directory.
+     */
+    const fs::path& getDir() const
+    {
+        return _dir;
+    }
+
+  private:
+    /**
+     * @brief API to stop routing the events, for the subscribed files to be
+     *        watched by themselves.
+     */
+    void stopWatching();
+
+    /**
+     * @brief The async context object.
+     */
+    sdbusplus::async::context& _ctx;
+
+    /**
+     * @brief The watched directory.
+     */
+    fs::path _dir;
+
+    /**
+     * @brief The inotify fd of the directory watch.
+     */
+    utility::FD _inotifyFileDescriptor;
+
+    /**
+     * @brief The directory watch, unset once it is gone.
+     */
+    std::optional<WD> _watchDescriptor;
+
+    /**
+     * @brief The subscribed files by their basename.
+     */
+    std::multimap<std::string, std::weak_ptr<FileSubscription>> _subscriptions;
+
+    /**
+     * @brief The cookies of the hidden files moved, to skip the IN_MOVED_TO
+     *        of the files updated by rsync.
+     */
+    std::set<Cookie> _hiddenMoveCookies;
+};
+
+} // namespace data_sync::watch::inotify
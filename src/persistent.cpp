@@ -11,6 +11,8 @@ namespace data_sync::persist
 {
 std::filesystem::path DBusPropDataFile =
     "/var/lib/phosphor-data-sync/persistence/dbus_props.json";
+std::filesystem::path ChangeJournalFile =
+    "/var/lib/phosphor-data-sync/persistence/change_journal.log";
 
 std::optional<nlohmann::json> readFile(const std::filesystem::path& path)
 {
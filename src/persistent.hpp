@@ -11,6 +11,7 @@ namespace data_sync::persist
 {
 
 extern std::filesystem::path DBusPropDataFile;
+extern std::filesystem::path ChangeJournalFile;
 
 namespace key
 {
@@ -4,19 +4,67 @@
 
 #include "external_data_ifaces_impl.hpp"
 #include "manager.hpp"
+#include "tracing.hpp"
 #include "utility.hpp"
 
+#include <getopt.h>
+
 #include <phosphor-logging/lg2.hpp>
 #include <sdbusplus/async/context.hpp>
 #include <sdbusplus/server/manager.hpp>
 #include <xyz/openbmc_project/Control/SyncBMCData/common.hpp>
 
+#include <array>
 #include <filesystem>
+#include <optional>
+#include <string>
 
-int main()
+int main(int argc, char** argv)
 {
     namespace fs = std::filesystem;
 
+    // Blocked before the async context and the worker threads are created,
+    // as the threads inherit the signal mask.
+    data_sync::tracing::blockExportSignal();
+
+    // A recorded inotify trace can be replayed once the sync events are
+    // started, to reproduce the event handling offline.
+    // Eg: --replay-trace <trace file> --replay-speed 10
+    std::optional<fs::path> replayTrace;
+    double replaySpeed{1.0};
+
+    const std::array<option, 3> options{
+        {{"replay-trace", required_argument, nullptr, 't'},
+         {"replay-speed", required_argument, nullptr, 's'},
+         {nullptr, 0, nullptr, 0}}};
+    int arg{0};
+    while ((arg = getopt_long(argc, argv, "t:s:", options.data(), nullptr)) !=
+           -1)
+    {
+        try
+        {
+            switch (arg)
+            {
+                case 't':
+                    replayTrace = optarg;
+                    break;
+                case 's':
+                    replaySpeed = std::stod(optarg);
+                    break;
+                default:
+                    return EXIT_FAILURE;
+            }
+        }
+        catch (const std::exception& exc)
+        {
+            lg2::error("Invalid value [{VALUE}] for the option {OPTION}, "
+                       "Err : {ERROR}",
+                       "VALUE", optarg, "OPTION",
+                       std::string(1, static_cast<char>(arg)), "ERROR", exc);
+            return EXIT_FAILURE;
+        }
+    }
+
     using SyncBMCData =
         sdbusplus::common::xyz::openbmc_project::control::SyncBMCData;
 
@@ -45,10 +93,18 @@ int main()
     sdbusplus::async::context ctx;
     sdbusplus::server::manager_t objManager{ctx, SyncBMCData::instance_path};
 
+    // Export the trace spans upon SIGUSR1 (Eg: kill -USR1 <pid>)
+    ctx.spawn(data_sync::tracing::exportOnSignal(ctx, SPAN_TRACE_FILE));
+
     data_sync::Manager manager{
         ctx, std::make_unique<data_sync::ext_data::ExternalDataIFacesImpl>(ctx),
         DATA_SYNC_CONFIG_DIR};
 
+    if (replayTrace.has_value())
+    {
+        manager.replayEventTraceOnStart(*replayTrace, replaySpeed);
+    }
+
     // clang-tidy currently mangles this into something unreadable
     // NOLINTNEXTLINE
     ctx.spawn([](sdbusplus::async::context& ctx) -> sdbusplus::async::task<> {
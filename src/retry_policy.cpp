@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "retry_policy.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <random>
+
+namespace data_sync::retry
+{
+
+std::chrono::milliseconds backoff(std::chrono::seconds baseInterval,
+                                  size_t attempt)
+{
+    using std::chrono::milliseconds;
+
+    // Bound the shift as well to avoid the overflow
+    constexpr size_t maxShift = 16;
+    const size_t shift = std::min(attempt == 0 ? 0 : attempt - 1, maxShift);
+
+    const milliseconds wait = std::min<milliseconds>(
+        std::chrono::duration_cast<milliseconds>(baseInterval) * (1U << shift),
+        maxBackoff);
+    if (wait.count() <= 1)
+    {
+        return wait;
+    }
+
+    static std::mt19937 generator{std::random_device{}()};
+    std::uniform_int_distribution<milliseconds::rep> jitter(0,
+                                                            wait.count() / 2);
+    return wait - milliseconds(jitter(generator));
+}
+
+bool isLinkFailure(int errCode) noexcept
+{
+    switch (errCode)
+    {
+        case 5:  // error starting client-server protocol
+        case 10: // error in socket I/O
+        case 12: // error in rsync protocol data stream
+        case 30: // timeout in data send/receive
+        case 35: // timeout waiting for daemon connection
+            return true;
+        default:
+            return false;
+    }
+}
+
+CircuitBreaker::CircuitBreaker(size_t failureThreshold,
+                               std::chrono::seconds cooldown) :
+    _failureThreshold(failureThreshold), _cooldown(cooldown)
+{}
+
+bool CircuitBreaker::allowRequest(Clock::time_point now)
+{
+    if (_state == State::Closed)
+    {
+        return true;
+    }
+
+    if (now - _lastTransition < _cooldown)
+    {
+        return false;
+    }
+
+    if (_state == State::Open)
+    {
+        lg2::info("Probing the sibling BMC connection after the cooldown");
+    }
+    _state = State::HalfOpen;
+    _lastTransition = now;
+    return true;
+}
+
+bool CircuitBreaker::recordSuccess()
+{
+    _consecutiveFailures = 0;
+    if (_state == State::Closed)
+    {
+        return false;
+    }
+
+    lg2::info("The sibling BMC connection is restored, resuming the syncs");
+    _state = State::Closed;
+    return true;
+}
+
+bool CircuitBreaker::recordFailure(Clock::time_point now)
+{
+    ++_consecutiveFailures;
+    if (_state == State::Closed && _consecutiveFailures < _failureThreshold)
+    {
+        return false;
+    }
+
+    // The failures of the syncs which were in flight while opening don't
+    // extend the cooldown.
+    if (_state == State::Open)
+    {
+        return false;
+    }
+
+    const bool opened = (_state == State::Closed);
+    if (opened)
+    {
+        lg2::warning("The sibling BMC connection failed {COUNT} times in a "
+                     "row, deferring the syncs for {COOLDOWN}s",
+                     "COUNT", _consecutiveFailures, "COOLDOWN",
+                     _cooldown.count());
+    }
+    _state = State::Open;
+    _lastTransition = now;
+    return opened;
+}
+
+} // namespace data_sync::retry
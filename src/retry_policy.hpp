@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace data_sync::retry
+{
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief The upper bound of the backoff between the retries.
+ */
+constexpr auto maxBackoff = std::chrono::minutes(5);
+
+/**
+ * @brief API to get the wait before the given retry attempt.
+ *
+ *        The wait doubles on every attempt starting from the base interval,
+ *        bounded by the maxBackoff, and a random jitter of up to half of the
+ *        wait is subtracted so that the paths failed together don't retry in
+ *        lockstep.
+ *
+ * @param[in] baseInterval - The configured retry interval
+ * @param[in] attempt - The retry attempt, starting from 1
+ *
+ * @return The wait before the retry attempt.
+ */
+std::chrono::milliseconds backoff(std::chrono::seconds baseInterval,
+                                  size_t attempt);
+
+/**
+ * @brief API to check whether the rsync error indicates that the sibling BMC
+ *        is not reachable, as opposed to the errors of the synced data.
+ *
+ * @param[in] errCode - The rsync exit code
+ *
+ * @return True if it is a connection failure; otherwise False.
+ */
+bool isLinkFailure(int errCode) noexcept;
+
+/**
+ * @class CircuitBreaker
+ *
+ * @brief Stops the syncs towards the sibling BMC once the connection
+ *        failures are seen consecutively, to keep the rsync spawns bounded
+ *        during an outage.
+ *
+ *        - Closed: The syncs are allowed. Moves to Open after the failure
+ *          threshold number of consecutive connection failures.
+ *        - Open: The syncs are not allowed. Moves to HalfOpen once the
+ *          cooldown elapsed, by allowing a single probe sync.
+ *        - HalfOpen: Only the probe sync is in progress. Moves to Closed if
+ *          it succeeds, and back to Open if it fails.
+ */
+class CircuitBreaker
+{
+  public:
+    enum class State
+    {
+        Closed,
+        Open,
+        HalfOpen
+    };
+
+    /**
+     * @brief The default number of consecutive connection failures to open
+     *        the circuit.
+     */
+    static constexpr size_t defaultFailureThreshold = 5;
+
+    CircuitBreaker(const CircuitBreaker&) = delete;
+    CircuitBreaker& operator=(const CircuitBreaker&) = delete;
+    CircuitBreaker(CircuitBreaker&&) = delete;
+    CircuitBreaker& operator=(CircuitBreaker&&) = delete;
+    ~CircuitBreaker() = default;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] failureThreshold - The number of consecutive connection
+     *                               failures to open the circuit
+     * @param[in] cooldown - The time to wait before probing once opened
+     */
+    CircuitBreaker(size_t failureThreshold, std::chrono::seconds cooldown);
+
+    /**
+     * @brief API to check whether a sync is allowed.
+     *
+     *        If the cooldown is elapsed while open, the caller is allowed as
+     *        the probe. A probe which didn't report its result within the
+     *        cooldown is considered lost, and another probe is allowed.
+     *
+     * @param[in] now - The current time
+     *
+     * @return True if allowed; otherwise False.
+     */
+    bool allowRequest(Clock::time_point now = Clock::now());
+
+    /**
+     * @brief API to record that the sibling BMC was reachable.
+     *
+     * @return True if the circuit got closed by this; otherwise False.
+     */
+    bool recordSuccess();
+
+    /**
+     * @brief API to record a connection failure.
+     *
+     * @param[in] now - The current time
+     *
+     * @return True if the circuit got opened from the Closed state by this;
+     *         otherwise False.
+     */
+    bool recordFailure(Clock::time_point now = Clock::now());
+
+    /**
+     * @brief API to get the current state.
+     */
+    State getState() const
+    {
+        return _state;
+    }
+
+    /**
+     * @brief API to check whether the syncs are stopped, i.e. not Closed.
+     */
+    bool isOpen() const
+    {
+        return _state != State::Closed;
+    }
+
+    /**
+     * @brief API to get the time to wait before probing once opened.
+     */
+    std::chrono::seconds getCooldown() const
+    {
+        return _cooldown;
+    }
+
+  private:
+    /**
+     * @brief The number of consecutive connection failures to open.
+     */
+    size_t _failureThreshold;
+
+    /**
+     * @brief The time to wait before probing once opened.
+     */
+    std::chrono::seconds _cooldown;
+
+    /**
+     * @brief The current state.
+     */
+    State _state{State::Closed};
+
+    /**
+     * @brief The number of consecutive connection failures.
+     */
+    size_t _consecutiveFailures{0};
+
+    /**
+     * @brief The time of opening the circuit or allowing the last probe.
+     */
+    Clock::time_point _lastTransition;
+};
+
+} // namespace data_sync::retry
@@ -0,0 +1,260 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "rsync_output_parser.hpp"
+
+#include "utility.hpp"
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace data_sync::utility::rsync
+{
+
+namespace
+{
+
+/**
+ * @brief The width of the itemized change summary, followed by a space and
+ *        the path. Eg: ">f+++++++++ var/lib/file"
+ */
+constexpr size_t summaryWidth = 11;
+
+/**
+ * @brief The update types and the file types of the itemized changes.
+ */
+constexpr std::string_view updateTypes{"<>ch."};
+constexpr std::string_view fileTypes{"fdLDS"};
+
+/**
+ * @brief The stats keys of the counters, as printed by --stats. The older
+ *        rsync prints "Number of files transferred".
+ */
+constexpr std::string_view filesTransferredKey{
+    "Number of regular files transferred"};
+constexpr std::string_view oldFilesTransferredKey{
+    "Number of files transferred"};
+constexpr std::string_view deletedFilesKey{"Number of deleted files"};
+constexpr std::string_view literalDataKey{"Literal data"};
+constexpr std::string_view matchedDataKey{"Matched data"};
+
+/**
+ * @brief The multipliers of the --human-readable unit suffixes, which are
+ *        in the units of 1000 with a single -h.
+ */
+constexpr std::array<std::pair<char, uintmax_t>, 5> unitSuffixes{{
+    {'K', 1000ULL},
+    {'M', 1000ULL * 1000},
+    {'G', 1000ULL * 1000 * 1000},
+    {'T', 1000ULL * 1000 * 1000 * 1000},
+    {'P', 1000ULL * 1000 * 1000 * 1000 * 1000},
+}};
+
+bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * @brief Helper to check whether the itemized change changed the data of the
+ *        path under the given root.
+ *
+ * @param[in] change - The itemized change
+ * @param[in] root - The relative root without the trailing slash
+ * @param[in] dataSent - Whether the transfer sent any file data
+ */
+bool isDataChangedUnder(const ItemizedChange& change, const fs::path& root,
+                        bool dataSent)
+{
+    // The attributes are updated along with the data transfer, hence only a
+    // transfer which sent the data changed the data.
+    if (!change.isDeleted() && !(change.isTransferred() && dataSent))
+    {
+        return false;
+    }
+    return isSameOrChildOf(change.path, root);
+}
+
+} // namespace
+
+bool TransferStats::hasChangesUnder(const fs::path& path) const
+{
+    if (changesTruncated)
+    {
+        return literalBytes != 0 || deletions != 0;
+    }
+
+    // The itemized paths are relative to the root with --relative
+    const auto root = withoutTrailingSlash(path.relative_path());
+    return std::ranges::any_of(changes, [this, &root](const auto& change) {
+        return isDataChangedUnder(change, root, literalBytes != 0);
+    });
+}
+
+std::vector<fs::path>
+    TransferStats::getChangedPathsUnder(const fs::path& path) const
+{
+    const auto root = withoutTrailingSlash(path.relative_path());
+    std::vector<fs::path> changedPaths;
+    for (const auto& change : changes)
+    {
+        if (isDataChangedUnder(change, root, literalBytes != 0))
+        {
+            changedPaths.emplace_back(fs::path("/") /
+                                      withoutTrailingSlash(change.path));
+        }
+    }
+    return changedPaths;
+}
+
+std::optional<uintmax_t> OutputParser::parseNumber(std::string_view value)
+{
+    while (!value.empty() && value.front() == ' ')
+    {
+        value.remove_prefix(1);
+    }
+    if (value.empty() || !isDigit(value.front()))
+    {
+        return std::nullopt;
+    }
+
+    uintmax_t integral{0};
+    uintmax_t fraction{0};
+    uintmax_t fractionScale{1};
+    bool inFraction{false};
+    size_t pos{0};
+    for (; pos < value.size(); ++pos)
+    {
+        const char c = value[pos];
+        if (isDigit(c))
+        {
+            if (inFraction)
+            {
+                fraction = fraction * 10 + static_cast<uintmax_t>(c - '0');
+                fractionScale *= 10;
+            }
+            else
+            {
+                integral = integral * 10 + static_cast<uintmax_t>(c - '0');
+            }
+        }
+        else if (c == ',' && !inFraction)
+        {
+            // The digit separator
+            continue;
+        }
+        else if (c == '.' && !inFraction)
+        {
+            inFraction = true;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    uintmax_t multiplier{1};
+    if (pos < value.size())
+    {
+        for (const auto& [suffix, unit] : unitSuffixes)
+        {
+            if (value[pos] == suffix)
+            {
+                multiplier = unit;
+                break;
+            }
+        }
+    }
+    return integral * multiplier + fraction * multiplier / fractionScale;
+}
+
+void OutputParser::feed(std::string_view chunk)
+{
+    for (auto newline = chunk.find('\n'); newline != std::string_view::npos;
+         newline = chunk.find('\n'))
+    {
+        if (_partialLine.empty())
+        {
+            parseLine(chunk.substr(0, newline));
+        }
+        else
+        {
+            _partialLine.append(chunk.substr(0, newline));
+            parseLine(_partialLine);
+            _partialLine.clear();
+        }
+        chunk.remove_prefix(newline + 1);
+    }
+    _partialLine.append(chunk);
+}
+
+void OutputParser::finish()
+{
+    if (!_partialLine.empty())
+    {
+        parseLine(_partialLine);
+        _partialLine.clear();
+    }
+}
+
+void OutputParser::parseLine(std::string_view line)
+{
+    if (line.ends_with('\r'))
+    {
+        line.remove_suffix(1);
+    }
+
+    // The itemized change, Eg: ">f.st...... var/lib/file"
+    if (line.size() > summaryWidth + 1 && line[summaryWidth] == ' ' &&
+        (line.starts_with("*deleting") ||
+         (updateTypes.contains(line[0]) && fileTypes.contains(line[1]))))
+    {
+        ItemizedChange change{std::string(line.substr(0, summaryWidth)),
+                              fs::path(line.substr(summaryWidth + 1))};
+        if (change.isDeleted() && !_deletionsReported)
+        {
+            ++_stats.deletions;
+        }
+        if (_stats.changes.size() < maxChanges)
+        {
+            _stats.changes.emplace_back(std::move(change));
+        }
+        else
+        {
+            _stats.changesTruncated = true;
+        }
+        return;
+    }
+
+    // The stats, Eg: "Literal data: 1,234 bytes"
+    auto separator = line.find(": ");
+    if (separator == std::string_view::npos)
+    {
+        return;
+    }
+    const auto key = line.substr(0, separator);
+    const auto number = parseNumber(line.substr(separator + 2));
+    if (!number.has_value())
+    {
+        return;
+    }
+
+    if (key == filesTransferredKey || key == oldFilesTransferredKey)
+    {
+        _stats.filesTransferred = static_cast<size_t>(*number);
+    }
+    else if (key == deletedFilesKey)
+    {
+        _stats.deletions = static_cast<size_t>(*number);
+        _deletionsReported = true;
+    }
+    else if (key == literalDataKey)
+    {
+        _stats.literalBytes = *number;
+    }
+    else if (key == matchedDataKey)
+    {
+        _stats.matchedBytes = *number;
+    }
+}
+
+} // namespace data_sync::utility::rsync
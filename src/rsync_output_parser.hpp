@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace data_sync::utility::rsync
+{
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief A path changed on the receiver, as itemized by rsync.
+ */
+struct ItemizedChange
+{
+    // The change summary, Eg: ">f.st......" or "*deleting"
+    std::string summary;
+
+    // The path as sent, relative to the root with --relative
+    fs::path path;
+
+    /**
+     * @brief API to check whether the path is deleted on the receiver.
+     */
+    bool isDeleted() const
+    {
+        return summary.starts_with("*deleting");
+    }
+
+    /**
+     * @brief API to check whether the path is transferred or created on the
+     *        receiver, rather than only its attributes updated.
+     */
+    bool isTransferred() const
+    {
+        return !summary.empty() && summary.front() != '.' && !isDeleted();
+    }
+};
+
+/**
+ * @brief The structured result of an rsync transfer.
+ */
+struct TransferStats
+{
+    // The number of the regular files transferred
+    size_t filesTransferred{0};
+
+    // The bytes of the file data sent as is
+    uintmax_t literalBytes{0};
+
+    // The bytes of the file data already present on the receiver
+    uintmax_t matchedBytes{0};
+
+    // The number of the paths deleted on the receiver
+    size_t deletions{0};
+
+    // The itemized changes, in the order rsync reported them
+    std::vector<ItemizedChange> changes;
+
+    // Whether more changes are reported than kept
+    bool changesTruncated{false};
+
+    /**
+     * @brief API to check whether the transfer changed the data of the given
+     *        path or the paths under it on the receiver, Eg: to notify only
+     *        the changed paths out of the ones synced together.
+     *
+     * @param[in] path - The absolute path synced with --relative
+     *
+     * @return True if the data is transferred or deleted; otherwise False.
+     */
+    bool hasChangesUnder(const fs::path& path) const;
+
+    /**
+     * @brief API to get the paths whose data is changed by the transfer on
+     *        the receiver, out of the given path and the paths under it.
+     *
+     * @param[in] path - The absolute path synced with --relative
+     *
+     * @return The absolute paths transferred or deleted, which are only the
+     *         kept ones if the changes are truncated.
+     */
+    std::vector<fs::path> getChangedPathsUnder(const fs::path& path) const;
+};
+
+/**
+ * @class OutputParser
+ *
+ * @brief Parses the --stats and --itemize-changes output of rsync as it is
+ *        read from the process, so that the whole output need not be kept to
+ *        find out what is transferred.
+ */
+class OutputParser
+{
+  public:
+    /**
+     * @brief The maximum number of the itemized changes kept.
+     */
+    static constexpr size_t maxChanges = 4096;
+
+    OutputParser() = default;
+    OutputParser(const OutputParser&) = delete;
+    OutputParser& operator=(const OutputParser&) = delete;
+    OutputParser(OutputParser&&) = delete;
+    OutputParser& operator=(OutputParser&&) = delete;
+    ~OutputParser() = default;
+
+    /**
+     * @brief API to parse the next chunk of the output, the lines split
+     *        across the chunks are parsed once completed.
+     *
+     * @param[in] chunk - The output read from the process
+     */
+    void feed(std::string_view chunk);
+
+    /**
+     * @brief API to parse the trailing line which has no newline, once the
+     *        whole output is read.
+     */
+    void finish();
+
+    /**
+     * @brief API to get the result parsed so far.
+     */
+    const TransferStats& getStats() const
+    {
+        return _stats;
+    }
+
+    /**
+     * @brief API to parse a number of the rsync stats, with the digit
+     *        separators (Eg: 1,234) or with the unit suffix (Eg: 1.23K) as
+     *        printed by --human-readable.
+     *
+     * @param[in] value - The text starting with the number
+     *
+     * @return The number, or std::nullopt if the text doesn't start with one.
+     */
+    static std::optional<uintmax_t> parseNumber(std::string_view value);
+
+  private:
+    /**
+     * @brief API to parse a complete line of the output.
+     *
+     * @param[in] line - The line without the newline
+     */
+    void parseLine(std::string_view line);
+
+    /**
+     * @brief The trailing partial line of the last chunk.
+     */
+    std::string _partialLine;
+
+    /**
+     * @brief Whether the deletions are reported in the stats, otherwise they
+     *        are counted from the itemized changes, Eg: by the older rsync.
+     */
+    bool _deletionsReported{false};
+
+    /**
+     * @brief The result parsed so far.
+     */
+    TransferStats _stats;
+};
+
+} // namespace data_sync::utility::rsync
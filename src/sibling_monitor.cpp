@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sibling_monitor.hpp"
+
+#include "utility.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+namespace data_sync::sibling
+{
+
+SiblingMonitor::SiblingMonitor(sdbusplus::async::context& ctx,
+                               std::string address, uint16_t port,
+                               std::chrono::milliseconds probeInterval,
+                               unsigned failureThreshold,
+                               AvailabilityChangedCallback callback) :
+    _ctx(ctx), _address(std::move(address)), _port(port),
+    _probeInterval(probeInterval),
+    _failureThreshold(std::max(failureThreshold, 1U)),
+    _callback(std::move(callback))
+{}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<> SiblingMonitor::run()
+{
+    while (!_ctx.stop_requested())
+    {
+        // NOLINTNEXTLINE
+        bool available = co_await probe();
+        if (available)
+        {
+            _failedProbes = 0;
+        }
+        else if (++_failedProbes < _failureThreshold)
+        {
+            // Not yet, as the probe may fail transiently.
+            available = _available;
+        }
+
+        if (available != _available)
+        {
+            _available = available;
+            if (_available)
+            {
+                lg2::info("The sibling BMC is available");
+            }
+            else
+            {
+                lg2::warning("The sibling BMC is not available, the syncs "
+                             "are deferred until it is available");
+            }
+
+            if (_callback)
+            {
+                _callback(_available);
+            }
+        }
+        co_await sdbusplus::async::sleep_for(_ctx, _probeInterval);
+    }
+    co_return;
+}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<bool> SiblingMonitor::probe()
+{
+    // The greeting is expected within the round trip to the sibling BMC.
+    constexpr auto probeTimeout = std::chrono::seconds(2);
+
+    utility::FD sock(
+        socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0));
+    if (sock() == -1)
+    {
+        lg2::error("Failed to create the probe socket, ErrNo : {ERRNO}, "
+                   "ErrMsg : {ERRMSG}",
+                   "ERRNO", errno, "ERRMSG", strerror(errno));
+        co_return false;
+    }
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(_port);
+    if (inet_pton(AF_INET, _address.c_str(), &addr.sin_addr) != 1)
+    {
+        lg2::error("Invalid sibling BMC address [{ADDRESS}]", "ADDRESS",
+                   _address);
+        co_return false;
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (connect(sock(), reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) ==
+            -1 &&
+        errno != EINPROGRESS)
+    {
+        co_return false;
+    }
+
+    // The socket turns readable on the greeting, or on the connection being
+    // refused or closed if the rsync daemon is not reachable.
+    sdbusplus::async::fdio fdioInstance(_ctx, sock(), probeTimeout);
+    std::string greeting;
+    const auto deadline = std::chrono::steady_clock::now() + probeTimeout;
+    while (!_ctx.stop_requested() &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+        try
+        {
+            // NOLINTNEXTLINE
+            co_await fdioInstance.next();
+        }
+        catch (const sdbusplus::exception::FdioTimeoutError&)
+        {
+            co_return false;
+        }
+
+        std::array<char, 64> buffer{};
+        auto bytes = read(sock(), buffer.data(), buffer.size());
+        if (bytes == -1 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            continue;
+        }
+        if (bytes <= 0)
+        {
+            co_return false;
+        }
+
+        greeting.append(buffer.data(), static_cast<size_t>(bytes));
+        if (greeting.size() >= rsyncdGreeting.size())
+        {
+            co_return greeting.starts_with(rsyncdGreeting);
+        }
+    }
+    co_return false;
+}
+
+} // namespace data_sync::sibling
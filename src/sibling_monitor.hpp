@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <sdbusplus/async.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace data_sync::sibling
+{
+
+/**
+ * @brief The callback to notify the sibling BMC availability changes.
+ */
+using AvailabilityChangedCallback = std::function<void(bool available)>;
+
+/**
+ * @brief The greeting which the rsync daemon sends on a new connection.
+ */
+constexpr std::string_view rsyncdGreeting{"@RSYNCD:"};
+
+/**
+ * @class SiblingMonitor
+ *
+ * @brief Monitors the sibling BMC availability by probing its rsync daemon
+ *        periodically, so that the syncs can fail fast instead of waiting
+ *        for the rsync connect timeout and the retries while the sibling BMC
+ *        is down.
+ *
+ * The rsync daemon of the sibling BMC is reached through the local stunnel
+ * port which accepts the connection even if the sibling BMC is down. Hence
+ * the sibling BMC is considered available only if the rsync daemon greeting
+ * is received. It is considered not available only after the given number of
+ * consecutive failed probes, so that a transient failure doesn't defer the
+ * syncs.
+ */
+class SiblingMonitor
+{
+  public:
+    SiblingMonitor(const SiblingMonitor&) = delete;
+    SiblingMonitor& operator=(const SiblingMonitor&) = delete;
+    SiblingMonitor(SiblingMonitor&&) = delete;
+    SiblingMonitor& operator=(SiblingMonitor&&) = delete;
+    ~SiblingMonitor() = default;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] ctx - The async context object
+     * @param[in] address - The IPv4 address to reach the sibling rsync daemon
+     * @param[in] port - The port to reach the sibling rsync daemon
+     * @param[in] probeInterval - The interval between the probes
+     * @param[in] failureThreshold - The number of consecutive failed probes
+     *                               to consider the sibling not available
+     * @param[in] callback - The callback to notify the availability changes
+     */
+    SiblingMonitor(sdbusplus::async::context& ctx, std::string address,
+                   uint16_t port, std::chrono::milliseconds probeInterval,
+                   unsigned failureThreshold,
+                   AvailabilityChangedCallback callback);
+
+    /**
+     * @brief API to get the sibling BMC availability as per the last probe.
+     *        The sibling BMC is considered available until the first probe.
+     */
+    bool isAvailable() const
+    {
+        return _available;
+    }
+
+    /**
+     * @brief API to probe the sibling BMC periodically until the context is
+     *        stopped.
+     */
+    sdbusplus::async::task<> run();
+
+    /**
+     * @brief API to probe the sibling rsync daemon once.
+     *
+     * @return True if the rsync daemon greeting is received within the probe
+     *         timeout; otherwise False.
+     */
+    sdbusplus::async::task<bool> probe();
+
+  private:
+    /**
+     * @brief The async context object.
+     */
+    sdbusplus::async::context& _ctx;
+
+    /**
+     * @brief The IPv4 address to reach the sibling rsync daemon.
+     */
+    std::string _address;
+
+    /**
+     * @brief The port to reach the sibling rsync daemon.
+     */
+    uint16_t _port;
+
+    /**
+     * @brief The interval between the probes.
+     */
+    std::chrono::milliseconds _probeInterval;
+
+    /**
+     * @brief The number of consecutive failed probes to consider the sibling
+     *        not available.
+     */
+    unsigned _failureThreshold;
+
+    /**
+     * @brief The number of consecutive failed probes so far.
+     */
+    unsigned _failedProbes{0};
+
+    /**
+     * @brief The callback to notify the availability changes.
+     */
+    AvailabilityChangedCallback _callback;
+
+    /**
+     * @brief The sibling BMC availability as per the last probe.
+     */
+    bool _available{true};
+};
+
+} // namespace data_sync::sibling
@@ -0,0 +1,272 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "subtree_scanner.hpp"
+
+#include "utility.hpp"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <set>
+
+namespace data_sync::watch::scan
+{
+
+namespace
+{
+
+/**
+ * @brief Helper to get the modification time and type of the given entry of
+ *        the directory, without following the symlinks.
+ */
+std::optional<std::pair<std::pair<int64_t, uint32_t>, bool>>
+    getMtime(int dirFd, const char* name)
+{
+    struct statx stx{};
+    if (statx(dirFd, name, AT_SYMLINK_NOFOLLOW | AT_EMPTY_PATH,
+              STATX_MTIME | STATX_TYPE, &stx) == -1)
+    {
+        return std::nullopt;
+    }
+    return std::make_pair(std::make_pair(static_cast<int64_t>(
+                                             stx.stx_mtime.tv_sec),
+                                         stx.stx_mtime.tv_nsec),
+                          S_ISDIR(stx.stx_mode));
+}
+
+} // namespace
+
+SubtreeScanner::SubtreeScanner(fs::path root, SkipPredicate isSkipped) :
+    _root(utility::withoutTrailingSlash(root)),
+    _isSkipped(std::move(isSkipped))
+{
+    std::error_code ec;
+    if (fs::is_directory(_root, ec))
+    {
+        scanDir(_root, nullptr);
+    }
+    else
+    {
+        scanFile(nullptr);
+    }
+}
+
+SubtreeScanner::Changes SubtreeScanner::scan()
+{
+    Changes changes;
+    _scannedEntries = 0;
+
+    std::error_code ec;
+    if (fs::is_directory(_root, ec))
+    {
+        if (_files.contains(_root))
+        {
+            // Replaced by a directory
+            _files.erase(_root);
+            changes.modified.emplace_back(_root / "");
+            scanDir(_root, nullptr);
+        }
+        else
+        {
+            scanDir(_root, &changes);
+        }
+    }
+    else
+    {
+        if (_dirs.contains(_root))
+        {
+            forget(_root);
+            changes.removed.emplace_back(_root);
+        }
+        scanFile(&changes);
+    }
+    return changes;
+}
+
+void SubtreeScanner::scanFile(Changes* changes)
+{
+    ++_scannedEntries;
+    auto mtime = getMtime(AT_FDCWD, _root.c_str());
+    auto known = _files.find(_root);
+    if (!mtime.has_value())
+    {
+        if (known != _files.end())
+        {
+            _files.erase(known);
+            if (changes != nullptr)
+            {
+                changes->removed.emplace_back(_root);
+            }
+        }
+        return;
+    }
+
+    if (known == _files.end() || known->second != mtime->first)
+    {
+        _files.insert_or_assign(_root, mtime->first);
+        if (changes != nullptr)
+        {
+            changes->modified.emplace_back(_root);
+        }
+    }
+}
+
+void SubtreeScanner::scanDir(const fs::path& dir, Changes* changes)
+{
+    utility::FD dirFd(open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (dirFd() == -1)
+    {
+        // Removed while scanning, reported by its parent in the next scan
+        return;
+    }
+
+    ++_scannedEntries;
+    auto dirMtime = getMtime(dirFd(), "");
+    if (!dirMtime.has_value())
+    {
+        return;
+    }
+
+    std::set<std::string> newEntries;
+    auto known = _dirs.find(dir);
+    if (known == _dirs.end() || known->second.mtime != dirMtime->first)
+    {
+        // The entries are changed, hence read the directory
+        auto entries = readDir(dirFd(), dir);
+        if (known != _dirs.end())
+        {
+            // Both are sorted, hence compared in a single pass.
+            std::vector<DirEntry> removedEntries;
+            std::ranges::set_difference(known->second.entries, entries,
+                                        std::back_inserter(removedEntries));
+            for (const auto& entry : removedEntries)
+            {
+                forget(dir / entry.first);
+                if (changes != nullptr)
+                {
+                    changes->removed.emplace_back(dir / entry.first);
+                }
+            }
+
+            std::vector<DirEntry> addedEntries;
+            std::ranges::set_difference(entries, known->second.entries,
+                                        std::back_inserter(addedEntries));
+            for (const auto& entry : addedEntries)
+            {
+                newEntries.insert(entry.first);
+                if (changes != nullptr)
+                {
+                    changes->modified.emplace_back(
+                        entry.second ? dir / entry.first / ""
+                                     : dir / entry.first);
+                }
+            }
+        }
+        known = _dirs.insert_or_assign(dir, DirState{dirMtime->first,
+                                                     std::move(entries)})
+                    .first;
+    }
+
+    // Copied as the recursion updates the map
+    const auto entries = known->second.entries;
+    for (const auto& [name, isDir] : entries)
+    {
+        // The new entries are reported already, along with their subtree
+        const bool isNew = newEntries.contains(name);
+        const auto path = dir / name;
+        if (isDir)
+        {
+            scanDir(path, isNew ? nullptr : changes);
+            continue;
+        }
+
+        ++_scannedEntries;
+        auto mtime = getMtime(dirFd(), name.c_str());
+        if (!mtime.has_value())
+        {
+            continue;
+        }
+        auto file = _files.find(path);
+        if (file == _files.end())
+        {
+            _files.emplace(path, mtime->first);
+        }
+        else if (file->second != mtime->first)
+        {
+            file->second = mtime->first;
+            if (changes != nullptr && !isNew)
+            {
+                changes->modified.emplace_back(path);
+            }
+        }
+    }
+}
+
+std::vector<SubtreeScanner::DirEntry>
+    SubtreeScanner::readDir(int dirFd, const fs::path& dir)
+{
+    std::vector<DirEntry> entries;
+    alignas(dirent64) std::array<char, 32 * 1024> buffer{};
+
+    while (true)
+    {
+        auto bytes = getdents64(dirFd, buffer.data(), buffer.size());
+        if (bytes <= 0)
+        {
+            if (bytes == -1)
+            {
+                lg2::error("Failed to read the directory {PATH}, ErrNo : "
+                           "{ERRNO}, ErrMsg : {ERRMSG}",
+                           "PATH", dir, "ERRNO", errno, "ERRMSG",
+                           strerror(errno));
+            }
+            break;
+        }
+
+        for (ssize_t offset = 0; offset < bytes;)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            const auto* entry = reinterpret_cast<const dirent64*>(
+                buffer.data() + offset);
+            offset += entry->d_reclen;
+
+            const std::string name{static_cast<const char*>(entry->d_name)};
+            if (name == "." || name == ".." || _isSkipped(dir / name))
+            {
+                continue;
+            }
+
+            bool isDir = (entry->d_type == DT_DIR);
+            if (entry->d_type == DT_UNKNOWN)
+            {
+                // Not all the filesystems fill the type
+                auto mtime = getMtime(dirFd, name.c_str());
+                isDir = mtime.has_value() && mtime->second;
+            }
+            entries.emplace_back(name, isDir);
+        }
+    }
+    std::ranges::sort(entries);
+    std::ranges::sort(entries);
+    return entries;
+}
+
+void SubtreeScanner::forget(const fs::path& path)
+{
+    std::erase_if(_files, [&path](const auto& file) {
+        return utility::isSameOrChildOf(file.first, path);
+    });
+    std::erase_if(_dirs, [&path](const auto& dirState) {
+        return utility::isSameOrChildOf(dirState.first, path);
+    });
+}
+
+} // namespace data_sync::watch::scan
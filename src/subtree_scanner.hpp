@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace data_sync::watch::scan
+{
+
+namespace fs = std::filesystem;
+
+/**
+ * @class SubtreeScanner
+ *
+ * @brief Finds the changes of a subtree by comparing the modification times
+ *        against the previous scan, to cover the subtrees which are not
+ *        watched by inotify.
+ *
+ * The directories are read (getdents64) only if their modification time is
+ * changed since the previous scan, i.e. an entry is added or removed, and
+ * the files are checked by a single statx relative to their directory.
+ */
+class SubtreeScanner
+{
+  public:
+    /**
+     * @brief The predicate to skip a path along with its subtree.
+     */
+    using SkipPredicate = std::function<bool(const fs::path&)>;
+
+    /**
+     * @brief The changes found by a scan.
+     *
+     * The new directories are with the trailing slash and cover their
+     * children, and the removed directories cover their children.
+     */
+    struct Changes
+    {
+        std::vector<fs::path> modified;
+        std::vector<fs::path> removed;
+
+        bool empty() const
+        {
+            return modified.empty() && removed.empty();
+        }
+    };
+
+    SubtreeScanner(const SubtreeScanner&) = delete;
+    SubtreeScanner& operator=(const SubtreeScanner&) = delete;
+    SubtreeScanner(SubtreeScanner&&) = delete;
+    SubtreeScanner& operator=(SubtreeScanner&&) = delete;
+    ~SubtreeScanner() = default;
+
+    /**
+     * @brief Constructor, takes the baseline to compare the scans against.
+     *
+     * @param[in] root - The root file/directory of the subtree
+     * @param[in] isSkipped - The predicate to skip the paths
+     */
+    SubtreeScanner(fs::path root, SkipPredicate isSkipped);
+
+    /**
+     * @brief API to scan the subtree for the changes since the previous scan.
+     *
+     * @return The changes found.
+     */
+    Changes scan();
+
+    /**
+     * @brief API to get the root of the subtree.
+     */
+    const fs::path& getRoot() const
+    {
+        return _root;
+    }
+
+    /**
+     * @brief API to get the number of directories in the subtree.
+     */
+    size_t getDirCount() const
+    {
+        return _dirs.size();
+    }
+
+    /**
+     * @brief API to get the number of entries checked by the last scan.
+     */
+    size_t getScannedEntries() const
+    {
+        return _scannedEntries;
+    }
+
+  private:
+    /**
+     * @brief The modification time as seconds and nanoseconds.
+     */
+    using Mtime = std::pair<int64_t, uint32_t>;
+
+    /**
+     * @brief An entry of a directory along with whether it is a directory.
+     */
+    using DirEntry = std::pair<std::string, bool>;
+
+    /**
+     * @brief The last known state of a directory.
+     */
+    struct DirState
+    {
+        Mtime mtime;
+
+        // Sorted by the name
+        std::vector<DirEntry> entries;
+    };
+
+    /**
+     * @brief API to scan a directory and its subdirectories.
+     *
+     * @param[in] dir - The directory to scan
+     * @param[in] changes - The changes to add into, nullptr to take the
+     *                      baseline without reporting
+     */
+    void scanDir(const fs::path& dir, Changes* changes);
+
+    /**
+     * @brief API to scan the root if it is not a directory.
+     *
+     * @param[in] changes - The changes to add into, nullptr to take the
+     *                      baseline without reporting
+     */
+    void scanFile(Changes* changes);
+
+    /**
+     * @brief API to read the entries of a directory.
+     *
+     * @param[in] dirFd - The fd of the directory
+     * @param[in] dir - The path of the directory
+     *
+     * @return The entries sorted, to compare against the previous ones.
+     */
+    std::vector<DirEntry> readDir(int dirFd, const fs::path& dir);
+
+    /**
+     * @brief API to forget a removed path along with its subtree.
+     *
+     * @param[in] path - The removed path
+     */
+    void forget(const fs::path& path);
+
+    /**
+     * @brief The root of the subtree.
+     */
+    fs::path _root;
+
+    /**
+     * @brief The predicate to skip the paths.
+     */
+    SkipPredicate _isSkipped;
+
+    /**
+     * @brief The last known state of the directories.
+     */
+    std::map<fs::path, DirState> _dirs;
+
+    /**
+     * @brief The last known modification time of the files.
+     */
+    std::map<fs::path, Mtime> _files;
+
+    /**
+     * @brief The number of entries checked by the last scan.
+     */
+    size_t _scannedEntries{0};
+};
+
+} // namespace data_sync::watch::scan
@@ -6,12 +6,22 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
 namespace data_sync::dbus_ifaces
 {
 
 using SyncBMCData =
     sdbusplus::common::xyz::openbmc_project::control::SyncBMCData;
 
+namespace
+{
+// The upper bound of the flush timeout, to not overflow the deadline
+constexpr std::chrono::hours maxFlushTimeout{24};
+} // namespace
+
 SyncBMCDataIface::SyncBMCDataIface(sdbusplus::async::context& ctx,
                                    data_sync::Manager& manager) :
     sdbusplus::aserver::xyz::openbmc_project::control::SyncBMCData<
@@ -75,7 +85,7 @@ sdbusplus::async::task<>
             SyncDisabled();
     }
 
-    if (data_sync::Manager::isSiblingBmcNotAvailable())
+    if (_manager.isSiblingBmcNotAvailable())
     {
         lg2::error(
             "Sibling BMC is not available, Unable to retrieve the BMC IP ");
@@ -109,18 +119,64 @@ bool SyncBMCDataIface::set_property([[maybe_unused]] disable_sync_t type,
         _manager.setSyncEventsHealth(disable ? SyncEventsHealth::Paused
                                              : SyncEventsHealth::Ok);
     }
-    try
-    {
-        data_sync::persist::update(data_sync::persist::key::disable, disable);
-    }
-    catch (const std::exception& e)
-    {
-        lg2::warning(
-            "Failed to serialize DBus Disable Sync value of {DISABLE}: {ERROR}",
-            "DISABLE", disable, "ERROR", e);
-    }
+    _manager.persistProperty(data_sync::persist::key::disable, disable);
     _manager.disableSyncPropChanged(disable);
     return true;
 }
 
+ReplicationIface::ReplicationIface(sdbusplus::async::context& ctx,
+                                   data_sync::Manager& manager) :
+    sdbusplus::aserver::xyz::openbmc_project::control::sync_bmc_data::
+        Replication<ReplicationIface>(ctx, SyncBMCData::instance_path),
+    _manager(manager)
+{
+    emit_added();
+}
+
+uint64_t ReplicationIface::get_property(
+    [[maybe_unused]] replication_lag_t type) const
+{
+    return static_cast<uint64_t>(_manager.getReplicationLag().count());
+}
+
+std::vector<std::tuple<std::string, uint64_t, uint64_t>>
+    ReplicationIface::get_property(
+        [[maybe_unused]] periodic_schedule_t type) const
+{
+    const auto now = std::chrono::steady_clock::now();
+    std::vector<std::tuple<std::string, uint64_t, uint64_t>> schedule;
+    std::ranges::transform(
+        _manager.getPeriodicSchedule(), std::back_inserter(schedule),
+        [&now](const auto& entry) {
+        const auto dueIn = std::chrono::ceil<std::chrono::seconds>(std::max(
+            entry.nextDue - now, std::chrono::steady_clock::duration::zero()));
+        return std::make_tuple(entry.path.string(),
+                               static_cast<uint64_t>(entry.periodicity.count()),
+                               static_cast<uint64_t>(dueIn.count()));
+    });
+    return schedule;
+}
+
+sdbusplus::async::task<std::vector<std::string>>
+    // NOLINTNEXTLINE
+    ReplicationIface::method_call([[maybe_unused]] flush_t type,
+                                  uint64_t timeout)
+{
+    if (_manager.isSyncDisabled())
+    {
+        lg2::error("Sync is Disabled, cannot flush the pending changes.");
+        throw sdbusplus::xyz::openbmc_project::Control::SyncBMCData::Error::
+            SyncDisabled();
+    }
+
+    const std::chrono::milliseconds flushTimeout{std::min<uint64_t>(
+        timeout, std::chrono::milliseconds(maxFlushTimeout).count())};
+    auto failedPaths = co_await _manager.flush(flushTimeout);
+
+    std::vector<std::string> paths;
+    std::ranges::transform(failedPaths, std::back_inserter(paths),
+                           [](const auto& path) { return path.string(); });
+    co_return paths;
+}
+
 } // namespace data_sync::dbus_ifaces
@@ -6,8 +6,14 @@
 
 #include <sdbusplus/async.hpp>
 #include <sdbusplus/message.hpp>
+#include <xyz/openbmc_project/Control/SyncBMCData/Replication/aserver.hpp>
 #include <xyz/openbmc_project/Control/SyncBMCData/aserver.hpp>
 
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
 namespace data_sync
 {
 class Manager;
@@ -79,5 +85,74 @@ class SyncBMCDataIface :
      */
     sdbusplus::async::context& _ctx;
 };
+
+/**
+ * @class ReplicationIface
+ *
+ * @brief ReplicationIface class implements the dbus server of the replication
+ *        state towards the sibling BMC. It is hosted along with the
+ *        SyncBMCData interface, and provides the replication lag and the
+ *        flush barrier.
+ */
+class ReplicationIface :
+    public sdbusplus::aserver::xyz::openbmc_project::control::sync_bmc_data::
+        Replication<ReplicationIface>
+{
+  public:
+    ReplicationIface(const ReplicationIface&) = delete;
+    ReplicationIface& operator=(const ReplicationIface&) = delete;
+    ReplicationIface(ReplicationIface&&) = delete;
+    ReplicationIface& operator=(ReplicationIface&&) = delete;
+    virtual ~ReplicationIface() = default;
+
+    /**
+     * @brief Constructor for ReplicationIface.
+     *
+     * @param[in] ctx Reference to the async D-Bus context.
+     * @param[in] manager Reference of the manager.
+     */
+    ReplicationIface(sdbusplus::async::context& ctx,
+                     data_sync::Manager& manager);
+
+    /**
+     * @brief Implements property get for the replication lag property, which
+     *        is computed on every read as it grows with the time.
+     *
+     * @param[in] replication_lag_t - The type.
+     *
+     * @return The replication lag in milliseconds
+     */
+    uint64_t get_property(replication_lag_t type) const;
+
+    /**
+     * @brief Implements property get for the periodic schedule property,
+     *        which is computed on every read as the time until the next sync
+     *        decreases with the time.
+     *
+     * @param[in] periodic_schedule_t - The type.
+     *
+     * @return The configured path, the periodicity in seconds and the seconds
+     *         until the next sync of the Periodic configurations
+     */
+    std::vector<std::tuple<std::string, uint64_t, uint64_t>>
+        get_property(periodic_schedule_t type) const;
+
+    /**
+     * @brief Handles the Flush method call for the Replication interface.
+     *
+     * @param[in] type Method type identifier.
+     * @param[in] timeout The maximum time in milliseconds to wait.
+     *
+     * @return The paths whose changes couldn't be replicated.
+     */
+    sdbusplus::async::task<std::vector<std::string>>
+        method_call(flush_t type, uint64_t timeout);
+
+  private:
+    /**
+     * @brief Reference to the Manager object.
+     */
+    Manager& _manager;
+};
 } // namespace dbus_ifaces
 } // namespace data_sync
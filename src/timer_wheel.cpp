@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "timer_wheel.hpp"
+
+#include <algorithm>
+
+namespace data_sync::schedule
+{
+
+TimerWheel::TimerWheel(Clock::time_point epoch) : _epoch(epoch) {}
+
+uint64_t TimerWheel::toTick(Clock::time_point time) const
+{
+    if (time <= _epoch)
+    {
+        return 0;
+    }
+    return static_cast<uint64_t>((time - _epoch) / tickDuration);
+}
+
+Clock::time_point TimerWheel::toTime(uint64_t tick) const
+{
+    return _epoch + tick * tickDuration;
+}
+
+uint64_t TimerWheel::slackTicks(uint64_t periodTicks)
+{
+    return std::min<uint64_t>(periodTicks / 10, maxSlack / tickDuration);
+}
+
+void TimerWheel::insertIntoSlot(const fs::path& path, uint64_t dueTick)
+{
+    _slots[dueTick % slotCount].emplace_back(path);
+}
+
+void TimerWheel::eraseFromSlot(const fs::path& path, uint64_t dueTick)
+{
+    std::erase(_slots[dueTick % slotCount], path);
+}
+
+void TimerWheel::add(const fs::path& path, std::chrono::seconds periodicity,
+                     Clock::time_point now)
+{
+    remove(path);
+
+    const uint64_t periodTicks = std::max<uint64_t>(
+        1, static_cast<uint64_t>(periodicity / tickDuration));
+    const uint64_t dueTick = (toTick(now) / periodTicks + 1) * periodTicks;
+    _entries.emplace(path, TickEntry{periodTicks, dueTick});
+    insertIntoSlot(path, dueTick);
+}
+
+void TimerWheel::remove(const fs::path& path)
+{
+    auto entry = _entries.find(path);
+    if (entry == _entries.end())
+    {
+        return;
+    }
+    eraseFromSlot(path, entry->second.dueTick);
+    _entries.erase(entry);
+}
+
+std::optional<Clock::time_point> TimerWheel::getNextDue() const
+{
+    if (_entries.empty())
+    {
+        return std::nullopt;
+    }
+
+    // The paths are always due after the current tick, hence the earliest
+    // one is found within a round of the wheel unless all are due later.
+    for (uint64_t tick = _currentTick + 1; tick <= _currentTick + slotCount;
+         ++tick)
+    {
+        for (const auto& path : _slots[tick % slotCount])
+        {
+            if (_entries.at(path).dueTick == tick)
+            {
+                return toTime(tick);
+            }
+        }
+    }
+
+    auto earliest = std::ranges::min_element(
+        _entries, {}, [](const auto& entry) { return entry.second.dueTick; });
+    return toTime(earliest->second.dueTick);
+}
+
+std::vector<fs::path> TimerWheel::popDue(Clock::time_point now)
+{
+    const uint64_t nowTick = toTick(now);
+    std::vector<fs::path> duePaths;
+
+    if (nowTick - std::min(nowTick, _currentTick) >= slotCount)
+    {
+        // Every slot is passed, Eg: after a suspend
+        for (const auto& [path, entry] : _entries)
+        {
+            if (entry.dueTick <= nowTick)
+            {
+                duePaths.emplace_back(path);
+            }
+        }
+    }
+    else
+    {
+        for (uint64_t tick = _currentTick + 1; tick <= nowTick; ++tick)
+        {
+            for (const auto& path : _slots[tick % slotCount])
+            {
+                if (_entries.at(path).dueTick <= nowTick)
+                {
+                    duePaths.emplace_back(path);
+                }
+            }
+        }
+    }
+    _currentTick = std::max(_currentTick, nowTick);
+
+    if (duePaths.empty())
+    {
+        return duePaths;
+    }
+
+    // The paths due shortly are dispatched along with the due ones, rather
+    // than waking up again for them.
+    const uint64_t maxSlackTicks = maxSlack / tickDuration;
+    for (uint64_t tick = nowTick + 1; tick <= nowTick + maxSlackTicks; ++tick)
+    {
+        for (const auto& path : _slots[tick % slotCount])
+        {
+            const auto& entry = _entries.at(path);
+            if (entry.dueTick == tick &&
+                entry.dueTick <= nowTick + slackTicks(entry.periodTicks))
+            {
+                duePaths.emplace_back(path);
+            }
+        }
+    }
+
+    for (const auto& path : duePaths)
+    {
+        auto& entry = _entries.at(path);
+        eraseFromSlot(path, entry.dueTick);
+
+        // Skip the missed intervals, keeping the due tick a multiple of the
+        // periodicity.
+        entry.dueTick += entry.periodTicks;
+        if (entry.dueTick <= nowTick)
+        {
+            entry.dueTick = (nowTick / entry.periodTicks + 1) *
+                            entry.periodTicks;
+        }
+        insertIntoSlot(path, entry.dueTick);
+    }
+    return duePaths;
+}
+
+std::vector<TimerWheel::Entry> TimerWheel::getSchedule() const
+{
+    std::vector<Entry> schedule;
+    for (const auto& [path, entry] : _entries)
+    {
+        schedule.emplace_back(
+            path,
+            std::chrono::duration_cast<std::chrono::seconds>(
+                entry.periodTicks * tickDuration),
+            toTime(entry.dueTick));
+    }
+    std::ranges::sort(schedule, {}, &Entry::nextDue);
+    return schedule;
+}
+
+} // namespace data_sync::schedule
@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace data_sync::schedule
+{
+
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @class TimerWheel
+ *
+ * @brief Schedules the periodic syncs of all the configured paths on a single
+ *        hashed timer wheel, so that they wake up the system together.
+ *
+ *        - The time is divided into ticks from the epoch, and a path due at a
+ *          tick is kept in the slot of the tick modulo the number of slots.
+ *        - The paths are due at the multiples of their periodicity from the
+ *          epoch, hence the paths of the same periodicity are always due at
+ *          the same tick instead of drifting apart.
+ *        - The paths due within the slack of the tick being dispatched are
+ *          dispatched along with it, the slack being a tenth of their
+ *          periodicity bounded by the maxSlack.
+ *        - The missed intervals are skipped rather than dispatched in a burst,
+ *          Eg: if a dispatch took longer than the periodicity.
+ */
+class TimerWheel
+{
+  public:
+    /**
+     * @brief The duration of a tick, the periodicities are rounded to it.
+     */
+    static constexpr auto tickDuration = std::chrono::seconds(1);
+
+    /**
+     * @brief The number of slots of the wheel.
+     */
+    static constexpr size_t slotCount = 64;
+
+    /**
+     * @brief The upper bound of the slack to dispatch a path early.
+     */
+    static constexpr auto maxSlack = std::chrono::seconds(5);
+
+    /**
+     * @brief The schedule of a path.
+     */
+    struct Entry
+    {
+        fs::path path;
+        std::chrono::seconds periodicity;
+        Clock::time_point nextDue;
+    };
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+    TimerWheel(TimerWheel&&) = delete;
+    TimerWheel& operator=(TimerWheel&&) = delete;
+    ~TimerWheel() = default;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] epoch - The time the periodicities are aligned to
+     */
+    explicit TimerWheel(Clock::time_point epoch = Clock::now());
+
+    /**
+     * @brief API to schedule a path, at the next multiple of its periodicity
+     *        from the epoch. A scheduled path is rescheduled.
+     *
+     * @param[in] path - The configured path
+     * @param[in] periodicity - The periodicity of the sync
+     * @param[in] now - The current time
+     */
+    void add(const fs::path& path, std::chrono::seconds periodicity,
+             Clock::time_point now);
+
+    /**
+     * @brief API to unschedule a path.
+     *
+     * @param[in] path - The configured path
+     */
+    void remove(const fs::path& path);
+
+    /**
+     * @brief API to check whether a path is scheduled.
+     */
+    bool contains(const fs::path& path) const
+    {
+        return _entries.contains(path);
+    }
+
+    /**
+     * @brief API to check whether no path is scheduled.
+     */
+    bool empty() const
+    {
+        return _entries.empty();
+    }
+
+    /**
+     * @brief API to get the time at which the earliest path is due.
+     *
+     * @return The due time, or std::nullopt if no path is scheduled.
+     */
+    std::optional<Clock::time_point> getNextDue() const;
+
+    /**
+     * @brief API to take the paths due by the given time along with the paths
+     *        due within their slack, and to schedule them for their next
+     *        interval.
+     *
+     * @param[in] now - The current time
+     *
+     * @return The paths to dispatch together, empty if none is due.
+     */
+    std::vector<fs::path> popDue(Clock::time_point now);
+
+    /**
+     * @brief API to get the schedule of all the paths, in the order of their
+     *        due time.
+     */
+    std::vector<Entry> getSchedule() const;
+
+  private:
+    /**
+     * @brief The schedule of a path in ticks.
+     */
+    struct TickEntry
+    {
+        uint64_t periodTicks;
+        uint64_t dueTick;
+    };
+
+    /**
+     * @brief API to get the tick of the given time, rounded down.
+     */
+    uint64_t toTick(Clock::time_point time) const;
+
+    /**
+     * @brief API to get the time of the given tick.
+     */
+    Clock::time_point toTime(uint64_t tick) const;
+
+    /**
+     * @brief API to get the slack of a path in ticks.
+     */
+    static uint64_t slackTicks(uint64_t periodTicks);
+
+    /**
+     * @brief API to put a path into the slot of its due tick.
+     */
+    void insertIntoSlot(const fs::path& path, uint64_t dueTick);
+
+    /**
+     * @brief API to take a path out of the slot of its due tick.
+     */
+    void eraseFromSlot(const fs::path& path, uint64_t dueTick);
+
+    /**
+     * @brief The time the ticks are counted from.
+     */
+    Clock::time_point _epoch;
+
+    /**
+     * @brief The tick up to which the paths are dispatched.
+     */
+    uint64_t _currentTick{0};
+
+    /**
+     * @brief The schedule of the paths.
+     */
+    std::map<fs::path, TickEntry> _entries;
+
+    /**
+     * @brief The paths by the slot of their due tick.
+     */
+    std::array<std::vector<fs::path>, slotCount> _slots;
+};
+
+} // namespace data_sync::schedule
@@ -0,0 +1,250 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "config.h"
+
+#include "tracing.hpp"
+
+#include "utility.hpp"
+
+#include <sys/signalfd.h>
+#include <unistd.h>
+
+#include <nlohmann/json.hpp>
+#include <phosphor-logging/lg2.hpp>
+
+#include <csignal>
+#include <cstring>
+#include <fstream>
+
+#if HAVE_SYS_SDT_H
+#include <sys/sdt.h>
+#endif
+
+namespace data_sync::tracing
+{
+
+SpanTracer::SpanTracer(size_t capacity) : _capacity(capacity)
+{
+    _spans.reserve(_capacity);
+}
+
+SpanTracer& SpanTracer::instance()
+{
+    static SpanTracer tracer(TRACE_SPAN_CAPACITY);
+    return tracer;
+}
+
+CorrelationId SpanTracer::newCorrelationId()
+{
+    return _nextCorrelationId++;
+}
+
+void SpanTracer::record(Span span)
+{
+#if HAVE_SYS_SDT_H
+    DTRACE_PROBE4(phosphor_data_sync, span, span.correlationId,
+                  static_cast<int>(span.stage),
+                  std::chrono::duration_cast<std::chrono::microseconds>(
+                      span.start.time_since_epoch())
+                      .count(),
+                  std::chrono::duration_cast<std::chrono::microseconds>(
+                      span.duration)
+                      .count());
+#endif
+
+    if (_capacity == 0)
+    {
+        return;
+    }
+
+    if (_spans.size() < _capacity)
+    {
+        _spans.emplace_back(std::move(span));
+    }
+    else
+    {
+        _spans[_next] = std::move(span);
+        ++_droppedSpans;
+    }
+    _next = (_next + 1) % _capacity;
+}
+
+std::vector<Span> SpanTracer::getSpans() const
+{
+    if (_spans.size() < _capacity)
+    {
+        return _spans;
+    }
+
+    // The buffer is wrapped, hence the oldest span is at the next write index
+    std::vector<Span> spans;
+    spans.reserve(_spans.size());
+    spans.insert(spans.end(), _spans.begin() + _next, _spans.end());
+    spans.insert(spans.end(), _spans.begin(), _spans.begin() + _next);
+    return spans;
+}
+
+void SpanTracer::exportChromeTrace(const fs::path& traceFile) const
+{
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    nlohmann::json traceEvents = nlohmann::json::array();
+    for (const auto& span : getSpans())
+    {
+        // Each correlation id is shown as its own track so that a change can
+        // be followed across the stages.
+        traceEvents.push_back(
+            {{"name", std::string(stageInStr(span.stage))},
+             {"cat", "data_sync"},
+             {"ph", "X"},
+             {"ts",
+              duration_cast<microseconds>(span.start.time_since_epoch())
+                  .count()},
+             {"dur", duration_cast<microseconds>(span.duration).count()},
+             {"pid", getpid()},
+             {"tid", span.correlationId},
+             {"args",
+              {{"CorrelationId", span.correlationId},
+               {"Detail", span.detail}}}});
+    }
+
+    nlohmann::json chromeTrace = {
+        {"traceEvents", traceEvents},
+        {"displayTimeUnit", "ms"},
+        {"otherData", {{"DroppedSpans", _droppedSpans}}}};
+
+    std::error_code ec;
+    fs::create_directories(traceFile.parent_path(), ec);
+
+    std::ofstream file(traceFile, std::ios::out | std::ios::trunc);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Failed to open the trace file: " +
+                                 traceFile.string());
+    }
+    file << chromeTrace.dump();
+}
+
+void SpanTracer::clear()
+{
+    _spans.clear();
+    _next = 0;
+    _droppedSpans = 0;
+}
+
+ScopedSpan::ScopedSpan(CorrelationId correlationId, Stage stage,
+                       std::string detail) :
+    _correlationId(correlationId), _stage(stage), _start(Clock::now()),
+    _detail(std::move(detail))
+{}
+
+ScopedSpan::~ScopedSpan()
+{
+    SpanTracer::instance().record({_correlationId, _stage, _start,
+                                   Clock::now() - _start, std::move(_detail)});
+}
+
+std::string_view stageInStr(Stage stage)
+{
+    switch (stage)
+    {
+        case Stage::InotifyRead:
+            return "InotifyRead";
+        case Stage::EventClassify:
+            return "EventClassify";
+        case Stage::CoalesceQueue:
+            return "CoalesceQueue";
+        case Stage::Dispatch:
+            return "Dispatch";
+        case Stage::ProcessSpawn:
+            return "ProcessSpawn";
+        case Stage::RsyncExit:
+            return "RsyncExit";
+        case Stage::NotifyRequest:
+            return "NotifyRequest";
+        case Stage::RemoteRestart:
+            return "RemoteRestart";
+        case Stage::OverflowRescan:
+            return "OverflowRescan";
+    }
+    return "Unknown";
+}
+
+bool blockExportSignal()
+{
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGUSR1);
+
+    // sigprocmask() is unspecified in a multithreaded process, and the
+    // threads started later inherit the mask of this thread.
+    auto errNo = pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+    if (errNo != 0)
+    {
+        lg2::error("Failed to block SIGUSR1, ErrNo : {ERRNO}, ErrMsg : "
+                   "{ERRMSG}",
+                   "ERRNO", errNo, "ERRMSG", strerror(errNo));
+        return false;
+    }
+    return true;
+}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<> exportOnSignal(sdbusplus::async::context& ctx,
+                                        fs::path traceFile)
+{
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGUSR1);
+
+    // Blocking it here would cover only the event loop thread, hence it is
+    // expected to be blocked before any thread is started.
+    sigset_t blocked;
+    if (pthread_sigmask(SIG_BLOCK, nullptr, &blocked) != 0 ||
+        sigismember(&blocked, SIGUSR1) != 1)
+    {
+        lg2::error("SIGUSR1 is not blocked, not exporting the trace spans "
+                   "upon it");
+        co_return;
+    }
+
+    utility::FD signalFd(signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC));
+    if (signalFd() == -1)
+    {
+        lg2::error("Failed to create signalfd, ErrNo : {ERRNO}, ErrMsg : "
+                   "{ERRMSG}",
+                   "ERRNO", errno, "ERRMSG", strerror(errno));
+        co_return;
+    }
+
+    auto fdioInstance = std::make_unique<sdbusplus::async::fdio>(ctx,
+                                                                 signalFd());
+    while (!ctx.stop_requested())
+    {
+        // NOLINTNEXTLINE
+        co_await fdioInstance->next();
+
+        signalfd_siginfo sigInfo{};
+        if (read(signalFd(), &sigInfo, sizeof(sigInfo)) !=
+            static_cast<ssize_t>(sizeof(sigInfo)))
+        {
+            continue;
+        }
+
+        try
+        {
+            SpanTracer::instance().exportChromeTrace(traceFile);
+            lg2::info("Exported the trace spans to [{FILE}]", "FILE",
+                      traceFile);
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error("Failed to export the trace spans, Error : {ERROR}",
+                       "ERROR", e);
+        }
+    }
+    co_return;
+}
+
+} // namespace data_sync::tracing
@@ -0,0 +1,235 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <sdbusplus/async.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace data_sync::tracing
+{
+
+namespace fs = std::filesystem;
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief The identifier which ties the spans of a replicated change together,
+ *        from the inotify read to the service restart on the sibling BMC.
+ *
+ * Zero is never assigned and denotes that the id is not available.
+ */
+using CorrelationId = uint64_t;
+
+/**
+ * @brief The stages of the event to replication pipeline.
+ */
+enum class Stage
+{
+    InotifyRead,   // Reading the events from the inotify fd
+    EventClassify, // Mapping the events to the data operations
+    CoalesceQueue, // Merging a change into an already queued/in-flight sync
+    Dispatch,      // Scheduling the sync for a data operation
+    ProcessSpawn,  // Spawning the rsync process
+    RsyncExit,     // Running the rsync until it exits
+    NotifyRequest, // Creating and sending the sibling notify request
+    RemoteRestart, // Reloading/Restarting the services on the sibling BMC
+    OverflowRescan // Rescanning the watched tree after an inotify overflow
+};
+
+/**
+ * @brief A traced pipeline stage of a replicated change.
+ */
+struct Span
+{
+    CorrelationId correlationId;
+    Stage stage;
+    Clock::time_point start;
+    Clock::duration duration;
+    std::string detail;
+};
+
+/**
+ * @class SpanTracer
+ *
+ * @brief Keeps the recent spans in a fixed size ring buffer, so that tracing
+ *        can be left enabled in the field at a bounded memory cost.
+ *
+ * The spans can be exported as Chrome trace JSON, which can be loaded in
+ * chrome://tracing or Perfetto. If the USDT probes are available, each span
+ * is also emitted through the "phosphor_data_sync:span" probe.
+ */
+class SpanTracer
+{
+  public:
+    SpanTracer(const SpanTracer&) = delete;
+    SpanTracer& operator=(const SpanTracer&) = delete;
+    SpanTracer(SpanTracer&&) = delete;
+    SpanTracer& operator=(SpanTracer&&) = delete;
+    ~SpanTracer() = default;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] capacity - The number of spans to retain, 0 disables tracing
+     */
+    explicit SpanTracer(size_t capacity);
+
+    /**
+     * @brief API to get the tracer instance of the daemon.
+     */
+    static SpanTracer& instance();
+
+    /**
+     * @brief API to allocate a new correlation id.
+     */
+    CorrelationId newCorrelationId();
+
+    /**
+     * @brief API to record a span, the oldest span gets overwritten once the
+     *        ring buffer is full.
+     *
+     * @param[in] span - The span to record
+     */
+    void record(Span span);
+
+    /**
+     * @brief API to get the retained spans from the oldest to the newest.
+     */
+    std::vector<Span> getSpans() const;
+
+    /**
+     * @brief API to get the number of the spans dropped due to the ring
+     *        buffer wrap around.
+     */
+    size_t getDroppedSpans() const
+    {
+        return _droppedSpans;
+    }
+
+    /**
+     * @brief API to write the retained spans in the Chrome trace event format.
+     *
+     * @param[in] traceFile - The file to write into
+     *
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void exportChromeTrace(const fs::path& traceFile) const;
+
+    /**
+     * @brief API to clear the retained spans.
+     */
+    void clear();
+
+  private:
+    /**
+     * @brief The ring buffer of the spans.
+     */
+    std::vector<Span> _spans;
+
+    /**
+     * @brief The maximum number of spans to retain.
+     */
+    size_t _capacity;
+
+    /**
+     * @brief The index in the ring buffer to write the next span.
+     */
+    size_t _next{0};
+
+    /**
+     * @brief The number of the spans overwritten.
+     */
+    size_t _droppedSpans{0};
+
+    /**
+     * @brief The correlation id to be allocated next.
+     */
+    CorrelationId _nextCorrelationId{1};
+};
+
+/**
+ * @class ScopedSpan
+ *
+ * @brief Records a span of the given stage covering its lifetime.
+ */
+class ScopedSpan
+{
+  public:
+    ScopedSpan(const ScopedSpan&) = delete;
+    ScopedSpan& operator=(const ScopedSpan&) = delete;
+    ScopedSpan(ScopedSpan&&) = delete;
+    ScopedSpan& operator=(ScopedSpan&&) = delete;
+
+    /**
+     * @brief Constructor which starts the span.
+     *
+     * @param[in] correlationId - The correlation id of the change
+     * @param[in] stage - The traced stage
+     * @param[in] detail - The additional detail to record along with the span
+     */
+    ScopedSpan(CorrelationId correlationId, Stage stage,
+               std::string detail = {});
+
+    /**
+     * @brief Destructor which records the span.
+     */
+    ~ScopedSpan();
+
+    /**
+     * @brief API to update the detail of the span, Eg: with the result of the
+     *        stage which is known only at the end.
+     *
+     * @param[in] detail - The detail to record
+     */
+    void setDetail(std::string detail)
+    {
+        _detail = std::move(detail);
+    }
+
+  private:
+    CorrelationId _correlationId;
+    Stage _stage;
+    Clock::time_point _start;
+    std::string _detail;
+};
+
+/**
+ * @brief API to convert the stage to string.
+ *
+ * @param[in] stage - The stage to convert
+ */
+std::string_view stageInStr(Stage stage);
+
+/**
+ * @brief API to block SIGUSR1 in the calling thread, so that the signal is
+ *        received only through the signalfd of exportOnSignal().
+ *
+ * @note It must be called before any thread is started, as the threads
+ *       inherit the signal mask. A thread which doesn't block the signal may
+ *       take it with the default action, which terminates the process.
+ *
+ * @return true if the signal is blocked; otherwise false.
+ */
+bool blockExportSignal();
+
+/**
+ * @brief API to write the retained spans into the given file upon receiving
+ *        SIGUSR1, so that the trace can be collected from a running daemon.
+ *
+ * @note SIGUSR1 must already be blocked in all the threads through
+ *       blockExportSignal().
+ *
+ * @param[in] ctx - The async context object
+ * @param[in] traceFile - The file to write the spans into
+ */
+sdbusplus::async::task<> exportOnSignal(sdbusplus::async::context& ctx,
+                                        fs::path traceFile);
+
+} // namespace data_sync::tracing
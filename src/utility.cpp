@@ -8,8 +8,9 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
 #include <filesystem>
-#include <regex>
+
 namespace data_sync::utility
 {
 
@@ -80,20 +81,16 @@ void setupPaths()
     }
 }
 
-namespace rsync
+fs::path withoutTrailingSlash(const fs::path& path)
 {
+    return path.has_filename() ? path : path.parent_path();
+}
 
-size_t getTransferredDataBytes(const std::string& rsyncOpStr)
+bool isSameOrChildOf(const fs::path& path, const fs::path& parent)
 {
-    // Regex to capture the numeric value of "Literal data:"
-    std::regex re(R"(Literal data:\s*([0-9]+(?:\.[0-9]+)?\s*\w+))");
-    std::smatch match;
-
-    if (std::regex_search(rsyncOpStr, match, re))
-    {
-        return static_cast<size_t>(std::stod(match[1].str()));
-    }
-    return 0;
+    const auto parentPath = withoutTrailingSlash(parent);
+    auto [parentEnd, _] = std::ranges::mismatch(parentPath,
+                                                withoutTrailingSlash(path));
+    return parentEnd == parentPath.end();
 }
-} // namespace rsync
 } // namespace data_sync::utility
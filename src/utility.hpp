@@ -3,6 +3,7 @@
 #pragma once
 
 #include <cstddef>
+#include <filesystem>
 #include <string>
 namespace data_sync::utility
 {
@@ -65,21 +66,26 @@ class FD
  */
 void setupPaths();
 
-namespace rsync
-{
 /**
- * @brief Extract the actual bytes of file data transferred
+ * @brief Get the path without the trailing slash, as the directories are
+ *        configured and reported with it.
  *
- * The function searches the provided rsync log string for the line
- * starting with "Literal data:" and captures its numeric
- * value.
+ * @param[in] path - The path
  *
- * @param[in] rsyncOpStr - rsync output string containing the transfer
- *                         summary.
- * @return size_t - numeric value of the transferred size
- *                - Returns 0 if the value is not found
+ * @return The path without the trailing slash
  */
-size_t getTransferredDataBytes(const std::string& rsyncOpStr);
+std::filesystem::path withoutTrailingSlash(const std::filesystem::path& path);
 
-} // namespace rsync
+/**
+ * @brief Check whether the path is the same as or a child of the given
+ *        parent, compared per path element so that "/a/bc" is not a child
+ *        of "/a/b".
+ *
+ * @param[in] path - The path to check
+ * @param[in] parent - The parent path, with or without the trailing slash
+ *
+ * @return True if the path is the same as or under the parent
+ */
+bool isSameOrChildOf(const std::filesystem::path& path,
+                     const std::filesystem::path& parent);
 } // namespace data_sync::utility
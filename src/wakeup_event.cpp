@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "wakeup_event.hpp"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <experimental/scope>
+#include <stdexcept>
+
+namespace data_sync::async
+{
+
+WakeupEvent::WakeupEvent(sdbusplus::async::context& ctx) :
+    _ctx(ctx),
+    _state(std::make_shared<State>(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)))
+{
+    if (_state->fd() == -1)
+    {
+        throw std::runtime_error("Failed to create the eventfd to wait on");
+    }
+    _fdioInstance = std::make_unique<sdbusplus::async::fdio>(_ctx,
+                                                             _state->fd());
+}
+
+void WakeupEvent::signal(State& state)
+{
+    if (!state.waiting)
+    {
+        return;
+    }
+    uint64_t count{1};
+    [[maybe_unused]] auto rc = write(state.fd(), &count, sizeof(count));
+}
+
+void WakeupEvent::notify()
+{
+    _state->notified = true;
+    signal(*_state);
+}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<> WakeupEvent::runTimer(sdbusplus::async::context& ctx,
+                                               std::weak_ptr<State> state,
+                                               Clock::time_point deadline)
+{
+    co_await sdbusplus::async::sleep_for(ctx, deadline - Clock::now());
+    if (auto eventState = state.lock())
+    {
+        eventState->timers.erase(eventState->timers.find(deadline));
+        signal(*eventState);
+    }
+    co_return;
+}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<> WakeupEvent::waitForSignal()
+{
+    _state->waiting = true;
+    using std::experimental::scope_exit;
+    auto waitDone = scope_exit([this]() noexcept {
+        _state->waiting = false;
+    });
+
+    // NOLINTNEXTLINE
+    co_await _fdioInstance->next();
+
+    uint64_t count{0};
+    [[maybe_unused]] auto rc = read(_state->fd(), &count, sizeof(count));
+    co_return;
+}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<bool> WakeupEvent::waitUntil(Clock::time_point deadline)
+{
+    while (!_state->notified)
+    {
+        if (Clock::now() >= deadline || _ctx.stop_requested())
+        {
+            co_return false;
+        }
+
+        // A timer expiring earlier wakes up to arm the one for the deadline
+        if (_state->timers.empty() || *_state->timers.begin() > deadline)
+        {
+            _state->timers.emplace(deadline);
+            _ctx.spawn(runTimer(_ctx, _state, deadline));
+        }
+
+        // NOLINTNEXTLINE
+        co_await waitForSignal();
+    }
+    _state->notified = false;
+    co_return true;
+}
+
+// NOLINTNEXTLINE
+sdbusplus::async::task<> WakeupEvent::wait()
+{
+    while (!_state->notified && !_ctx.stop_requested())
+    {
+        // NOLINTNEXTLINE
+        co_await waitForSignal();
+    }
+    _state->notified = false;
+    co_return;
+}
+
+} // namespace data_sync::async
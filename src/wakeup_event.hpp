@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "utility.hpp"
+
+#include <sdbusplus/async.hpp>
+
+#include <chrono>
+#include <memory>
+#include <set>
+
+namespace data_sync::async
+{
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @class WakeupEvent
+ *
+ * @brief An eventfd for a coroutine to sleep on until it is notified or its
+ *        deadline passes, so that a long wait which may need to end early
+ *        doesn't wake up periodically to check for it.
+ *
+ *        - The deadline is served by a single timer, which is shared by the
+ *          later waits of the same or a later deadline.
+ *        - A notification before the wait isn't lost, the next wait returns
+ *          right away.
+ *        - Only a single coroutine waits on an event at a time.
+ */
+class WakeupEvent
+{
+  public:
+    WakeupEvent(const WakeupEvent&) = delete;
+    WakeupEvent& operator=(const WakeupEvent&) = delete;
+    WakeupEvent(WakeupEvent&&) = delete;
+    WakeupEvent& operator=(WakeupEvent&&) = delete;
+    ~WakeupEvent() = default;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] ctx - The async context object
+     *
+     * @throws std::runtime_error if the eventfd cannot be created
+     */
+    explicit WakeupEvent(sdbusplus::async::context& ctx);
+
+    /**
+     * @brief API to wake up the waiting coroutine, or the next wait if none
+     *        is waiting.
+     */
+    void notify();
+
+    /**
+     * @brief API to wait until notified or the given deadline.
+     *
+     * @param[in] deadline - The time to stop waiting at
+     *
+     * @return True if notified; otherwise False.
+     */
+    sdbusplus::async::task<bool> waitUntil(Clock::time_point deadline);
+
+    /**
+     * @brief API to wait until notified.
+     */
+    sdbusplus::async::task<> wait();
+
+  private:
+    /**
+     * @brief API to wait on the eventfd until it is signalled once.
+     */
+    sdbusplus::async::task<> waitForSignal();
+
+    /**
+     * @brief The state shared with the timers, which may outlive the event.
+     */
+    struct State
+    {
+        explicit State(int eventFd) : fd(eventFd) {}
+
+        // The eventfd to wake up the waiting coroutine
+        utility::FD fd;
+
+        // Indicates the event is notified and not yet consumed by a wait
+        bool notified{false};
+
+        // Indicates a coroutine waits on the eventfd. It is signalled only
+        // then, as it stays readable otherwise until the next wait.
+        bool waiting{false};
+
+        // The deadlines of the timers which are not yet expired
+        std::multiset<Clock::time_point> timers;
+    };
+
+    /**
+     * @brief API to signal the eventfd to wake up the waiting coroutine, if
+     *        any.
+     *
+     * @param[in] state - The state of the event
+     */
+    static void signal(State& state);
+
+    /**
+     * @brief API to wake up the waiting coroutine at the given deadline, if
+     *        the event still exists.
+     *
+     * @param[in] ctx - The async context object
+     * @param[in] state - The state of the event
+     * @param[in] deadline - The deadline to wake up at
+     */
+    static sdbusplus::async::task<> runTimer(sdbusplus::async::context& ctx,
+                                             std::weak_ptr<State> state,
+                                             Clock::time_point deadline);
+
+    /**
+     * @brief The async context object.
+     */
+    sdbusplus::async::context& _ctx;
+
+    /**
+     * @brief The state of the event.
+     */
+    std::shared_ptr<State> _state;
+
+    /**
+     * @brief The instance to wait on the eventfd.
+     */
+    std::unique_ptr<sdbusplus::async::fdio> _fdioInstance;
+};
+
+} // namespace data_sync::async
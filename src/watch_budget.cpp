@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "config.h"
+
+#include "watch_budget.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <fstream>
+
+namespace data_sync::watch::inotify
+{
+
+WatchBudget::WatchBudget(size_t limit) : _limit(limit) {}
+
+WatchBudget& WatchBudget::instance()
+{
+    static WatchBudget watchBudget(defaultLimit());
+    return watchBudget;
+}
+
+size_t WatchBudget::defaultLimit()
+{
+    if (INOTIFY_WATCH_BUDGET > 0)
+    {
+        return INOTIFY_WATCH_BUDGET;
+    }
+
+    // Leave a quarter of the system limit to the other processes, since the
+    // limit is per user.
+    constexpr size_t fallbackLimit = 8192;
+    size_t maxUserWatches{0};
+    std::ifstream file("/proc/sys/fs/inotify/max_user_watches");
+    if (!(file >> maxUserWatches) || maxUserWatches == 0)
+    {
+        return fallbackLimit;
+    }
+    return maxUserWatches - (maxUserWatches / 4);
+}
+
+bool WatchBudget::tryAcquire()
+{
+    if (_used >= _limit)
+    {
+        return false;
+    }
+    ++_used;
+    return true;
+}
+
+void WatchBudget::release()
+{
+    if (_used > 0)
+    {
+        --_used;
+    }
+}
+
+} // namespace data_sync::watch::inotify
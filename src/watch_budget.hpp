@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+
+namespace data_sync::watch::inotify
+{
+
+/**
+ * @class WatchBudget
+ *
+ * @brief Accounts the inotify watches of the daemon against a budget, as the
+ *        watches use the kernel memory and count against max_user_watches
+ *        shared with the other processes of the user.
+ *
+ * The watchers cover the subtrees beyond the budget by the periodic scans.
+ */
+class WatchBudget
+{
+  public:
+    WatchBudget(const WatchBudget&) = delete;
+    WatchBudget& operator=(const WatchBudget&) = delete;
+    WatchBudget(WatchBudget&&) = delete;
+    WatchBudget& operator=(WatchBudget&&) = delete;
+    ~WatchBudget() = default;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] limit - The number of watches allowed
+     */
+    explicit WatchBudget(size_t limit);
+
+    /**
+     * @brief API to get the watch budget of the daemon.
+     */
+    static WatchBudget& instance();
+
+    /**
+     * @brief API to get the default budget, which is either configured or
+     *        a share of the max_user_watches of the system.
+     */
+    static size_t defaultLimit();
+
+    /**
+     * @brief API to take a watch from the budget.
+     *
+     * @return True if available; otherwise False.
+     */
+    bool tryAcquire();
+
+    /**
+     * @brief API to return a watch to the budget.
+     */
+    void release();
+
+    /**
+     * @brief API to change the number of watches allowed. The watches in use
+     *        beyond the new limit are not taken back.
+     *
+     * @param[in] limit - The number of watches allowed
+     */
+    void setLimit(size_t limit)
+    {
+        _limit = limit;
+    }
+
+    /**
+     * @brief API to get the number of watches allowed.
+     */
+    size_t getLimit() const
+    {
+        return _limit;
+    }
+
+    /**
+     * @brief API to get the number of watches in use.
+     */
+    size_t getUsed() const
+    {
+        return _used;
+    }
+
+    /**
+     * @brief API to get the number of watches available.
+     */
+    size_t getAvailable() const
+    {
+        return _used < _limit ? _limit - _used : 0;
+    }
+
+  private:
+    /**
+     * @brief The number of watches allowed.
+     */
+    size_t _limit;
+
+    /**
+     * @brief The number of watches in use.
+     */
+    size_t _used{0};
+};
+
+} // namespace data_sync::watch::inotify
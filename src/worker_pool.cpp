@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "config.h"
+
+#include "worker_pool.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+namespace data_sync::worker
+{
+
+WorkerPool::WorkerPool(size_t threads)
+{
+    _workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i)
+    {
+        _workers.emplace_back([this](const std::stop_token& stopToken) {
+            workerLoop(stopToken);
+        });
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    for (auto& worker : _workers)
+    {
+        worker.request_stop();
+    }
+    _jobQueued.notify_all();
+}
+
+WorkerPool& WorkerPool::instance()
+{
+    static WorkerPool workerPool(WORKER_THREADS);
+    return workerPool;
+}
+
+void WorkerPool::post(std::function<void()> job)
+{
+    {
+        std::scoped_lock lock(_mutex);
+        _jobs.emplace_back(std::move(job));
+    }
+    _jobQueued.notify_one();
+}
+
+void WorkerPool::workerLoop(const std::stop_token& stopToken)
+{
+    while (true)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock lock(_mutex);
+            if (!_jobQueued.wait(lock, stopToken,
+                                 [this] { return !_jobs.empty(); }))
+            {
+                // Stop requested
+                return;
+            }
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+        }
+
+        try
+        {
+            job();
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error("Worker job failed, Error : {ERROR}", "ERROR", e);
+        }
+    }
+}
+
+} // namespace data_sync::worker
@@ -0,0 +1,193 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "utility.hpp"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <sdbusplus/async.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace data_sync::worker
+{
+
+/**
+ * @class WorkerPool
+ *
+ * @brief Runs the blocking filesystem and parse jobs on the worker threads so
+ *        that they don't block the D-Bus event loop, and resumes the awaiting
+ *        coroutine on the event loop once the job is done.
+ *
+ * The jobs must not touch any state which is owned by the event loop, they
+ *        should take their inputs by value and return their outputs.
+ */
+class WorkerPool
+{
+  public:
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] threads - The number of worker threads, 0 runs the jobs
+     *                      inline on the event loop
+     */
+    explicit WorkerPool(size_t threads);
+
+    /**
+     * @brief Destructor, waits for the running jobs and drops the queued ones.
+     */
+    ~WorkerPool();
+
+    /**
+     * @brief API to get the worker pool of the daemon.
+     */
+    static WorkerPool& instance();
+
+    /**
+     * @brief API to run the given job on a worker thread.
+     *
+     * @param[in] ctx - The async context object to resume on
+     * @param[in] job - The callable to run
+     *
+     * @return The result of the job, the exception thrown by the job is
+     *         rethrown to the caller.
+     */
+    template <typename Func>
+    // NOLINTNEXTLINE
+    sdbusplus::async::task<std::invoke_result_t<Func>>
+        run(sdbusplus::async::context& ctx, Func job);
+
+  private:
+    /**
+     * @brief The state shared between the awaiting coroutine and the worker
+     *        thread, as either one can outlive the other.
+     */
+    template <typename Result>
+    struct JobState
+    {
+        JobState() : doneFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {}
+
+        utility::FD doneFd;
+        std::atomic<bool> done{false};
+        std::optional<std::conditional_t<std::is_void_v<Result>,
+                                         std::monostate, Result>>
+            result;
+        std::exception_ptr exception;
+    };
+
+    /**
+     * @brief API to queue a job for the worker threads.
+     *
+     * @param[in] job - The job to queue
+     */
+    void post(std::function<void()> job);
+
+    /**
+     * @brief The worker thread loop which runs the queued jobs.
+     *
+     * @param[in] stopToken - The token to stop the worker thread
+     */
+    void workerLoop(const std::stop_token& stopToken);
+
+    /**
+     * @brief Protects the job queue.
+     */
+    std::mutex _mutex;
+
+    /**
+     * @brief Signals the queued jobs to the worker threads.
+     */
+    std::condition_variable_any _jobQueued;
+
+    /**
+     * @brief The jobs waiting for a worker thread.
+     */
+    std::deque<std::function<void()>> _jobs;
+
+    /**
+     * @brief The worker threads.
+     */
+    std::vector<std::jthread> _workers;
+};
+
+template <typename Func>
+// NOLINTNEXTLINE
+sdbusplus::async::task<std::invoke_result_t<Func>>
+    WorkerPool::run(sdbusplus::async::context& ctx, Func job)
+{
+    using Result = std::invoke_result_t<Func>;
+
+    if (_workers.empty())
+    {
+        co_return job();
+    }
+
+    auto state = std::make_shared<JobState<Result>>();
+    if (state->doneFd() == -1)
+    {
+        throw std::runtime_error("Failed to create the eventfd for the job");
+    }
+
+    post([state, job = std::move(job)]() mutable {
+        try
+        {
+            if constexpr (std::is_void_v<Result>)
+            {
+                job();
+                state->result.emplace();
+            }
+            else
+            {
+                state->result.emplace(job());
+            }
+        }
+        catch (...)
+        {
+            state->exception = std::current_exception();
+        }
+        state->done.store(true, std::memory_order_release);
+
+        uint64_t count{1};
+        [[maybe_unused]] auto rc = write(state->doneFd(), &count,
+                                         sizeof(count));
+    });
+
+    auto fdioInstance = std::make_unique<sdbusplus::async::fdio>(
+        ctx, state->doneFd());
+    while (!state->done.load(std::memory_order_acquire))
+    {
+        // NOLINTNEXTLINE
+        co_await fdioInstance->next();
+    }
+
+    if (state->exception)
+    {
+        std::rethrow_exception(state->exception);
+    }
+    if constexpr (!std::is_void_v<Result>)
+    {
+        co_return std::move(*state->result);
+    }
+}
+
+} // namespace data_sync::worker
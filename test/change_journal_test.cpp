@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "change_journal.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+namespace journal = data_sync::journal;
+
+class ChangeJournalTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char tmpdir[] = "/tmp/pdsChangeJournalXXXXXX";
+        tmpDir = mkdtemp(tmpdir);
+        journalFile = tmpDir / "changeJournal.log";
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(tmpDir);
+    }
+
+    size_t countRecords() const
+    {
+        std::ifstream journalLog(journalFile);
+        std::string line;
+        size_t records{0};
+        while (std::getline(journalLog, line))
+        {
+            ++records;
+        }
+        return records;
+    }
+
+    fs::path tmpDir;
+    fs::path journalFile;
+    const fs::path cfgDir{"/var/lib/data/"};
+};
+
+TEST_F(ChangeJournalTest, DedupAndParentDirCoversChildren)
+{
+    journal::ChangeJournal changeJournal(journalFile);
+    EXPECT_TRUE(changeJournal.empty());
+
+    changeJournal.add(cfgDir, cfgDir / "sub" / "file1");
+    changeJournal.add(cfgDir, cfgDir / "sub" / "file1");
+    changeJournal.add(cfgDir, cfgDir / "sub" / "file2");
+    EXPECT_EQ(changeJournal.size(), 2U);
+
+    // The directory replaces its journaled children
+    changeJournal.add(cfgDir, cfgDir / "sub" / "");
+    EXPECT_EQ(changeJournal.size(), 1U);
+    EXPECT_TRUE(
+        changeJournal.getEntries().at(cfgDir).contains(cfgDir / "sub" / ""));
+
+    // The journaled directory covers the new changes under it
+    changeJournal.add(cfgDir, cfgDir / "sub" / "file3");
+    EXPECT_EQ(changeJournal.size(), 1U);
+
+    changeJournal.remove(cfgDir, cfgDir / "sub" / "");
+    EXPECT_TRUE(changeJournal.empty());
+}
+
+TEST_F(ChangeJournalTest, CollapseChildrenIntoParent)
+{
+    constexpr size_t collapseThreshold = 4;
+    journal::ChangeJournal changeJournal(journalFile, 100, collapseThreshold);
+
+    for (size_t i = 0; i <= collapseThreshold; ++i)
+    {
+        changeJournal.add(cfgDir,
+                          cfgDir / "sub" / ("file" + std::to_string(i)));
+    }
+
+    ASSERT_EQ(changeJournal.size(), 1U);
+    EXPECT_TRUE(
+        changeJournal.getEntries().at(cfgDir).contains(cfgDir / "sub" / ""));
+
+    // The files of the configured file paths are never collapsed into their
+    // parent directory which is not configured.
+    for (size_t i = 0; i <= collapseThreshold; ++i)
+    {
+        fs::path cfgFile = "/etc/file" + std::to_string(i);
+        changeJournal.add(cfgFile, cfgFile);
+    }
+    EXPECT_EQ(changeJournal.size(), collapseThreshold + 2);
+}
+
+TEST_F(ChangeJournalTest, OverflowNeedsFullSync)
+{
+    constexpr size_t maxEntries = 3;
+    journal::ChangeJournal changeJournal(journalFile, maxEntries);
+
+    for (size_t i = 0; i <= maxEntries; ++i)
+    {
+        changeJournal.add(cfgDir, cfgDir / ("file" + std::to_string(i)));
+    }
+
+    EXPECT_TRUE(changeJournal.isOverflowed());
+    EXPECT_FALSE(changeJournal.empty());
+    EXPECT_EQ(changeJournal.size(), 0U);
+
+    // The changes are not tracked until the journal is cleared
+    changeJournal.add(cfgDir, cfgDir / "file1");
+    EXPECT_EQ(changeJournal.size(), 0U);
+
+    changeJournal.clear();
+    EXPECT_FALSE(changeJournal.isOverflowed());
+    EXPECT_TRUE(changeJournal.empty());
+}
+
+TEST_F(ChangeJournalTest, RestoreAfterRestart)
+{
+    {
+        journal::ChangeJournal changeJournal(journalFile);
+        changeJournal.add(cfgDir, cfgDir / "file1");
+        changeJournal.add("/etc/file", "/etc/file");
+    }
+
+    journal::ChangeJournal changeJournal(journalFile);
+    EXPECT_FALSE(changeJournal.isOverflowed());
+    ASSERT_EQ(changeJournal.size(), 2U);
+    EXPECT_TRUE(changeJournal.getEntries().at(cfgDir).contains(cfgDir /
+                                                               "file1"));
+    EXPECT_TRUE(
+        changeJournal.getEntries().at("/etc/file").contains("/etc/file"));
+
+    changeJournal.markOverflowed();
+    journal::ChangeJournal overflowedJournal(journalFile);
+    EXPECT_TRUE(overflowedJournal.isOverflowed());
+}
+
+TEST_F(ChangeJournalTest, AppendChangesAndCompactOnRestore)
+{
+    {
+        journal::ChangeJournal changeJournal(journalFile);
+        changeJournal.add(cfgDir, cfgDir / "file1");
+        changeJournal.add(cfgDir, cfgDir / "file2");
+        changeJournal.add(cfgDir, cfgDir / "file3");
+        changeJournal.remove(cfgDir, cfgDir / "file2");
+
+        // Each change is appended rather than rewriting the journal
+        EXPECT_EQ(countRecords(), 4U);
+    }
+
+    // The last record is torn by a power loss while appending it
+    {
+        std::ofstream journalLog(journalFile, std::ios::app);
+        journalLog << R"(["+","/var/lib/data/","/var/lib/da)";
+    }
+
+    journal::ChangeJournal changeJournal(journalFile);
+    EXPECT_FALSE(changeJournal.isOverflowed());
+    ASSERT_EQ(changeJournal.size(), 2U);
+    EXPECT_TRUE(changeJournal.getEntries().at(cfgDir).contains(cfgDir /
+                                                               "file1"));
+    EXPECT_TRUE(changeJournal.getEntries().at(cfgDir).contains(cfgDir /
+                                                               "file3"));
+
+    // Compacted into the journaled paths on restoring
+    EXPECT_EQ(countRecords(), 2U);
+
+    // Emptied by removing the last journaled path
+    changeJournal.remove(cfgDir, cfgDir / "file1");
+    changeJournal.remove(cfgDir, cfgDir / "file3");
+    EXPECT_EQ(countRecords(), 0U);
+}
+
+TEST_F(ChangeJournalTest, CompactOnceLogGrows)
+{
+    constexpr size_t maxEntries = 2;
+    journal::ChangeJournal changeJournal(journalFile, maxEntries);
+
+    changeJournal.add(cfgDir, cfgDir / "file0");
+    for (size_t i = 0;
+         i < journal::ChangeJournal::compactionFactor * maxEntries; ++i)
+    {
+        changeJournal.add(cfgDir, cfgDir / "file1");
+        changeJournal.remove(cfgDir, cfgDir / "file1");
+    }
+
+    // Bounded by the compacted entries and the records appended since
+    EXPECT_LE(countRecords(),
+              (journal::ChangeJournal::compactionFactor + 1) * maxEntries);
+
+    journal::ChangeJournal restoredJournal(journalFile, maxEntries);
+    ASSERT_EQ(restoredJournal.size(), 1U);
+    EXPECT_TRUE(restoredJournal.getEntries().at(cfgDir).contains(cfgDir /
+                                                                 "file0"));
+}
@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "content_fingerprint.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+namespace fingerprint = data_sync::fingerprint;
+
+namespace
+{
+
+uint64_t hashOf(std::string_view data, uint64_t seed = 0)
+{
+    return fingerprint::xxh64(
+        {reinterpret_cast<const uint8_t*>(data.data()), data.size()}, seed);
+}
+
+} // namespace
+
+class ContentFingerprintTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char tmpdir[] = "/tmp/pdsContentFingerprintXXXXXX";
+        tmpDir = mkdtemp(tmpdir);
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(tmpDir);
+    }
+
+    static void writeData(const fs::path& fileName, const std::string& data)
+    {
+        std::ofstream out(fileName);
+        ASSERT_TRUE(out.is_open()) << "Failed to open " << fileName;
+        out << data;
+        out.close();
+    }
+
+    fs::path tmpDir;
+};
+
+TEST_F(ContentFingerprintTest, MatchesReferenceHashes)
+{
+    EXPECT_EQ(hashOf(""), 0xEF46DB3751D8E999ULL);
+    EXPECT_EQ(hashOf("abc"), 0x44BC2CF5AD770999ULL);
+    EXPECT_EQ(hashOf("The quick brown fox jumps over the lazy dog"),
+              0x0B242D361FDA71BCULL);
+    EXPECT_EQ(hashOf("The quick brown fox jumps over the lazy dog", 2026),
+              0xFBF69EBA0A8C605CULL);
+}
+
+TEST_F(ContentFingerprintTest, DropsUnchangedWritesOnceSynced)
+{
+    fingerprint::FingerprintCache cache;
+    const auto file = tmpDir / "file";
+
+    writeData(file, "Data1");
+    EXPECT_FALSE(cache.isUnchanged(file));
+
+    // Not synced yet, hence the same content is still a change
+    EXPECT_FALSE(cache.isUnchanged(file));
+    cache.commit(file);
+    EXPECT_TRUE(cache.isUnchanged(file));
+
+    writeData(file, "Data2");
+    EXPECT_FALSE(cache.isUnchanged(file));
+    cache.commit(file);
+
+    // The large files are hashed in chunks
+    const std::string largeData(1024 * 1024, 'x');
+    writeData(file, largeData);
+    EXPECT_FALSE(cache.isUnchanged(file));
+    cache.commit(file);
+    writeData(file, largeData);
+    EXPECT_TRUE(cache.isUnchanged(file));
+
+    cache.forget(tmpDir / "");
+    EXPECT_FALSE(cache.isUnchanged(file));
+
+    const auto& stats = cache.getStats();
+    EXPECT_EQ(stats.lookups, 7U);
+    EXPECT_EQ(stats.hits, 2U);
+    EXPECT_EQ(stats.bytesHashed, 5U * 4 + 3 * largeData.size());
+}
+
+TEST_F(ContentFingerprintTest, ChecksTheFingerprintTakenEarlier)
+{
+    fingerprint::FingerprintCache cache;
+    const auto file = tmpDir / "file";
+
+    writeData(file, "Data1");
+    EXPECT_FALSE(cache.isUnchanged(file));
+    cache.commit(file);
+
+    // Taken off the event loop before the lookup, and the file changes later
+    const auto timedFingerprint = fingerprint::getTimedFingerprint(file);
+    ASSERT_TRUE(timedFingerprint.fingerprint.has_value());
+    writeData(file, "Data2");
+    EXPECT_TRUE(cache.isUnchanged(file, timedFingerprint));
+
+    // Gone before it is hashed
+    EXPECT_FALSE(cache.isUnchanged(
+        file, fingerprint::getTimedFingerprint(tmpDir / "missing")));
+    EXPECT_FALSE(cache.isUnchanged(file, timedFingerprint));
+
+    const auto& stats = cache.getStats();
+    EXPECT_EQ(stats.lookups, 4U);
+    EXPECT_EQ(stats.hits, 1U);
+}
+
+TEST_F(ContentFingerprintTest, HashesInChunksAsAWhole)
+{
+    const auto file = tmpDir / "file";
+
+    // Spans several chunks and ends in the middle of a stripe
+    std::string data(3 * 64 * 1024 + 45, '\0');
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<char>((i * 31) % 251);
+    }
+    writeData(file, data);
+
+    const auto fingerprint = fingerprint::getFingerprint(file);
+    ASSERT_TRUE(fingerprint.has_value());
+    EXPECT_EQ(fingerprint->size, data.size());
+    EXPECT_EQ(fingerprint->hash, hashOf(data));
+}
@@ -488,3 +488,77 @@ TEST(DataSyncConfigParserTest, TestSyncConfigWithSelectivePathSiblingNotify)
     EXPECT_EQ(dataSyncConfig._excludeList, std::nullopt);
     EXPECT_EQ(dataSyncConfig._includeList, std::nullopt);
 }
+
+/*
+ * Test when the input JSON contains the consistency group of the file.
+ */
+TEST(DataSyncConfigParserTest, TestFileSyncWithConsistencyGroup)
+{
+    const auto configJSON = R"(
+        {
+            "Path": "/file/path/to/sync",
+            "Description": "Add details about the data and purpose of the synchronization",
+            "SyncDirection": "Active2Passive",
+            "SyncType": "Immediate",
+            "ConsistencyGroup": "DataAndChecksum"
+        }
+    )"_json;
+
+    data_sync::config::DataSyncConfig dataSyncConfig(configJSON, false);
+
+    EXPECT_EQ(dataSyncConfig._path, "/file/path/to/sync");
+    EXPECT_EQ(dataSyncConfig._consistencyGroup, "DataAndChecksum");
+
+    auto ungroupedJSON = configJSON;
+    ungroupedJSON.erase("ConsistencyGroup");
+    data_sync::config::DataSyncConfig ungroupedConfig(ungroupedJSON, false);
+
+    EXPECT_EQ(ungroupedConfig._consistencyGroup, std::nullopt);
+    EXPECT_FALSE(ungroupedConfig == dataSyncConfig);
+}
+
+/*
+ * Test whether the changed paths are matched against the NotifyOnPaths as the
+ * same paths or the paths under them.
+ */
+TEST(DataSyncConfigParserTest, TestNotifyOnPathsMatching)
+{
+    const auto configJSON = R"(
+        {
+            "Path": "/directory/path/to/sync/",
+            "Description": "Add details about the data and purpose of the synchronization",
+            "SyncDirection": "Active2Passive",
+            "SyncType": "Periodic",
+            "Periodicity": "PT1M",
+            "NotifySibling" : {
+                "NotifyOnPaths" : ["/directory/path/to/sync/file",
+                                   "/directory/path/to/sync/dir/"],
+                "Mode": "Systemd",
+                "Method": "Restart",
+                "NotifyServices": ["service1"]
+            }
+        }
+    )"_json;
+
+    data_sync::config::DataSyncConfig dataSyncConfig(configJSON, true);
+    ASSERT_TRUE(dataSyncConfig._notifySibling.has_value());
+    const auto& notifySibling = dataSyncConfig._notifySibling.value();
+
+    EXPECT_TRUE(
+        notifySibling.needsNotification("/directory/path/to/sync/file"));
+    EXPECT_TRUE(notifySibling.needsNotification("/directory/path/to/sync/dir"));
+    EXPECT_TRUE(
+        notifySibling.needsNotification("/directory/path/to/sync/dir/sub/f"));
+    EXPECT_FALSE(notifySibling.needsNotification("/directory/path/to/sync/"));
+    EXPECT_FALSE(
+        notifySibling.needsNotification("/directory/path/to/sync/file2"));
+    EXPECT_FALSE(
+        notifySibling.needsNotification("/directory/path/to/sync/other"));
+
+    // Every change needs the notification without the NotifyOnPaths
+    auto allPathsJSON = configJSON;
+    allPathsJSON["NotifySibling"].erase("NotifyOnPaths");
+    data_sync::config::DataSyncConfig allPathsConfig(allPathsJSON, true);
+    EXPECT_TRUE(allPathsConfig._notifySibling.value().needsNotification(
+        "/directory/path/to/sync/other"));
+}
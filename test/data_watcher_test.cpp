@@ -0,0 +1,308 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "data_watcher.hpp"
+#include "watch_budget.hpp"
+
+#include <sdbusplus/async.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+namespace inotify = data_sync::watch::inotify;
+using namespace std::chrono_literals;
+
+class DataWatcherTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char tmpdir[] = "/tmp/pdsDataWatcherXXXXXX";
+        tmpDir = mkdtemp(tmpdir);
+        dataDir = tmpDir / "data" / "";
+        fs::create_directories(dataDir);
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(tmpDir);
+    }
+
+    static void writeData(const fs::path& fileName, const std::string& data)
+    {
+        std::ofstream out(fileName);
+        ASSERT_TRUE(out.is_open()) << "Failed to open " << fileName;
+        out << data;
+        out.close();
+    }
+
+    static void initSnapshot(sdbusplus::async::context& ctx,
+                             inotify::DataWatcher& watcher)
+    {
+        auto init = [&]() -> sdbusplus::async::task<> {
+            co_await watcher.initSnapshot();
+            ctx.request_stop();
+            co_return;
+        };
+        ctx.spawn(init());
+        ctx.run();
+    }
+
+    static bool contains(const inotify::DataOperations& dataOps,
+                         const fs::path& path, inotify::DataOps dataOp)
+    {
+        return std::ranges::find(dataOps, inotify::DataOperation{path,
+                                                                 dataOp}) !=
+               dataOps.end();
+    }
+
+    static constexpr uint32_t eventMasks = IN_CLOSE_WRITE | IN_MOVE |
+                                           IN_DELETE_SELF | IN_CREATE |
+                                           IN_DELETE;
+
+    fs::path tmpDir;
+    fs::path dataDir;
+};
+
+TEST_F(DataWatcherTest, OverflowRescansChangedEntries)
+{
+    writeData(dataDir / "file1", "Data1");
+    writeData(dataDir / "file2", "Data2");
+    writeData(dataDir / "file3", "Data3");
+    fs::create_directories(dataDir / "dir1" / "dir2");
+    writeData(dataDir / "dir1" / "dir2" / "file4", "Data4");
+
+    sdbusplus::async::context ctx;
+    inotify::DataWatcher watcher(ctx, IN_NONBLOCK, eventMasks, dataDir);
+    initSnapshot(ctx, watcher);
+
+    // The changes while the events are lost
+    writeData(dataDir / "file1", "Modified");
+    fs::last_write_time(dataDir / "file1",
+                        fs::last_write_time(dataDir / "file1") + 1s);
+    fs::remove(dataDir / "file2");
+    fs::remove_all(dataDir / "dir1");
+    fs::create_directories(dataDir / "newDir" / "subDir");
+    writeData(dataDir / "newDir" / "subDir" / "file5", "Data5");
+
+    auto dataOps = watcher.replayEvents({{-1, "", IN_Q_OVERFLOW, 0}});
+
+    EXPECT_EQ(dataOps.size(), 4U);
+    EXPECT_TRUE(contains(dataOps, dataDir / "file1", inotify::DataOps::COPY));
+    EXPECT_TRUE(
+        contains(dataOps, dataDir / "file2", inotify::DataOps::DELETE));
+    EXPECT_TRUE(contains(dataOps, dataDir / "dir1", inotify::DataOps::DELETE));
+    EXPECT_TRUE(
+        contains(dataOps, dataDir / "newDir" / "", inotify::DataOps::COPY));
+
+    // The new directories are watched for the further changes
+    EXPECT_TRUE(
+        watcher.getWatchDescriptor(dataDir / "newDir" / "subDir" / "")
+            .has_value());
+
+    const auto& rescanStats = watcher.getRescanStats();
+    EXPECT_EQ(rescanStats.rescans, 1U);
+    EXPECT_EQ(rescanStats.fallbacks, 0U);
+    EXPECT_EQ(rescanStats.lastScannedEntries, 6U);
+
+    // Nothing changed since the last rescan
+    dataOps = watcher.replayEvents({{-1, "", IN_Q_OVERFLOW, 0}});
+    EXPECT_TRUE(dataOps.empty());
+    EXPECT_EQ(watcher.getRescanStats().rescans, 2U);
+}
+
+TEST_F(DataWatcherTest, OverflowSyncsWholePathIfTreeTooLarge)
+{
+    for (size_t i = 0; i < inotify::DataWatcher::maxSnapshotEntries; ++i)
+    {
+        std::ofstream(dataDir / ("file" + std::to_string(i)));
+    }
+
+    sdbusplus::async::context ctx;
+    inotify::DataWatcher watcher(ctx, IN_NONBLOCK, eventMasks, dataDir);
+    initSnapshot(ctx, watcher);
+
+    auto dataOps = watcher.replayEvents({{-1, "", IN_Q_OVERFLOW, 0}});
+
+    ASSERT_EQ(dataOps.size(), 1U);
+    EXPECT_EQ(dataOps[0].first, dataDir);
+    EXPECT_EQ(dataOps[0].second, inotify::DataOps::COPY);
+    EXPECT_EQ(watcher.getRescanStats().fallbacks, 1U);
+}
+
+TEST_F(DataWatcherTest, DeletedDirDropsOnlyItsSnapshotEntries)
+{
+    fs::create_directories(dataDir / "dir1" / "subDir");
+    fs::create_directories(dataDir / "dir10");
+    writeData(dataDir / "dir1" / "subDir" / "file1", "Data1");
+    writeData(dataDir / "dir10" / "file2", "Data2");
+
+    sdbusplus::async::context ctx;
+    inotify::DataWatcher watcher(ctx, IN_NONBLOCK, eventMasks, dataDir);
+    initSnapshot(ctx, watcher);
+    auto rootWd = watcher.getWatchDescriptor(dataDir);
+    ASSERT_TRUE(rootWd.has_value());
+
+    fs::remove_all(dataDir / "dir1");
+    auto dataOps =
+        watcher.replayEvents({{*rootWd, "dir1", IN_DELETE | IN_ISDIR, 0}});
+    EXPECT_EQ(watcher.getRescanStats().rescans, 0U);
+
+    // The sibling with the same prefix is still in the snapshot
+    dataOps = watcher.replayEvents({{-1, "", IN_Q_OVERFLOW, 0}});
+    EXPECT_TRUE(dataOps.empty());
+    EXPECT_EQ(watcher.getRescanStats().lastScannedEntries, 3U);
+}
+
+TEST_F(DataWatcherTest, PollsSubtreesBeyondWatchBudget)
+{
+    fs::create_directories(dataDir / "dir1");
+    fs::create_directories(dataDir / "dir2" / "dir3");
+    writeData(dataDir / "dir1" / "file1", "Data1");
+
+    // Only the configured path itself can be watched
+    auto& watchBudget = inotify::WatchBudget::instance();
+    const auto limit = watchBudget.getLimit();
+    watchBudget.setLimit(watchBudget.getUsed() + 1);
+
+    sdbusplus::async::context ctx;
+    inotify::DataWatcher watcher(ctx, IN_NONBLOCK, eventMasks, dataDir);
+
+    EXPECT_TRUE(watcher.getWatchDescriptor(dataDir).has_value());
+    EXPECT_FALSE(watcher.getWatchDescriptor(dataDir / "dir1" / "").has_value());
+    EXPECT_TRUE(watcher.hasPolledSubtrees());
+    EXPECT_EQ(watcher.getPolledSubtrees().size(), 2U);
+    EXPECT_TRUE(watcher.pollSubtrees().empty());
+
+    writeData(dataDir / "dir1" / "file1", "Modified");
+    fs::last_write_time(dataDir / "dir1" / "file1",
+                        fs::last_write_time(dataDir / "dir1" / "file1") + 1s);
+    writeData(dataDir / "dir2" / "dir3" / "file2", "Data2");
+
+    auto dataOps = watcher.pollSubtrees();
+    EXPECT_EQ(dataOps.size(), 2U);
+    EXPECT_TRUE(contains(dataOps, dataDir / "dir1" / "file1",
+                         inotify::DataOps::COPY));
+    EXPECT_TRUE(contains(dataOps, dataDir / "dir2" / "dir3" / "file2",
+                         inotify::DataOps::COPY));
+
+    // The changing subtrees are watched once the budget allows
+    watchBudget.setLimit(limit);
+    fs::remove(dataDir / "dir1" / "file1");
+    dataOps = watcher.pollSubtrees();
+    ASSERT_EQ(dataOps.size(), 1U);
+    EXPECT_TRUE(contains(dataOps, dataDir / "dir1" / "file1",
+                         inotify::DataOps::DELETE));
+    EXPECT_TRUE(watcher.getWatchDescriptor(dataDir / "dir1" / "").has_value());
+    EXPECT_EQ(std::ranges::count(watcher.getPolledSubtrees(),
+                                 dataDir / "dir1"),
+              0);
+}
+
+TEST_F(DataWatcherTest, SkipQueuedEventsOfDemotedSubtree)
+{
+    fs::create_directories(dataDir / "dir1");
+    fs::create_directories(dataDir / "dir2");
+    writeData(dataDir / "dir1" / "file1", "Data1");
+    writeData(dataDir / "dir2" / "file2", "Data2");
+
+    // Just the configured path and its two subdirectories can be watched
+    auto& watchBudget = inotify::WatchBudget::instance();
+    const auto limit = watchBudget.getLimit();
+    watchBudget.setLimit(watchBudget.getUsed() + 3);
+
+    sdbusplus::async::context ctx;
+    inotify::DataWatcher watcher(ctx, IN_NONBLOCK, eventMasks, dataDir);
+    auto rootWd = watcher.getWatchDescriptor(dataDir);
+    auto dir1Wd = watcher.getWatchDescriptor(dataDir / "dir1" / "");
+    auto dir2Wd = watcher.getWatchDescriptor(dataDir / "dir2" / "");
+    ASSERT_TRUE(rootWd.has_value());
+    ASSERT_TRUE(dir1Wd.has_value());
+    ASSERT_TRUE(dir2Wd.has_value());
+    EXPECT_FALSE(watcher.hasPolledSubtrees());
+    size_t pollingStarted{0};
+    watcher.setPollingStartedCallback([&pollingStarted]() {
+        ++pollingStarted;
+    });
+
+    // The new directory demotes the colder dir1, while its event is queued
+    fs::create_directories(dataDir / "dir3");
+    inotify::DataOperations dataOps;
+    EXPECT_NO_THROW(
+        dataOps = watcher.replayEvents(
+            {{*dir2Wd, "file2", IN_CLOSE_WRITE, 0},
+             {*rootWd, "dir3", IN_CREATE | IN_ISDIR, 0},
+             {*dir1Wd, "file1", IN_CLOSE_WRITE, 0}}));
+
+    EXPECT_FALSE(watcher.getWatchDescriptor(dataDir / "dir1" / "").has_value());
+    EXPECT_TRUE(watcher.getWatchDescriptor(dataDir / "dir3" / "").has_value());
+    EXPECT_EQ(watcher.getPolledSubtrees(),
+              (std::vector<fs::path>{dataDir / "dir1"}));
+    EXPECT_EQ(pollingStarted, 1U);
+    EXPECT_EQ(dataOps.size(), 2U);
+    EXPECT_TRUE(contains(dataOps, dataDir / "dir2" / "file2",
+                         inotify::DataOps::COPY));
+    EXPECT_TRUE(
+        contains(dataOps, dataDir / "dir3" / "", inotify::DataOps::COPY));
+
+    watchBudget.setLimit(limit);
+}
+
+TEST_F(DataWatcherTest, RenameWithinConfiguredPath)
+{
+    fs::create_directories(dataDir / "dir1" / "subDir");
+    writeData(dataDir / "file1", "Data1");
+
+    sdbusplus::async::context ctx;
+    inotify::DataWatcher watcher(ctx, IN_NONBLOCK, eventMasks, dataDir);
+    auto rootWd = watcher.getWatchDescriptor(dataDir);
+    ASSERT_TRUE(rootWd.has_value());
+
+    fs::rename(dataDir / "file1", dataDir / "file2");
+    fs::rename(dataDir / "dir1", dataDir / "dir2");
+    auto dataOps = watcher.replayEvents(
+        {{*rootWd, "file1", IN_MOVED_FROM, 10},
+         {*rootWd, "file2", IN_MOVED_TO, 10},
+         {*rootWd, "dir1", IN_MOVED_FROM | IN_ISDIR, 11},
+         {*rootWd, "dir2", IN_MOVED_TO | IN_ISDIR, 11}});
+
+    ASSERT_EQ(dataOps.size(), 2U);
+    EXPECT_TRUE(
+        contains(dataOps, dataDir / "file2", inotify::DataOps::RENAME));
+    EXPECT_TRUE(contains(dataOps, dataDir / "dir2", inotify::DataOps::RENAME));
+    EXPECT_EQ(watcher.getRenames().at(dataDir / "file2"), dataDir / "file1");
+    EXPECT_EQ(watcher.getRenames().at(dataDir / "dir2"), dataDir / "dir1");
+
+    // The watches follow the renamed directories
+    EXPECT_FALSE(
+        watcher.getWatchDescriptor(dataDir / "dir1" / "subDir" / "")
+            .has_value());
+    EXPECT_TRUE(watcher.getWatchDescriptor(dataDir / "dir2" / "subDir" / "")
+                    .has_value());
+}
+
+TEST_F(DataWatcherTest, UnmatchedMovesAreBounded)
+{
+    sdbusplus::async::context ctx;
+    inotify::DataWatcher watcher(ctx, IN_NONBLOCK, eventMasks, dataDir);
+    auto rootWd = watcher.getWatchDescriptor(dataDir);
+    ASSERT_TRUE(rootWd.has_value());
+
+    // Moved out of the configured path
+    std::vector<inotify::EventInfo> events;
+    for (uint32_t cookie = 1;
+         cookie <= inotify::DataWatcher::maxUnmatchedMoves + 10; ++cookie)
+    {
+        events.emplace_back(*rootWd, "file" + std::to_string(cookie),
+                            IN_MOVED_FROM, cookie);
+    }
+    auto dataOps = watcher.replayEvents(events);
+    EXPECT_EQ(dataOps.size(), inotify::DataWatcher::maxUnmatchedMoves + 10);
+
+    watcher.replayEvents({});
+    EXPECT_EQ(watcher.getUnmatchedMoves(),
+              inotify::DataWatcher::maxUnmatchedMoves);
+}
@@ -0,0 +1,293 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "echo_suppressor.hpp"
+
+#include <sys/stat.h>
+
+#include <array>
+#include <chrono>
+#include <ctime>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+namespace echo = data_sync::echo;
+using data_sync::watch::inotify::DataOps;
+
+class EchoSuppressorTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char tmpdir[] = "/tmp/pdsEchoSuppressorXXXXXX";
+        tmpDir = mkdtemp(tmpdir);
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(tmpDir);
+    }
+
+    static void writeData(const fs::path& fileName, const std::string& data)
+    {
+        std::ofstream out(fileName);
+        ASSERT_TRUE(out.is_open()) << "Failed to open " << fileName;
+        out << data;
+        out.close();
+    }
+
+    // Logs the applied change in the rsync daemon log format, along with the
+    // modification time and the size of the path as applied
+    static void logApplied(const fs::path& log, const std::string& op,
+                           const fs::path& path, bool newline = true)
+    {
+        struct stat pathStat{};
+        lstat(path.c_str(), &pathStat);
+        std::tm time{};
+        localtime_r(&pathStat.st_mtime, &time);
+        std::array<char, 32> modifiedTime{};
+        std::strftime(modifiedTime.data(), modifiedTime.size(),
+                      "%Y/%m/%d-%H:%M:%S", &time);
+
+        std::ofstream out(log, std::ios::app);
+        out << "2026/01/01 10:00:00 [1234] " << op << " "
+            << modifiedTime.data() << " " << pathStat.st_size << " "
+            << path.relative_path().string() << (newline ? "\n" : "");
+    }
+
+    static bool trackAll([[maybe_unused]] const fs::path& path)
+    {
+        return true;
+    }
+
+    fs::path tmpDir;
+};
+
+TEST_F(EchoSuppressorTest, SuppressesOnlyTheAppliedContent)
+{
+    const auto log = tmpDir / "applied.log";
+    echo::EchoSuppressor suppressor(log);
+
+    const auto file = tmpDir / "file";
+    const auto deleted = tmpDir / "deleted";
+    const auto dir = tmpDir / "dir";
+    writeData(file, "FromSibling");
+    fs::create_directory(dir);
+
+    std::ofstream(log) << "2026/01/01 10:00:00 [1234] connect from localhost\n";
+    logApplied(log, "recv", file);
+    logApplied(log, "recv", dir / "");
+    logApplied(log, "del.", deleted);
+    suppressor.drain(trackAll);
+
+    EXPECT_TRUE(suppressor.isEcho(file, DataOps::COPY));
+    EXPECT_TRUE(suppressor.isEcho(dir / "", DataOps::COPY));
+    EXPECT_TRUE(suppressor.isEcho(deleted, DataOps::DELETE));
+    EXPECT_FALSE(suppressor.isEcho(file, DataOps::DELETE));
+    EXPECT_FALSE(suppressor.isEcho(tmpDir / "other", DataOps::COPY));
+
+    // The local changes made after the applied ones are not echoes
+    writeData(file, "Local");
+    writeData(deleted, "Recreated");
+    EXPECT_FALSE(suppressor.isEcho(file, DataOps::COPY));
+    EXPECT_FALSE(suppressor.isEcho(deleted, DataOps::COPY));
+    EXPECT_EQ(suppressor.getSuppressedCount(), 3);
+
+    // The untracked paths are ignored
+    logApplied(log, "recv", file);
+    suppressor.drain([](const fs::path&) { return false; });
+    EXPECT_FALSE(suppressor.isEcho(file, DataOps::COPY));
+}
+
+TEST_F(EchoSuppressorTest, LocalChangeBeforeTheDrainIsNotAnEcho)
+{
+    using namespace std::chrono_literals;
+
+    const auto log = tmpDir / "applied.log";
+    echo::EchoSuppressor suppressor(log);
+
+    // The daemon keeps the modification time of the sibling's copy
+    const auto file = tmpDir / "file";
+    const auto removed = tmpDir / "removed";
+    writeData(file, "FromSibling");
+    writeData(removed, "FromSibling");
+    fs::last_write_time(file, fs::file_time_type::clock::now() - 10s);
+    logApplied(log, "recv", file);
+    logApplied(log, "recv", removed);
+
+    // Changed locally of the same size, and removed, before the first drain
+    writeData(file, "LocalChange");
+    fs::remove(removed);
+    suppressor.drain(trackAll);
+
+    EXPECT_FALSE(suppressor.isEcho(file, DataOps::COPY));
+    EXPECT_FALSE(suppressor.isEcho(removed, DataOps::DELETE));
+    EXPECT_EQ(suppressor.getSuppressedCount(), 0);
+
+    // Applied again, and drained before the local change
+    fs::last_write_time(file, fs::file_time_type::clock::now() - 10s);
+    logApplied(log, "recv", file);
+    suppressor.drain(trackAll);
+    EXPECT_TRUE(suppressor.isEcho(file, DataOps::COPY));
+}
+
+TEST_F(EchoSuppressorTest, LargeFilesComparedByTheirState)
+{
+    using namespace std::chrono_literals;
+
+    const auto log = tmpDir / "applied.log";
+    echo::EchoSuppressor suppressor(log);
+
+    const auto file = tmpDir / "file";
+    const std::string data(echo::EchoSuppressor::maxContentSize + 1, 'x');
+    writeData(file, data);
+    fs::last_write_time(file, fs::file_time_type::clock::now() - 10s);
+    logApplied(log, "recv", file);
+    suppressor.drain(trackAll);
+    EXPECT_TRUE(suppressor.isEcho(file, DataOps::COPY));
+
+    // Changed locally, and its modification time is updated
+    writeData(file, data + "x");
+    EXPECT_FALSE(suppressor.isEcho(file, DataOps::COPY));
+    EXPECT_EQ(suppressor.getSuppressedCount(), 1U);
+}
+
+TEST_F(EchoSuppressorTest, DrainsPartialLinesAndTruncatedLog)
+{
+    const auto log = tmpDir / "applied.log";
+    echo::EchoSuppressor suppressor(log);
+
+    // Not yet created by the daemon
+    suppressor.drain(trackAll);
+
+    const auto file = tmpDir / "file";
+    writeData(file, "FromSibling");
+
+    // The daemon is still writing the line
+    logApplied(log, "recv", file, false);
+    suppressor.drain(trackAll);
+    EXPECT_FALSE(suppressor.isEcho(file, DataOps::COPY));
+    std::ofstream(log, std::ios::app) << "\n";
+    suppressor.drain(trackAll);
+    EXPECT_TRUE(suppressor.isEcho(file, DataOps::COPY));
+
+    // Truncated by someone else, read again from the start
+    const auto other = tmpDir / "other";
+    writeData(other, "FromSibling");
+    fs::resize_file(log, 0);
+    suppressor.drain(trackAll);
+    logApplied(log, "recv", other);
+    suppressor.drain(trackAll);
+    EXPECT_TRUE(suppressor.isEcho(other, DataOps::COPY));
+
+    // Truncated once fully drained beyond the limit
+    const std::string filler(echo::EchoSuppressor::maxLogSize, 'x');
+    std::ofstream(log, std::ios::app) << filler << "\n";
+    suppressor.drain(trackAll);
+    EXPECT_EQ(fs::file_size(log), 0);
+}
+
+TEST_F(EchoSuppressorTest, PingPongStormSettles)
+{
+    // Two BMCs syncing the same Bidirectional directory to each other, each
+    // with its own rsync daemon log.
+    struct Bmc
+    {
+        fs::path dir;
+        fs::path log;
+        std::unique_ptr<echo::EchoSuppressor> suppressor;
+    };
+    std::array<Bmc, 2> bmcs;
+    for (size_t i = 0; i < bmcs.size(); ++i)
+    {
+        bmcs[i].dir = tmpDir / ("bmc" + std::to_string(i));
+        bmcs[i].log = tmpDir / ("bmc" + std::to_string(i) + ".log");
+        fs::create_directory(bmcs[i].dir);
+        bmcs[i].suppressor =
+            std::make_unique<echo::EchoSuppressor>(bmcs[i].log);
+    }
+
+    // The watcher events pending on a BMC
+    struct Event
+    {
+        size_t bmc;
+        std::string name;
+        DataOps dataOp;
+    };
+    std::deque<Event> events;
+
+    // Applies the change to the sibling like the rsync daemon does, and the
+    // sibling watcher sees it.
+    size_t outboundSyncs{0};
+    auto sync = [&bmcs, &events, &outboundSyncs](const Event& event) {
+        ++outboundSyncs;
+        const auto sibling = (event.bmc + 1) % bmcs.size();
+        const auto src = bmcs[event.bmc].dir / event.name;
+        const auto dest = bmcs[sibling].dir / event.name;
+        if (event.dataOp == DataOps::DELETE)
+        {
+            fs::remove(dest);
+            logApplied(bmcs[sibling].log, "del.", dest);
+        }
+        else
+        {
+            fs::copy_file(src, dest, fs::copy_options::overwrite_existing);
+            logApplied(bmcs[sibling].log, "recv", dest);
+        }
+        events.push_back({sibling, event.name, event.dataOp});
+    };
+
+    std::mt19937 random(2026);
+    constexpr size_t localChanges = 200;
+    constexpr size_t files = 8;
+    for (size_t change = 0; change < localChanges; ++change)
+    {
+        const size_t bmc = random() % bmcs.size();
+        const auto name = "file" + std::to_string(random() % files);
+        const auto path = bmcs[bmc].dir / name;
+        if (fs::exists(path) && random() % 3 == 0)
+        {
+            fs::remove(path);
+            events.push_back({bmc, name, DataOps::DELETE});
+        }
+        else
+        {
+            writeData(path, "Change" + std::to_string(change));
+            events.push_back({bmc, name, DataOps::COPY});
+        }
+
+        // Dispatched as the watcher reports them, bounded in case of storm
+        for (size_t dispatched = 0; !events.empty() && dispatched < 100;
+             ++dispatched)
+        {
+            auto event = events.front();
+            events.pop_front();
+            auto& suppressor = *bmcs[event.bmc].suppressor;
+            suppressor.drain(trackAll);
+            if (!suppressor.isEcho(bmcs[event.bmc].dir / event.name,
+                                   event.dataOp))
+            {
+                sync(event);
+            }
+        }
+        ASSERT_TRUE(events.empty()) << "The change " << change << " bounces";
+    }
+
+    // Every local change is synced once, and never bounced back
+    EXPECT_EQ(outboundSyncs, localChanges);
+    EXPECT_EQ(bmcs[0].suppressor->getSuppressedCount() +
+                  bmcs[1].suppressor->getSuppressedCount(),
+              localChanges);
+    for (size_t file = 0; file < files; ++file)
+    {
+        const auto name = "file" + std::to_string(file);
+        ASSERT_EQ(fs::exists(bmcs[0].dir / name),
+                  fs::exists(bmcs[1].dir / name));
+    }
+}
@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "error_log_queue.hpp"
+#include "mock_ext_data_ifaces.hpp"
+
+#include <sdbusplus/async.hpp>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace error_log = data_sync::error_log;
+namespace ext_data = data_sync::ext_data;
+using namespace std::chrono_literals;
+
+class ErrorLogQueueTest : public ::testing::Test
+{
+  protected:
+    static error_log::ErrorLogRequest syncFailure(const std::string& path)
+    {
+        return {"xyz.openbmc_project.RBMC_DataSync.Error.SyncFailure",
+                ext_data::ErrorLevel::Warning,
+                {{"DS_Sync_Path", path},
+                 {"DS_Sync_Msg", "Permanent rsync failure occurred"}}};
+    }
+
+    sdbusplus::async::context ctx;
+    ext_data::MockExternalDataIFaces mockExtDataIfaces;
+    error_log::ErrorLogQueue errorLogQueue{ctx, mockExtDataIfaces, 60s};
+};
+
+TEST_F(ErrorLogQueueTest, FirstErrorLoggedRightAway)
+{
+    auto now = error_log::Clock::now();
+    errorLogQueue.submit(syncFailure("/file1"), now);
+
+    auto readyLogs = errorLogQueue.takeReadyLogs(now);
+    ASSERT_EQ(readyLogs.size(), 1U);
+    EXPECT_EQ(readyLogs[0].additionalDetails["DS_Sync_Path"], "/file1");
+    EXPECT_FALSE(readyLogs[0].additionalDetails.contains(
+        "DS_Aggregated_Count"));
+
+    // Nothing more to log
+    EXPECT_TRUE(errorLogQueue.takeReadyLogs(now + 61s).empty());
+
+    // The next window starts with the next error
+    errorLogQueue.submit(syncFailure("/file1"), now + 62s);
+    EXPECT_EQ(errorLogQueue.takeReadyLogs(now + 62s).size(), 1U);
+}
+
+TEST_F(ErrorLogQueueTest, SameErrorsAggregatedWithinWindow)
+{
+    auto now = error_log::Clock::now();
+    errorLogQueue.submit(syncFailure("/file1"), now);
+    errorLogQueue.submit(syncFailure("/file2"), now + 1s);
+    errorLogQueue.submit(syncFailure("/file3"), now + 2s);
+    errorLogQueue.submit(syncFailure("/file2"), now + 3s);
+
+    // A different type of error is not rate limited by the above
+    auto notifyFailure = syncFailure("/file4");
+    notifyFailure.errMsg =
+        "xyz.openbmc_project.RBMC_DataSync.Error.NotifyFailure";
+    errorLogQueue.submit(notifyFailure, now + 4s);
+
+    EXPECT_EQ(errorLogQueue.takeReadyLogs(now + 5s).size(), 2U);
+    EXPECT_TRUE(errorLogQueue.takeReadyLogs(now + 30s).empty());
+
+    auto readyLogs = errorLogQueue.takeReadyLogs(now + 60s);
+    ASSERT_EQ(readyLogs.size(), 1U);
+    auto& details = readyLogs[0].additionalDetails;
+    EXPECT_EQ(details["DS_Aggregated_Count"], "3");
+    EXPECT_EQ(details["DS_Aggregated_Paths"], "/file2, /file3");
+    EXPECT_EQ(details["DS_Aggregated_Window"], "60s");
+
+    // The aggregated error log starts the next window
+    errorLogQueue.submit(syncFailure("/file5"), now + 61s);
+    EXPECT_TRUE(errorLogQueue.takeReadyLogs(now + 61s).empty());
+    EXPECT_EQ(errorLogQueue.takeReadyLogs(now + 120s).size(), 1U);
+}
+
+TEST_F(ErrorLogQueueTest, ErrorTypeKeyedOnErrorCode)
+{
+    auto rsyncFailure = [](const std::string& path, const std::string& errCode,
+                           const std::string& errMsg) {
+        auto request = syncFailure(path);
+        request.additionalDetails["DS_Sync_ErrCode"] = errCode;
+        request.additionalDetails["DS_Sync_ErrMsg"] = errMsg;
+        return request;
+    };
+
+    auto now = error_log::Clock::now();
+    errorLogQueue.submit(rsyncFailure("/file1", "23", "file1 vanished"), now);
+
+    // The same error code with a different output is the same type
+    errorLogQueue.submit(rsyncFailure("/file2", "23", "file2 vanished"), now);
+
+    // A different error code is not rate limited by the above
+    errorLogQueue.submit(rsyncFailure("/file3", "12", "protocol error"), now);
+
+    EXPECT_EQ(errorLogQueue.takeReadyLogs(now).size(), 2U);
+
+    auto readyLogs = errorLogQueue.takeReadyLogs(now + 60s);
+    ASSERT_EQ(readyLogs.size(), 1U);
+    auto& details = readyLogs[0].additionalDetails;
+    EXPECT_EQ(details["DS_Sync_ErrCode"], "23");
+    EXPECT_EQ(details["DS_Aggregated_Count"], "1");
+    EXPECT_EQ(details["DS_Aggregated_Paths"], "/file2");
+}
+
+TEST_F(ErrorLogQueueTest, AggregatedPathsBounded)
+{
+    auto now = error_log::Clock::now();
+    errorLogQueue.submit(syncFailure("/file"), now);
+    for (size_t i = 0; i <= error_log::ErrorLogQueue::maxAggregatedPaths; ++i)
+    {
+        errorLogQueue.submit(syncFailure("/file" + std::to_string(i)), now);
+    }
+    EXPECT_EQ(errorLogQueue.takeReadyLogs(now).size(), 1U);
+
+    auto readyLogs = errorLogQueue.takeReadyLogs(now + 60s);
+    ASSERT_EQ(readyLogs.size(), 1U);
+    auto& details = readyLogs[0].additionalDetails;
+    EXPECT_EQ(details["DS_Aggregated_Count"],
+              std::to_string(error_log::ErrorLogQueue::maxAggregatedPaths + 1));
+    EXPECT_TRUE(details["DS_Aggregated_Paths"].ends_with(", ..."));
+}
+
+TEST_F(ErrorLogQueueTest, RunLogsOnSubmitAndWindowEnd)
+{
+    error_log::ErrorLogQueue shortWindowQueue{ctx, mockExtDataIfaces, 1s};
+    const auto start = error_log::Clock::now();
+    std::vector<error_log::Clock::duration> loggedAt;
+
+    EXPECT_CALL(mockExtDataIfaces,
+                createErrorLog(testing::_, testing::_, testing::_, testing::_))
+        .WillRepeatedly([&loggedAt, start]() -> sdbusplus::async::task<> {
+        loggedAt.emplace_back(error_log::Clock::now() - start);
+        co_return;
+    });
+
+    auto submitErrors = [&]() -> sdbusplus::async::task<> {
+        co_await sdbusplus::async::sleep_for(ctx, 300ms);
+        shortWindowQueue.submit(syncFailure("/file1"));
+        shortWindowQueue.submit(syncFailure("/file2"));
+
+        co_await sdbusplus::async::sleep_for(ctx, 1500ms);
+        ctx.request_stop();
+        co_return;
+    };
+    ctx.spawn(shortWindowQueue.run());
+    ctx.spawn(submitErrors());
+    ctx.run();
+
+    // The first error is logged on the submit, and the aggregated one once
+    // its window elapses.
+    ASSERT_EQ(loggedAt.size(), 2U);
+    EXPECT_LT(loggedAt[0], 500ms);
+    EXPECT_GE(loggedAt[1], 1300ms);
+    EXPECT_LT(loggedAt[1], 1600ms);
+}
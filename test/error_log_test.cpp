@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "error_log.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace error_log = data_sync::error_log;
+
+namespace
+{
+
+/**
+ * @brief Helper to read the FFDC file from its current offset, as the logging
+ *        service does.
+ */
+std::string readFFDCFile(int fd)
+{
+    std::string data;
+    std::array<char, 64> buffer{};
+    ssize_t rc = 0;
+    while ((rc = read(fd, buffer.data(), buffer.size())) > 0)
+    {
+        data.append(buffer.data(), static_cast<size_t>(rc));
+    }
+    EXPECT_EQ(rc, 0);
+    return data;
+}
+
+} // namespace
+
+TEST(FFDCFileTest, FileSealedAndRewound)
+{
+    const std::string data(200, 'x');
+    error_log::FFDCFile ffdcFile{error_log::FFDCFormat::Text,
+                                 error_log::rsyncOutputSubType, 1, data};
+    int fd = ffdcFile.getFD();
+    ASSERT_NE(fd, -1);
+
+    // The logging service gets an immutable copy
+    int seals = fcntl(fd, F_GET_SEALS);
+    ASSERT_NE(seals, -1);
+    EXPECT_EQ(seals,
+              F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL);
+    EXPECT_EQ(write(fd, "y", 1), -1);
+    EXPECT_EQ(ftruncate(fd, 0), -1);
+
+    // The offset is reset so that the data is read from the beginning
+    EXPECT_EQ(lseek(fd, 0, SEEK_CUR), 0);
+    EXPECT_EQ(readFFDCFile(fd), data);
+}
+
+TEST(FFDCFileTest, EmptyData)
+{
+    error_log::FFDCFile ffdcFile{error_log::FFDCFormat::Text,
+                                 error_log::rsyncOutputSubType, 1, ""};
+    ASSERT_NE(ffdcFile.getFD(), -1);
+    EXPECT_NE(fcntl(ffdcFile.getFD(), F_GET_SEALS), -1);
+    EXPECT_TRUE(readFFDCFile(ffdcFile.getFD()).empty());
+}
+
+TEST(FFDCFileTest, MultipleSections)
+{
+    error_log::FFDCSections sections{
+        {error_log::FFDCFormat::JSON, error_log::calloutsSubType, 1,
+         R"([{"Priority":"H"}])"},
+        {error_log::FFDCFormat::JSON, error_log::eventTraceSubType, 2,
+         R"({"Events":[]})"},
+        {error_log::FFDCFormat::Text, error_log::rsyncOutputSubType, 3,
+         "rsync: connection unexpectedly closed"}};
+
+    // Each section is a separate file kept open till the error log is created
+    std::vector<std::unique_ptr<error_log::FFDCFile>> ffdcFiles;
+    for (const auto& section : sections)
+    {
+        ffdcFiles.emplace_back(std::make_unique<error_log::FFDCFile>(section));
+    }
+
+    for (size_t i = 0; i < sections.size(); ++i)
+    {
+        auto& ffdcFile = *ffdcFiles[i];
+        EXPECT_EQ(ffdcFile.getFormat(), sections[i].format);
+        EXPECT_EQ(ffdcFile.getSubType(), sections[i].subType);
+        EXPECT_EQ(ffdcFile.getVersion(), sections[i].version);
+        for (size_t j = 0; j < i; ++j)
+        {
+            EXPECT_NE(ffdcFile.getFD(), ffdcFiles[j]->getFD());
+        }
+        EXPECT_EQ(readFFDCFile(ffdcFile.getFD()), sections[i].data);
+    }
+
+    // The file is closed, which frees its memory, along with the object
+    int fd = ffdcFiles.front()->getFD();
+    ffdcFiles.front().reset();
+    EXPECT_EQ(fcntl(fd, F_GETFD), -1);
+}
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "event_aggregator.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+namespace inotify = data_sync::watch::inotify;
+
+class EventAggregatorTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char tmpdir[] = "/tmp/pdsEventAggregatorXXXXXX";
+        tmpDir = mkdtemp(tmpdir);
+        dataDir = tmpDir / "data" / "";
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(tmpDir);
+    }
+
+    static void createFiles(const fs::path& dir, size_t count)
+    {
+        fs::create_directories(dir);
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::ofstream(dir / ("file" + std::to_string(i)));
+        }
+    }
+
+    static bool syncAll(const fs::path& /*dir*/)
+    {
+        return true;
+    }
+
+    fs::path tmpDir;
+    fs::path dataDir;
+};
+
+TEST_F(EventAggregatorTest, CollapsesBurstIntoLowestCommonAncestor)
+{
+    createFiles(dataDir / "a" / "x", 20);
+    createFiles(dataDir / "a" / "y", 20);
+    createFiles(dataDir / "b", 20);
+
+    inotify::DataOperations dataOps;
+    for (size_t i = 0; i < 12; ++i)
+    {
+        dataOps.emplace_back(dataDir / "a" / "x" / ("file" + std::to_string(i)),
+                             inotify::DataOps::COPY);
+        dataOps.emplace_back(dataDir / "a" / "y" / ("file" + std::to_string(i)),
+                             inotify::DataOps::DELETE);
+    }
+    dataOps.emplace_back(dataDir / "b" / "file1", inotify::DataOps::COPY);
+    dataOps.emplace_back(dataDir / "b" / "file2", inotify::DataOps::COPY);
+    dataOps.emplace_back(dataDir / "c", inotify::DataOps::RENAME);
+
+    auto collapsed = inotify::collapseBursts(dataOps, dataDir, {16, 50},
+                                             syncAll);
+
+    // The changes of "a" are more than half of its entries at each level
+    ASSERT_EQ(collapsed.size(), 4U);
+    EXPECT_EQ(collapsed[0], inotify::DataOperation(dataDir / "b" / "file1",
+                                                   inotify::DataOps::COPY));
+    EXPECT_EQ(collapsed[1], inotify::DataOperation(dataDir / "b" / "file2",
+                                                   inotify::DataOps::COPY));
+    EXPECT_EQ(collapsed[2],
+              inotify::DataOperation(dataDir / "c", inotify::DataOps::RENAME));
+    EXPECT_EQ(collapsed[3], inotify::DataOperation(dataDir / "a" / "",
+                                                   inotify::DataOps::COPY));
+}
+
+TEST_F(EventAggregatorTest, KeepsConfiguredAndIncludedBounds)
+{
+    createFiles(dataDir, 4);
+    createFiles(dataDir / "dir", 4);
+
+    inotify::DataOperations dataOps;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        dataOps.emplace_back(dataDir / ("file" + std::to_string(i)),
+                             inotify::DataOps::COPY);
+        dataOps.emplace_back(dataDir / "dir" / ("file" + std::to_string(i)),
+                             inotify::DataOps::COPY);
+    }
+
+    // Never above the configured path
+    auto collapsed = inotify::collapseBursts(dataOps, dataDir, {2, 50},
+                                             syncAll);
+    ASSERT_EQ(collapsed.size(), 1U);
+    EXPECT_EQ(collapsed[0],
+              inotify::DataOperation(dataDir, inotify::DataOps::COPY));
+
+    // Only the directories which can be synced as a whole
+    collapsed = inotify::collapseBursts(
+        dataOps, dataDir, {2, 50},
+        [this](const fs::path& dir) { return dir == dataDir / "dir"; });
+    ASSERT_EQ(collapsed.size(), 5U);
+    EXPECT_EQ(collapsed.back(), inotify::DataOperation(dataDir / "dir" / "",
+                                                       inotify::DataOps::COPY));
+
+    // A single change is synced as is
+    collapsed = inotify::collapseBursts({dataOps.front()}, dataDir, {2, 1},
+                                        syncAll);
+    EXPECT_EQ(collapsed, inotify::DataOperations{dataOps.front()});
+}
@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "data_watcher.hpp"
+#include "event_trace.hpp"
+
+#include <sdbusplus/async.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+namespace inotify = data_sync::watch::inotify;
+namespace trace = data_sync::watch::trace;
+
+class EventTraceTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char tmpdir[] = "/tmp/pdsEventTraceXXXXXX";
+        tmpDir = mkdtemp(tmpdir);
+        dataDir = tmpDir / "data" / "";
+        fs::create_directories(dataDir);
+        traceFile = tmpDir / "data.trace";
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(tmpDir);
+    }
+
+    static void writeData(const fs::path& fileName, const std::string& data)
+    {
+        std::ofstream out(fileName);
+        ASSERT_TRUE(out.is_open()) << "Failed to open " << fileName;
+        out << data;
+        out.close();
+    }
+
+    fs::path tmpDir;
+    fs::path dataDir;
+    fs::path traceFile;
+};
+
+TEST_F(EventTraceTest, RecordAndReplayEvents)
+{
+    constexpr uint32_t eventMasks = IN_CLOSE_WRITE | IN_MOVE | IN_DELETE_SELF |
+                                    IN_CREATE | IN_DELETE;
+    fs::path dataFile = dataDir / "file1";
+    writeData(dataFile, "Initial data\n");
+
+    inotify::DataOperations recordedOps;
+    {
+        sdbusplus::async::context ctx;
+        inotify::DataWatcher watcher(ctx, IN_NONBLOCK, eventMasks, dataDir);
+        watcher.startRecording(traceFile);
+
+        auto recordEvents = [&]() -> sdbusplus::async::task<> {
+            writeData(dataFile, "Modified data\n");
+            recordedOps = co_await watcher.onDataChange();
+            ctx.request_stop();
+            co_return;
+        };
+        ctx.spawn(recordEvents());
+        ctx.run();
+    }
+
+    ASSERT_EQ(recordedOps.size(), 1U);
+    EXPECT_EQ(recordedOps[0].first, dataFile);
+    EXPECT_EQ(recordedOps[0].second, inotify::DataOps::COPY);
+    ASSERT_TRUE(fs::exists(traceFile));
+
+    // Replay into a new watcher, the watch descriptors may differ from the
+    // recording, and the same data operations are expected.
+    inotify::DataOperations replayedOps;
+    {
+        sdbusplus::async::context ctx;
+        inotify::DataWatcher watcher(ctx, IN_NONBLOCK, eventMasks, dataDir);
+        trace::EventReplayer replayer(ctx, traceFile, 0);
+        EXPECT_EQ(replayer.getConfiguredPath(), dataDir);
+
+        auto replayEvents = [&]() -> sdbusplus::async::task<> {
+            co_await replayer.replay(
+                watcher, [&replayedOps](const inotify::DataOperations& ops) {
+                replayedOps.insert(replayedOps.end(), ops.begin(), ops.end());
+            });
+            ctx.request_stop();
+            co_return;
+        };
+        ctx.spawn(replayEvents());
+        ctx.run();
+    }
+
+    EXPECT_EQ(replayedOps, recordedOps);
+}
+
+TEST_F(EventTraceTest, ReplayDropsEventsOfUnwatchedPaths)
+{
+    // The watch of wd 2 is removed before its event, hence only the event of
+    // wd 1 is expected to be replayed.
+    {
+        std::ofstream traceStream(traceFile);
+        traceStream << "C " << dataDir.string() << '\n'
+                    << "W 1 " << dataDir.string() << '\n'
+                    << "W 2 " << (tmpDir / "other" / "").string() << '\n'
+                    << "R 2\n"
+                    << "E 100 1 8 0 file1\n"
+                    << "E 100 2 8 0 file2\n";
+    }
+
+    inotify::DataOperations replayedOps;
+    sdbusplus::async::context ctx;
+    inotify::DataWatcher watcher(ctx, IN_NONBLOCK,
+                                 IN_CLOSE_WRITE | IN_CREATE | IN_DELETE,
+                                 dataDir);
+    trace::EventReplayer replayer(ctx, traceFile, 0);
+
+    auto replayEvents = [&]() -> sdbusplus::async::task<> {
+        co_await replayer.replay(
+            watcher, [&replayedOps](const inotify::DataOperations& ops) {
+            replayedOps.insert(replayedOps.end(), ops.begin(), ops.end());
+        });
+        ctx.request_stop();
+        co_return;
+    };
+    ctx.spawn(replayEvents());
+    ctx.run();
+
+    ASSERT_EQ(replayedOps.size(), 1U);
+    EXPECT_EQ(replayedOps[0].first, dataDir / "file1");
+    EXPECT_EQ(replayedOps[0].second, inotify::DataOps::COPY);
+}
+
+TEST_F(EventTraceTest, MalformedTraceThrows)
+{
+    {
+        std::ofstream traceStream(traceFile);
+        traceStream << "C " << dataDir.string() << '\n' << "E abc\n";
+    }
+
+    sdbusplus::async::context ctx;
+    EXPECT_THROW(trace::EventReplayer(ctx, traceFile, 0), std::runtime_error);
+}
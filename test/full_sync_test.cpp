@@ -612,7 +612,7 @@ TEST_F(ManagerTest, FullSyncFailed)
         .WillByDefault([](const std::string&,
                           const data_sync::ext_data::ErrorLevel&,
                           data_sync::ext_data::AdditionalData&,
-                          const std::optional<nlohmann::json>&)
+                          const data_sync::error_log::FFDCSections&)
                            -> sdbusplus::async::task<> { co_return; });
     data_sync::Manager manager{ctx, std::move(extDataIface),
                                ManagerTest::dataSyncCfgDir};
@@ -1,11 +1,16 @@
 // SPDX-License-Identifier: Apache-2.0
 
+#include "config.h"
+
 #include "data_watcher.hpp"
 #include "manager_test.hpp"
+#include "tracing.hpp"
+#include "watch_budget.hpp"
 
 #include <sdbusplus/async.hpp>
 
 #include <filesystem>
+#include <string>
 #include <string_view>
 
 namespace fs = std::filesystem;
@@ -914,3 +919,663 @@ TEST_F(ManagerTest, ImmediateSyncVanishedPathRetrySucceeds)
     ctx->spawn(triggerAndWatchSyncOp());
     ctx->run();
 }
+
+TEST_F(ManagerTest, testReplayEventTraceOnStart)
+{
+    using namespace std::literals;
+    namespace extData = data_sync::ext_data;
+
+    std::unique_ptr<extData::ExternalDataIFaces> extDataIface =
+        std::make_unique<extData::MockExternalDataIFaces>();
+
+    extData::MockExternalDataIFaces* mockExtDataIfaces =
+        dynamic_cast<extData::MockExternalDataIFaces*>(extDataIface.get());
+
+    ON_CALL(*mockExtDataIfaces, fetchBMCRedundancyMgrProps())
+        .WillByDefault([&mockExtDataIfaces]() -> sdbusplus::async::task<> {
+        mockExtDataIfaces->setBMCRole(extData::BMCRole::Active);
+        mockExtDataIfaces->setBMCRedundancy(true);
+        co_return;
+    });
+
+    EXPECT_CALL(*mockExtDataIfaces, fetchBMCPosition())
+        .WillRepeatedly([]() -> sdbusplus::async::task<> { co_return; });
+
+    EXPECT_CALL(*mockExtDataIfaces,
+                createErrorLog(testing::_, testing::_, testing::_, testing::_))
+        .WillRepeatedly([]() -> sdbusplus::async::task<> { co_return; });
+
+    nlohmann::json jsonData = {
+        {"Directories",
+         {{{"Path", ManagerTest::tmpDataSyncDataDir.string() + "/srcDir/"},
+           {"DestinationPath", ManagerTest::destDir.string()},
+           {"Description", "Directory to test the inotify trace replay"},
+           {"SyncDirection", "Active2Passive"},
+           {"SyncType", "Immediate"}}}}};
+
+    fs::path srcDir{jsonData["Directories"][0]["Path"]};
+    fs::path destDir{jsonData["Directories"][0]["DestinationPath"]};
+    fs::path srcFile = srcDir / "file1";
+    fs::path destFile = destDir / fs::relative(srcFile, "/");
+    fs::create_directories(srcDir);
+    ManagerTest::writeData(srcFile, "Src data");
+
+    // The trace of a write into the source file, replayed half a second
+    // after the sync events are started.
+    fs::path traceFile = ManagerTest::tmpDataSyncDataDir / "srcDir.trace";
+    ManagerTest::writeData(traceFile, "C " + srcDir.string() + "\n" + "W 1 " +
+                                          srcDir.string() + "\n" +
+                                          "E 500000 1 8 0 file1\n");
+
+    writeConfig(jsonData);
+    sdbusplus::async::context ctx;
+
+    data_sync::Manager manager{ctx, std::move(extDataIface),
+                               ManagerTest::dataSyncCfgDir};
+    manager.replayEventTraceOnStart(traceFile, 1.0);
+
+    // NOLINTNEXTLINE
+    auto tamperDest = [&]() -> sdbusplus::async::task<void> {
+        // Wait for the full sync and the watchers to be ready
+        co_await sdbusplus::async::sleep_for(ctx, 0.2s);
+        EXPECT_EQ(ManagerTest::readData(destFile), "Src data");
+
+        // Only the replayed write syncs the source file again, as the
+        // source isn't written.
+        ManagerTest::writeData(destFile, "Tampered dest data");
+        co_await sdbusplus::async::sleep_for(ctx, 1s);
+
+        ctx.request_stop();
+
+        // Force an inotify event so the running watcher wakes up and exits
+        ManagerTest::writeData(srcDir / "file2", "Dummy data to stop ctx");
+        co_return;
+    };
+
+    ctx.spawn(tamperDest());
+    ctx.run();
+
+    EXPECT_EQ(ManagerTest::readData(destFile), "Src data");
+}
+
+TEST_F(ManagerTest, testSyncEventsPausedAndResumed)
+{
+    using namespace std::literals;
+    namespace extData = data_sync::ext_data;
+
+    std::unique_ptr<extData::ExternalDataIFaces> extDataIface =
+        std::make_unique<extData::MockExternalDataIFaces>();
+
+    extData::MockExternalDataIFaces* mockExtDataIfaces =
+        dynamic_cast<extData::MockExternalDataIFaces*>(extDataIface.get());
+
+    ON_CALL(*mockExtDataIfaces, fetchBMCRedundancyMgrProps())
+        .WillByDefault([&mockExtDataIfaces]() -> sdbusplus::async::task<> {
+        mockExtDataIfaces->setBMCRole(extData::BMCRole::Active);
+        mockExtDataIfaces->setBMCRedundancy(true);
+        co_return;
+    });
+
+    EXPECT_CALL(*mockExtDataIfaces, fetchBMCPosition())
+        .WillRepeatedly([]() -> sdbusplus::async::task<> { co_return; });
+
+    EXPECT_CALL(*mockExtDataIfaces,
+                createErrorLog(testing::_, testing::_, testing::_, testing::_))
+        .WillRepeatedly([]() -> sdbusplus::async::task<> { co_return; });
+
+    nlohmann::json jsonData = {
+        {"Files",
+         {{{"Path", ManagerTest::tmpDataSyncDataDir.string() + "/srcFile3"},
+           {"DestinationPath", ManagerTest::destDir.string()},
+           {"Description", "File to test pausing and resuming the sync"},
+           {"SyncDirection", "Active2Passive"},
+           {"SyncType", "Immediate"}}}}};
+
+    fs::path srcPath{jsonData["Files"][0]["Path"]};
+    fs::path destDir{jsonData["Files"][0]["DestinationPath"]};
+    fs::path destPath = destDir / fs::relative(srcPath, "/");
+
+    writeConfig(jsonData);
+    sdbusplus::async::context ctx;
+
+    std::string data{"Src: Initial Data\n"};
+    ManagerTest::writeData(srcPath, data);
+    ASSERT_EQ(ManagerTest::readData(srcPath), data);
+
+    data_sync::Manager manager{ctx, std::move(extDataIface),
+                               ManagerTest::dataSyncCfgDir};
+
+    std::string dataWhilePaused{"Data modified while the sync is paused"};
+
+    // NOLINTNEXTLINE
+    auto pauseAndResume = [&]() -> sdbusplus::async::task<void> {
+        // Wait for the full sync and the watcher to be ready
+        co_await sdbusplus::async::sleep_for(ctx, 0.2s);
+        EXPECT_EQ(ManagerTest::readData(destPath), data);
+
+        // Toggle a few times, which shouldn't create the duplicate watchers
+        manager.setDisableSyncStatus(true);
+        manager.setDisableSyncStatus(false);
+        manager.setDisableSyncStatus(true);
+        manager.setDisableSyncStatus(false);
+        manager.setDisableSyncStatus(true);
+        co_await sdbusplus::async::sleep_for(ctx, 0.2s);
+
+        ManagerTest::writeData(srcPath, dataWhilePaused);
+        co_await sdbusplus::async::sleep_for(ctx, 0.2s);
+        EXPECT_NE(ManagerTest::readData(destPath), dataWhilePaused)
+            << "The data shouldn't be synced while the sync is paused";
+        EXPECT_EQ(manager.getChangeJournal().size(), 1U)
+            << "The change should be journaled while the sync is paused";
+
+        // Resuming syncs the journaled change without any new event
+        manager.setDisableSyncStatus(false);
+        co_await sdbusplus::async::sleep_for(ctx, 0.5s);
+        EXPECT_EQ(ManagerTest::readData(destPath), dataWhilePaused)
+            << "The journaled change should be synced on resume";
+        EXPECT_TRUE(manager.getChangeJournal().empty());
+
+        // The watcher is still alive after the toggles
+        ManagerTest::writeData(srcPath, data);
+        co_await sdbusplus::async::sleep_for(ctx, 0.2s);
+
+        ctx.request_stop();
+
+        // Force an inotify event so the running watcher wakes up and exits
+        ManagerTest::writeData(srcPath, data);
+        co_return;
+    };
+
+    ctx.spawn(pauseAndResume());
+    ctx.run();
+
+    EXPECT_EQ(ManagerTest::readData(destPath), data)
+        << "The data should match as the watcher is kept alive on resume";
+}
+
+TEST_F(ManagerTest, testSyncEventsOnRoleChange)
+{
+    using namespace std::literals;
+    namespace extData = data_sync::ext_data;
+
+    std::unique_ptr<extData::ExternalDataIFaces> extDataIface =
+        std::make_unique<extData::MockExternalDataIFaces>();
+
+    extData::MockExternalDataIFaces* mockExtDataIfaces =
+        dynamic_cast<extData::MockExternalDataIFaces*>(extDataIface.get());
+
+    ON_CALL(*mockExtDataIfaces, fetchBMCRedundancyMgrProps())
+        .WillByDefault([&mockExtDataIfaces]() -> sdbusplus::async::task<> {
+        mockExtDataIfaces->setBMCRole(extData::BMCRole::Active);
+        mockExtDataIfaces->setBMCRedundancy(true);
+        co_return;
+    });
+
+    EXPECT_CALL(*mockExtDataIfaces, fetchBMCPosition())
+        .WillRepeatedly([]() -> sdbusplus::async::task<> { co_return; });
+
+    EXPECT_CALL(*mockExtDataIfaces,
+                createErrorLog(testing::_, testing::_, testing::_, testing::_))
+        .WillRepeatedly([]() -> sdbusplus::async::task<> { co_return; });
+
+    nlohmann::json jsonData = {
+        {"Files",
+         {{{"Path", ManagerTest::tmpDataSyncDataDir.string() + "/srcFile4"},
+           {"DestinationPath", ManagerTest::destDir.string()},
+           {"Description", "File to test the sync events on role change"},
+           {"SyncDirection", "Active2Passive"},
+           {"SyncType", "Immediate"}}}}};
+
+    fs::path srcPath{jsonData["Files"][0]["Path"]};
+    fs::path destDir{jsonData["Files"][0]["DestinationPath"]};
+    fs::path destPath = destDir / fs::relative(srcPath, "/");
+
+    writeConfig(jsonData);
+    sdbusplus::async::context ctx;
+
+    std::string data{"Src: Initial Data\n"};
+    ManagerTest::writeData(srcPath, data);
+    ASSERT_EQ(ManagerTest::readData(srcPath), data);
+
+    data_sync::Manager manager{ctx, std::move(extDataIface),
+                               ManagerTest::dataSyncCfgDir};
+
+    std::string dataAsPassive{"Data modified while the BMC is Passive"};
+
+    // NOLINTNEXTLINE
+    auto changeRole = [&]() -> sdbusplus::async::task<void> {
+        // Wait for the full sync and the watcher to be ready
+        co_await sdbusplus::async::sleep_for(ctx, 0.2s);
+        EXPECT_EQ(ManagerTest::readData(destPath), data);
+
+        // Failover, the Active2Passive data is not synced by the Passive BMC
+        mockExtDataIfaces->setBMCRole(extData::BMCRole::Passive);
+        ManagerTest::writeData(srcPath, dataAsPassive);
+        co_await sdbusplus::async::sleep_for(ctx, 0.3s);
+        EXPECT_NE(ManagerTest::readData(destPath), dataAsPassive)
+            << "The data shouldn't be synced as the BMC is Passive";
+
+        // Back to Active, the data is synced without any new event
+        mockExtDataIfaces->setBMCRole(extData::BMCRole::Active);
+        co_await sdbusplus::async::sleep_for(ctx, 0.3s);
+        EXPECT_EQ(ManagerTest::readData(destPath), dataAsPassive)
+            << "The data should be synced as the BMC became Active";
+
+        // The watcher is started again for the Active role
+        ManagerTest::writeData(srcPath, data);
+        co_await sdbusplus::async::sleep_for(ctx, 0.2s);
+
+        ctx.request_stop();
+
+        // Force an inotify event so the running watcher wakes up and exits
+        ManagerTest::writeData(srcPath, data);
+        co_return;
+    };
+
+    ctx.spawn(changeRole());
+    ctx.run();
+
+    EXPECT_EQ(ManagerTest::readData(destPath), data)
+        << "The data should match as the watcher is running for Active role";
+}
+
+TEST_F(ManagerTest, testWatchesReleasedOnRoleChange)
+{
+    using namespace std::literals;
+    namespace extData = data_sync::ext_data;
+
+    std::unique_ptr<extData::ExternalDataIFaces> extDataIface =
+        std::make_unique<extData::MockExternalDataIFaces>();
+
+    extData::MockExternalDataIFaces* mockExtDataIfaces =
+        dynamic_cast<extData::MockExternalDataIFaces*>(extDataIface.get());
+
+    ON_CALL(*mockExtDataIfaces, fetchBMCRedundancyMgrProps())
+        .WillByDefault([&mockExtDataIfaces]() -> sdbusplus::async::task<> {
+        mockExtDataIfaces->setBMCRole(extData::BMCRole::Active);
+        mockExtDataIfaces->setBMCRedundancy(true);
+        co_return;
+    });
+
+    EXPECT_CALL(*mockExtDataIfaces, fetchBMCPosition())
+        .WillRepeatedly([]() -> sdbusplus::async::task<> { co_return; });
+
+    EXPECT_CALL(*mockExtDataIfaces,
+                createErrorLog(testing::_, testing::_, testing::_, testing::_))
+        .WillRepeatedly([]() -> sdbusplus::async::task<> { co_return; });
+
+    nlohmann::json jsonData = {
+        {"Directories",
+         {{{"Path", ManagerTest::tmpDataSyncDataDir.string() + "/roleDir/"},
+           {"DestinationPath", ManagerTest::destDir.string()},
+           {"Description", "Directory to test the watches on role change"},
+           {"SyncDirection", "Active2Passive"},
+           {"SyncType", "Immediate"}}}}};
+
+    fs::path srcDir{jsonData["Directories"][0]["Path"]};
+    fs::create_directories(srcDir / "subDir");
+    ManagerTest::writeData(srcDir / "file1", "Data");
+
+    writeConfig(jsonData);
+    sdbusplus::async::context ctx;
+
+    auto& watchBudget = data_sync::watch::inotify::WatchBudget::instance();
+    const auto usedWatches = watchBudget.getUsed();
+
+    data_sync::Manager manager{ctx, std::move(extDataIface),
+                               ManagerTest::dataSyncCfgDir};
+
+    // NOLINTNEXTLINE
+    auto changeRole = [&]() -> sdbusplus::async::task<void> {
+        // Wait for the full sync and the watcher to be ready
+        co_await sdbusplus::async::sleep_for(ctx, 0.2s);
+        EXPECT_GT(watchBudget.getUsed(), usedWatches);
+
+        // The watcher stops without waiting for a change
+        mockExtDataIfaces->setBMCRole(extData::BMCRole::Passive);
+        co_await sdbusplus::async::sleep_for(ctx, 0.1s);
+        EXPECT_EQ(watchBudget.getUsed(), usedWatches)
+            << "The watches should be released as the BMC is Passive";
+
+        ctx.request_stop();
+        co_return;
+    };
+
+    ctx.spawn(changeRole());
+    ctx.run();
+}
+
+TEST_F(ManagerTest, testConsistencyGroupSyncedTogether)
+{
+    using namespace std::literals;
+    namespace extData = data_sync::ext_data;
+
+    std::unique_ptr<extData::ExternalDataIFaces> extDataIface =
+        std::make_unique<extData::MockExternalDataIFaces>();
+
+    extData::MockExternalDataIFaces* mockExtDataIfaces =
+        dynamic_cast<extData::MockExternalDataIFaces*>(extDataIface.get());
+
+    ON_CALL(*mockExtDataIfaces, fetchBMCRedundancyMgrProps())
+        .WillByDefault([&mockExtDataIfaces]() -> sdbusplus::async::task<> {
+        mockExtDataIfaces->setBMCRole(extData::BMCRole::Active);
+        mockExtDataIfaces->setBMCRedundancy(true);
+        co_return;
+    });
+
+    EXPECT_CALL(*mockExtDataIfaces, fetchBMCPosition())
+        .WillRepeatedly([]() -> sdbusplus::async::task<> { co_return; });
+
+    EXPECT_CALL(*mockExtDataIfaces,
+                createErrorLog(testing::_, testing::_, testing::_, testing::_))
+        .WillRepeatedly([]() -> sdbusplus::async::task<> { co_return; });
+
+    nlohmann::json jsonData = {
+        {"Files",
+         {{{"Path", ManagerTest::tmpDataSyncDataDir.string() + "/nvram"},
+           {"DestinationPath", ManagerTest::destDir.string()},
+           {"Description", "File to test the consistency group"},
+           {"SyncDirection", "Active2Passive"},
+           {"SyncType", "Immediate"},
+           {"ConsistencyGroup", "NVRAM"}},
+          {{"Path", ManagerTest::tmpDataSyncDataDir.string() + "/nvramCksum"},
+           {"DestinationPath", ManagerTest::destDir.string()},
+           {"Description", "Checksum to test the consistency group"},
+           {"SyncDirection", "Active2Passive"},
+           {"SyncType", "Immediate"},
+           {"ConsistencyGroup", "NVRAM"}}}}};
+
+    fs::path dataPath{jsonData["Files"][0]["Path"]};
+    fs::path cksumPath{jsonData["Files"][1]["Path"]};
+    fs::path destDir{jsonData["Files"][0]["DestinationPath"]};
+    fs::path destDataPath = destDir / fs::relative(dataPath, "/");
+    fs::path destCksumPath = destDir / fs::relative(cksumPath, "/");
+
+    writeConfig(jsonData);
+    sdbusplus::async::context ctx;
+
+    ManagerTest::writeData(dataPath, "Data1");
+    ManagerTest::writeData(cksumPath, "Cksum1");
+
+    data_sync::Manager manager{ctx, std::move(extDataIface),
+                               ManagerTest::dataSyncCfgDir};
+
+    // NOLINTNEXTLINE
+    auto writeGroup = [&]() -> sdbusplus::async::task<void> {
+        // Wait for the full sync and the watchers to be ready
+        co_await sdbusplus::async::sleep_for(ctx, 0.2s);
+        EXPECT_EQ(ManagerTest::readData(destDataPath), "Data1");
+        EXPECT_EQ(ManagerTest::readData(destCksumPath), "Cksum1");
+
+        // The data and its checksum written back to back
+        ManagerTest::writeData(dataPath, "Data2");
+        ManagerTest::writeData(cksumPath, "Cksum2");
+        co_await sdbusplus::async::sleep_for(ctx, 0.5s);
+
+        ctx.request_stop();
+
+        // Force an inotify event so the running watchers wake up and exit
+        ManagerTest::writeData(dataPath, "Data2");
+        ManagerTest::writeData(cksumPath, "Cksum2");
+        co_return;
+    };
+
+    ctx.spawn(writeGroup());
+    ctx.run();
+
+    EXPECT_EQ(ManagerTest::readData(destDataPath), "Data2");
+    EXPECT_EQ(ManagerTest::readData(destCksumPath), "Cksum2");
+}
+
+TEST_F(ManagerTest, testRenameTransfersOnlyMetadata)
+{
+    using namespace std::literals;
+    namespace extData = data_sync::ext_data;
+
+    std::unique_ptr<extData::ExternalDataIFaces> extDataIface =
+        std::make_unique<extData::MockExternalDataIFaces>();
+
+    extData::MockExternalDataIFaces* mockExtDataIfaces =
+        dynamic_cast<extData::MockExternalDataIFaces*>(extDataIface.get());
+
+    ON_CALL(*mockExtDataIfaces, fetchBMCRedundancyMgrProps())
+        .WillByDefault([&mockExtDataIfaces]() -> sdbusplus::async::task<> {
+        mockExtDataIfaces->setBMCRole(extData::BMCRole::Active);
+        mockExtDataIfaces->setBMCRedundancy(true);
+        co_return;
+    });
+
+    EXPECT_CALL(*mockExtDataIfaces, fetchBMCPosition())
+        .WillRepeatedly([]() -> sdbusplus::async::task<> { co_return; });
+
+    EXPECT_CALL(*mockExtDataIfaces,
+                createErrorLog(testing::_, testing::_, testing::_, testing::_))
+        .WillRepeatedly([]() -> sdbusplus::async::task<> { co_return; });
+
+    nlohmann::json jsonData = {
+        {"Directories",
+         {{{"Path", ManagerTest::tmpDataSyncDataDir.string() + "/srcDir/"},
+           {"DestinationPath", ManagerTest::destDir.string()},
+           {"Description", "Directory to test the sync of a rename"},
+           {"SyncDirection", "Active2Passive"},
+           {"SyncType", "Immediate"}}}}};
+
+    fs::path srcDir{jsonData["Directories"][0]["Path"]};
+    fs::path destDir{jsonData["Directories"][0]["DestinationPath"]};
+    fs::path srcFile = srcDir / "file1";
+    fs::path renamedFile = srcDir / "file2";
+    fs::create_directories(srcDir);
+
+    // Large enough to be transferred by blocks
+    std::string data;
+    for (size_t i = 0; data.size() < 64 * 1024; ++i)
+    {
+        data.append(std::to_string(i * 7919) + " ");
+    }
+    ManagerTest::writeData(srcFile, data);
+
+    writeConfig(jsonData);
+    sdbusplus::async::context ctx;
+
+    data_sync::Manager manager{ctx, std::move(extDataIface),
+                               ManagerTest::dataSyncCfgDir};
+
+    // NOLINTNEXTLINE
+    auto renameFile = [&]() -> sdbusplus::async::task<void> {
+        // Wait for the full sync and the watchers to be ready
+        co_await sdbusplus::async::sleep_for(ctx, 0.2s);
+        EXPECT_EQ(ManagerTest::readData(destDir / fs::relative(srcFile, "/")),
+                  data);
+
+        fs::rename(srcFile, renamedFile);
+        co_await sdbusplus::async::sleep_for(ctx, 1s);
+
+        ctx.request_stop();
+
+        // Force an inotify event so the running watcher wakes up and exits
+        ManagerTest::writeData(srcDir / "file3", "Dummy data to stop ctx");
+        co_return;
+    };
+
+    ctx.spawn(renameFile());
+    ctx.run();
+
+    EXPECT_FALSE(fs::exists(destDir / fs::relative(srcFile, "/")));
+    EXPECT_EQ(ManagerTest::readData(destDir / fs::relative(renamedFile, "/")),
+              data);
+
+    // The old copy on the sibling is the basis of the renamed path, hence
+    // its data isn't transferred again.
+    const auto& transfer = manager.getRenameTransfers();
+    EXPECT_EQ(transfer.filesTransferred, 1U);
+    EXPECT_EQ(transfer.literalBytes, 0U);
+    EXPECT_EQ(transfer.matchedBytes, data.size());
+}
+
+TEST_F(ManagerTest, testBurstAcrossWakeupsSyncedOnce)
+{
+    using namespace std::literals;
+    namespace extData = data_sync::ext_data;
+    namespace tracing = data_sync::tracing;
+
+    std::unique_ptr<extData::ExternalDataIFaces> extDataIface =
+        std::make_unique<extData::MockExternalDataIFaces>();
+
+    extData::MockExternalDataIFaces* mockExtDataIfaces =
+        dynamic_cast<extData::MockExternalDataIFaces*>(extDataIface.get());
+
+    ON_CALL(*mockExtDataIfaces, fetchBMCRedundancyMgrProps())
+        .WillByDefault([&mockExtDataIfaces]() -> sdbusplus::async::task<> {
+        mockExtDataIfaces->setBMCRole(extData::BMCRole::Active);
+        mockExtDataIfaces->setBMCRedundancy(true);
+        co_return;
+    });
+
+    EXPECT_CALL(*mockExtDataIfaces, fetchBMCPosition())
+        .WillRepeatedly([]() -> sdbusplus::async::task<> { co_return; });
+
+    EXPECT_CALL(*mockExtDataIfaces,
+                createErrorLog(testing::_, testing::_, testing::_, testing::_))
+        .WillRepeatedly([]() -> sdbusplus::async::task<> { co_return; });
+
+    nlohmann::json jsonData = {
+        {"Directories",
+         {{{"Path", ManagerTest::tmpDataSyncDataDir.string() + "/srcDir/"},
+           {"DestinationPath", ManagerTest::destDir.string()},
+           {"Description", "Directory to test the sync of a burst"},
+           {"SyncDirection", "Active2Passive"},
+           {"SyncType", "Immediate"}}}}};
+
+    fs::path srcDir{jsonData["Directories"][0]["Path"]};
+    fs::path destDir{jsonData["Directories"][0]["DestinationPath"]};
+    fs::create_directories(srcDir);
+
+    writeConfig(jsonData);
+    sdbusplus::async::context ctx;
+
+    data_sync::Manager manager{ctx, std::move(extDataIface),
+                               ManagerTest::dataSyncCfgDir};
+
+    // Beyond the collapse threshold only together
+    constexpr size_t burstSize = COLLAPSE_THRESHOLD + 4;
+    size_t rsyncCount{0};
+
+    // NOLINTNEXTLINE
+    auto writeBurst = [&]() -> sdbusplus::async::task<void> {
+        // Wait for the full sync and the watchers to be ready
+        co_await sdbusplus::async::sleep_for(ctx, 0.2s);
+        tracing::SpanTracer::instance().clear();
+
+        // Written in two halves, which are read in the separate wakeups
+        for (size_t i = 0; i < burstSize; ++i)
+        {
+            ManagerTest::writeData(srcDir / ("file" + std::to_string(i)),
+                                   "Data " + std::to_string(i));
+            if (i == burstSize / 2)
+            {
+                co_await sdbusplus::async::sleep_for(ctx, 10ms);
+            }
+        }
+        co_await sdbusplus::async::sleep_for(ctx, 1s);
+
+        for (const auto& span : tracing::SpanTracer::instance().getSpans())
+        {
+            if (span.stage == tracing::Stage::RsyncExit)
+            {
+                ++rsyncCount;
+            }
+        }
+
+        ctx.request_stop();
+
+        // Force an inotify event so the running watcher wakes up and exits
+        ManagerTest::writeData(srcDir / "dummy", "Dummy data to stop ctx");
+        co_return;
+    };
+
+    ctx.spawn(writeBurst());
+    ctx.run();
+
+    // The burst is collapsed into a single sync of the directory
+    EXPECT_EQ(rsyncCount, 1U);
+    for (size_t i = 0; i < burstSize; ++i)
+    {
+        const auto srcFile = srcDir / ("file" + std::to_string(i));
+        EXPECT_EQ(ManagerTest::readData(destDir / fs::relative(srcFile, "/")),
+                  "Data " + std::to_string(i));
+    }
+}
+
+TEST_F(ManagerTest, testFlushDispatchesCollapseWindow)
+{
+    using namespace std::literals;
+    namespace extData = data_sync::ext_data;
+
+    std::unique_ptr<extData::ExternalDataIFaces> extDataIface =
+        std::make_unique<extData::MockExternalDataIFaces>();
+
+    extData::MockExternalDataIFaces* mockExtDataIfaces =
+        dynamic_cast<extData::MockExternalDataIFaces*>(extDataIface.get());
+
+    ON_CALL(*mockExtDataIfaces, fetchBMCRedundancyMgrProps())
+        .WillByDefault([&mockExtDataIfaces]() -> sdbusplus::async::task<> {
+        mockExtDataIfaces->setBMCRole(extData::BMCRole::Active);
+        mockExtDataIfaces->setBMCRedundancy(true);
+        co_return;
+    });
+
+    EXPECT_CALL(*mockExtDataIfaces, fetchBMCPosition())
+        .WillRepeatedly([]() -> sdbusplus::async::task<> { co_return; });
+
+    EXPECT_CALL(*mockExtDataIfaces,
+                createErrorLog(testing::_, testing::_, testing::_, testing::_))
+        .WillRepeatedly([]() -> sdbusplus::async::task<> { co_return; });
+
+    nlohmann::json jsonData = {
+        {"Directories",
+         {{{"Path", ManagerTest::tmpDataSyncDataDir.string() + "/flushDir/"},
+           {"DestinationPath", ManagerTest::destDir.string()},
+           {"Description", "Directory to test the flush of a window"},
+           {"SyncDirection", "Active2Passive"},
+           {"SyncType", "Immediate"}}}}};
+
+    fs::path srcDir{jsonData["Directories"][0]["Path"]};
+    fs::path destDir{jsonData["Directories"][0]["DestinationPath"]};
+    fs::create_directories(srcDir);
+    const auto srcFile = srcDir / "file1";
+
+    writeConfig(jsonData);
+    sdbusplus::async::context ctx;
+
+    data_sync::Manager manager{ctx, std::move(extDataIface),
+                               ManagerTest::dataSyncCfgDir};
+
+    // NOLINTNEXTLINE
+    auto writeAndFlush = [&]() -> sdbusplus::async::task<void> {
+        // Wait for the full sync and the watchers to be ready
+        co_await sdbusplus::async::sleep_for(ctx, 0.2s);
+
+        ManagerTest::writeData(srcFile, "Data");
+        co_await sdbusplus::async::sleep_for(ctx, 10ms);
+        if constexpr (COLLAPSE_WINDOW > 10)
+        {
+            EXPECT_GT(manager.getReplicationLag(), 0ms)
+                << "The change is pending while in the collapse window";
+        }
+
+        auto failedPaths = co_await manager.flush(5s);
+        EXPECT_TRUE(failedPaths.empty());
+        EXPECT_EQ(ManagerTest::readData(destDir / fs::relative(srcFile, "/")),
+                  "Data");
+        EXPECT_EQ(manager.getReplicationLag(), 0ms);
+
+        ctx.request_stop();
+
+        // Force an inotify event so the running watcher wakes up and exits
+        ManagerTest::writeData(srcDir / "dummy", "Dummy data to stop ctx");
+        co_return;
+    };
+
+    ctx.spawn(writeAndFlush());
+    ctx.run();
+}
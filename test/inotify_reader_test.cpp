@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "inotify_reader.hpp"
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+namespace inotify = data_sync::watch::inotify;
+namespace utility = data_sync::utility;
+
+TEST(MpscRingTest, PushPopAndOverflow)
+{
+    utility::MpscRing<int> ring(3);
+    EXPECT_EQ(ring.capacity(), 4U);
+    EXPECT_FALSE(ring.pop().has_value());
+
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(ring.push(i));
+    }
+    EXPECT_FALSE(ring.push(4));
+    EXPECT_EQ(ring.overflows(), 1U);
+    EXPECT_EQ(ring.size(), 4U);
+    EXPECT_EQ(ring.highWatermark(), 4U);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(ring.pop(), i);
+    }
+    EXPECT_TRUE(ring.empty());
+
+    // The slots are reused once consumed
+    EXPECT_TRUE(ring.push(5));
+    EXPECT_EQ(ring.pop(), 5);
+}
+
+TEST(MpscRingTest, ConcurrentProducers)
+{
+    constexpr int producers = 4;
+    constexpr int valuesPerProducer = 10000;
+    utility::MpscRing<int> ring(1024);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&ring, p]() {
+            for (int i = 0; i < valuesPerProducer; ++i)
+            {
+                while (!ring.push((p * valuesPerProducer) + i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Each producer's values are consumed in its push order
+    std::vector<int> lastValue(producers, -1);
+    int consumed = 0;
+    while (consumed < producers * valuesPerProducer)
+    {
+        auto value = ring.pop();
+        if (!value.has_value())
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        const int producer = *value / valuesPerProducer;
+        EXPECT_GT(*value, lastValue[producer]);
+        lastValue[producer] = *value;
+        ++consumed;
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(InotifyReaderTest, EventsReadOnReaderThread)
+{
+    auto watchDir = fs::temp_directory_path() / "inotifyReaderTest";
+    fs::remove_all(watchDir);
+    fs::create_directories(watchDir);
+
+    utility::FD inotifyFd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC));
+    ASSERT_NE(inotifyFd(), -1);
+    const int wd = inotify_add_watch(inotifyFd(), watchDir.c_str(),
+                                     IN_CLOSE_WRITE);
+    ASSERT_NE(wd, -1);
+
+    inotify::InotifyReader reader;
+    auto channel = reader.add(inotifyFd(), 2);
+
+    for (const auto* name : {"file1", "file2", "file3"})
+    {
+        std::ofstream(watchDir / name) << "Data";
+    }
+
+    // Wait until the events are pushed
+    std::set<std::string> names;
+    pollfd pollFd{channel->eventFd(), POLLIN, 0};
+    while (names.size() < 2 && poll(&pollFd, 1, 1000) == 1)
+    {
+        uint64_t count{0};
+        ASSERT_EQ(read(channel->eventFd(), &count, sizeof(count)),
+                  static_cast<ssize_t>(sizeof(count)));
+        while (auto event = channel->events.pop())
+        {
+            EXPECT_EQ(std::get<inotify::WD>(*event), wd);
+            EXPECT_EQ(std::get<2>(*event),
+                      static_cast<inotify::EventMask>(IN_CLOSE_WRITE));
+            names.insert(std::get<inotify::BaseName>(*event));
+        }
+    }
+    EXPECT_GE(names.size(), 2U);
+
+    // The ring holds only two events, so an overflow is expected unless the
+    // events were read in separate batches.
+    if (channel->events.overflows() > 0)
+    {
+        EXPECT_TRUE(channel->overflowed.load());
+    }
+
+    reader.remove(inotifyFd());
+    fs::remove_all(watchDir);
+}
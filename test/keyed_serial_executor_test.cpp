@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "keyed_serial_executor.hpp"
+
+#include <algorithm>
+#include <random>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+using data_sync::async::KeyedSerialExecutor;
+
+TEST(KeyedSerialExecutorTest, OverlappingPathsRunInOrder)
+{
+    KeyedSerialExecutor executor;
+
+    auto deleteFile = executor.enqueue("/data/dir/file");
+    auto syncDir = executor.enqueue("/data/dir/");
+    auto other = executor.enqueue("/data/other");
+    ASSERT_TRUE(deleteFile && syncDir && other);
+
+    // The unrelated path doesn't wait
+    EXPECT_TRUE(executor.tryStart(*deleteFile));
+    EXPECT_FALSE(executor.tryStart(*syncDir));
+    EXPECT_TRUE(executor.tryStart(*other));
+
+    // Merged into the waiting one, and not into the running one
+    EXPECT_FALSE(executor.enqueue("/data/dir").has_value());
+    auto recreateFile = executor.enqueue("/data/dir/file");
+    ASSERT_TRUE(recreateFile.has_value());
+
+    EXPECT_EQ(executor.complete(*deleteFile),
+              std::vector<KeyedSerialExecutor::Ticket>{*syncDir});
+    EXPECT_TRUE(executor.tryStart(*syncDir));
+    EXPECT_FALSE(executor.tryStart(*recreateFile));
+    EXPECT_EQ(executor.complete(*syncDir),
+              std::vector<KeyedSerialExecutor::Ticket>{*recreateFile});
+    EXPECT_TRUE(executor.tryStart(*recreateFile));
+    executor.complete(*recreateFile);
+    executor.complete(*other);
+    EXPECT_EQ(executor.size(), 0U);
+}
+
+TEST(KeyedSerialExecutorTest, InjectedReorderingsKeepOrder)
+{
+    const std::vector<fs::path> paths{"/data/", "/data/a", "/data/a/x",
+                                      "/data/a/y", "/data/b", "/data/b/z",
+                                      "/other"};
+    std::mt19937 generator{0x5eed};
+
+    for (int round = 0; round < 200; ++round)
+    {
+        KeyedSerialExecutor executor;
+        std::vector<std::pair<KeyedSerialExecutor::Ticket, fs::path>> queued;
+        std::vector<std::pair<KeyedSerialExecutor::Ticket, fs::path>> running;
+        std::vector<std::pair<KeyedSerialExecutor::Ticket, fs::path>> started;
+
+        // The jobs are submitted, started and completed in a random order
+        for (int step = 0; step < 100 || executor.size() != 0; ++step)
+        {
+            switch (generator() % 3)
+            {
+                case 0:
+                    if (step < 100)
+                    {
+                        const auto& path = paths[generator() % paths.size()];
+                        if (auto ticket = executor.enqueue(path); ticket)
+                        {
+                            queued.emplace_back(*ticket, path);
+                        }
+                    }
+                    break;
+                case 1:
+                    if (!queued.empty())
+                    {
+                        auto job = queued.begin() +
+                                   (generator() % queued.size());
+                        if (executor.tryStart(job->first))
+                        {
+                            // Nothing overlapping runs at the same time
+                            EXPECT_TRUE(std::ranges::none_of(
+                                running, [&job](const auto& other) {
+                                return KeyedSerialExecutor::isOverlapping(
+                                    other.second, job->second);
+                            }));
+                            running.emplace_back(*job);
+                            started.emplace_back(*job);
+                            queued.erase(job);
+                        }
+                    }
+                    break;
+                default:
+                    if (!running.empty())
+                    {
+                        auto job = running.begin() +
+                                   (generator() % running.size());
+                        executor.complete(job->first);
+                        running.erase(job);
+                    }
+                    break;
+            }
+        }
+
+        // The overlapping jobs started in their submission order
+        for (size_t i = 0; i < started.size(); ++i)
+        {
+            for (size_t j = i + 1; j < started.size(); ++j)
+            {
+                if (KeyedSerialExecutor::isOverlapping(started[i].second,
+                                                       started[j].second))
+                {
+                    EXPECT_LT(started[i].first, started[j].first);
+                }
+            }
+        }
+    }
+}
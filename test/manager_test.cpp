@@ -1,6 +1,12 @@
 // SPDX-License-Identifier: Apache-2.0
+#include "config.h"
+
+#include "echo_suppressor.hpp"
 #include "manager_test.hpp"
 
+#include <fstream>
+#include <string>
+
 std::filesystem::path ManagerTest::dataSyncCfgDir;
 std::filesystem::path ManagerTest::tmpDataSyncDataDir;
 nlohmann::json ManagerTest::commonJsonData;
@@ -182,6 +188,10 @@ TEST_F(ManagerTest, testDBusDataPersistency)
 
         ctx.request_stop();
 
+        // The properties are persisted off the event loop
+        co_await sdbusplus::async::sleep_for(ctx,
+                                             std::chrono::milliseconds(100));
+
         // After successfull completion of full sync, the DBUS property must be
         // updated and stored. Reading and confirming the values.
         EXPECT_EQ(data_sync::persist::read<FullSyncStatus>(
@@ -203,3 +213,76 @@ TEST_F(ManagerTest, testDBusDataPersistency)
 
     ctx.run();
 }
+
+TEST_F(ManagerTest, testAppliedChangesLogTruncatedOnPassive)
+{
+    using namespace std::literals;
+    namespace ed = data_sync::ext_data;
+
+    std::unique_ptr<ed::ExternalDataIFaces> extDataIface =
+        std::make_unique<ed::MockExternalDataIFaces>();
+
+    ed::MockExternalDataIFaces* mockExtDataIfaces =
+        dynamic_cast<ed::MockExternalDataIFaces*>(extDataIface.get());
+
+    ON_CALL(*mockExtDataIfaces, fetchBMCRedundancyMgrProps())
+        // NOLINTNEXTLINE
+        .WillByDefault([&mockExtDataIfaces]() -> sdbusplus::async::task<> {
+        mockExtDataIfaces->setBMCRole(ed::BMCRole::Passive);
+        mockExtDataIfaces->setBMCRedundancy(true);
+        co_return;
+    });
+
+    EXPECT_CALL(*mockExtDataIfaces, fetchBMCPosition())
+        // NOLINTNEXTLINE
+        .WillRepeatedly([]() -> sdbusplus::async::task<> { co_return; });
+
+    ON_CALL(*mockExtDataIfaces,
+            createErrorLog(testing::_, testing::_, testing::_, testing::_))
+        .WillByDefault([]() -> sdbusplus::async::task<> { co_return; });
+
+    nlohmann::json jsonData = {
+        {"Directories",
+         {{{"Path", ManagerTest::tmpDataSyncDataDir.string() + "/srcDir/"},
+           {"DestinationPath", ManagerTest::destDir.string()},
+           {"Description", "Directory synced from the sibling BMC"},
+           {"SyncDirection", "Bidirectional"},
+           {"SyncType", "Immediate"}}}}};
+
+    fs::path srcDir{jsonData["Directories"][0]["Path"]};
+    fs::create_directories(srcDir);
+    writeConfig(jsonData);
+
+    // The changes applied by the sibling BMC, logged by the rsync daemon
+    const fs::path appliedLog{APPLIED_CHANGES_LOG};
+    fs::create_directories(appliedLog.parent_path());
+    const std::string filler(data_sync::echo::EchoSuppressor::maxLogSize, 'x');
+    std::ofstream(appliedLog) << filler << "\n";
+
+    sdbusplus::async::context ctx;
+    data_sync::Manager manager{ctx, std::move(extDataIface),
+                               ManagerTest::dataSyncCfgDir};
+
+    // NOLINTNEXTLINE
+    auto applyChanges = [&]() -> sdbusplus::async::task<void> {
+        // Drained and truncated once watched, with no local change
+        co_await sdbusplus::async::sleep_for(ctx, 0.2s);
+        EXPECT_EQ(fs::file_size(appliedLog), 0U);
+
+        // And as the daemon writes it later
+        std::ofstream(appliedLog, std::ios::app) << filler << "\n";
+        co_await sdbusplus::async::sleep_for(ctx, 0.2s);
+        EXPECT_EQ(fs::file_size(appliedLog), 0U);
+
+        ctx.request_stop();
+
+        // Force an inotify event so the running watcher wakes up and exits
+        ManagerTest::writeData(srcDir / "dummy", "Dummy data to stop ctx");
+        co_return;
+    };
+
+    ctx.spawn(applyChanges());
+    ctx.run();
+
+    fs::remove(appliedLog);
+}
@@ -20,7 +20,7 @@ class MockExternalDataIFaces : public ExternalDataIFaces
     MOCK_METHOD(sdbusplus::async::task<>, createErrorLog,
                 (const std::string&, const ErrorLevel&,
                  data_sync::ext_data::AdditionalData&,
-                 const std::optional<json>&),
+                 const error_log::FFDCSections&),
                 (override));
     MOCK_METHOD(sdbusplus::async::task<>, watchRedundancyMgrProps, (),
                 (override));
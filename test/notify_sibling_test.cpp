@@ -111,3 +111,100 @@ TEST_F(NotifySiblingTest, TestWhenSiblingNotificationEnabledOnPaths)
     // Validate the JSON
     EXPECT_EQ(notifyRqstJson, expectedJson);
 }
+
+/**
+ * Test case to verify whether the correlation id of the modification is
+ * carried in the sibling notification request when available.
+ */
+TEST_F(NotifySiblingTest, TestNotifyRequestWithCorrelationId)
+{
+    const auto configJSON = R"(
+        {
+            "Path": "/directory/path/to/sync/",
+            "Description": "Configuration to test the sibling notification",
+            "SyncDirection": "Bidirectional",
+            "SyncType": "Immediate",
+            "NotifySibling" : {
+                "Mode": "Systemd",
+                "NotifyServices": ["service1"]
+            }
+        }
+    )"_json;
+
+    fs::path modifiedDataPath{"/directory/path/to/sync/testFile"};
+    data_sync::config::DataSyncConfig dataSyncConfig(configJSON, true);
+
+    data_sync::notify::NotifySibling notifySibling(dataSyncConfig,
+                                                   modifiedDataPath, 42);
+
+    auto notifyFilePath = notifySibling.getNotifyFilePath();
+    ASSERT_TRUE(fs::exists(notifyFilePath));
+
+    std::ifstream file(notifyFilePath);
+    ASSERT_TRUE(file.is_open());
+
+    nlohmann::json notifyRqstJson;
+    file >> notifyRqstJson;
+
+    const auto expectedJson = R"(
+    {
+        "ModifiedDataPath": "/directory/path/to/sync/testFile",
+        "NotifyInfo": {
+            "Mode": "Systemd",
+            "NotifyServices": ["service1"]
+        },
+        "CorrelationId": 42
+    })"_json;
+
+    EXPECT_EQ(notifyRqstJson, expectedJson);
+}
+
+/**
+ * Test case to verify whether all the paths modified by a sync are carried in
+ * a single sibling notification request.
+ */
+TEST_F(NotifySiblingTest, TestNotifyRequestWithMultipleModifiedPaths)
+{
+    const auto configJSON = R"(
+        {
+            "Path": "/directory/path/to/sync/",
+            "Description": "Configuration to test the sibling notification",
+            "SyncDirection": "Bidirectional",
+            "SyncType": "Immediate",
+            "NotifySibling" : {
+                "Mode": "Systemd",
+                "NotifyServices": ["service1"]
+            }
+        }
+    )"_json;
+
+    const std::vector<fs::path> modifiedDataPaths{
+        "/directory/path/to/sync/testFile1",
+        "/directory/path/to/sync/testFile2"};
+    data_sync::config::DataSyncConfig dataSyncConfig(configJSON, true);
+
+    data_sync::notify::NotifySibling notifySibling(dataSyncConfig,
+                                                   modifiedDataPaths);
+
+    auto notifyFilePath = notifySibling.getNotifyFilePath();
+    ASSERT_TRUE(fs::exists(notifyFilePath));
+
+    std::ifstream file(notifyFilePath);
+    ASSERT_TRUE(file.is_open());
+
+    nlohmann::json notifyRqstJson;
+    file >> notifyRqstJson;
+
+    const auto expectedJson = R"(
+    {
+        "ModifiedDataPath": "/directory/path/to/sync/testFile1",
+        "ModifiedDataPaths": ["/directory/path/to/sync/testFile1",
+                              "/directory/path/to/sync/testFile2"],
+        "NotifyInfo": {
+            "Mode": "Systemd",
+            "NotifyServices": ["service1"]
+        }
+    })"_json;
+
+    EXPECT_EQ(notifyRqstJson, expectedJson);
+}
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "parent_dir_watch.hpp"
+
+#include <sdbusplus/async.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+namespace inotify = data_sync::watch::inotify;
+
+class ParentDirWatchTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char tmpdir[] = "/tmp/pdsParentDirWatchXXXXXX";
+        tmpDir = mkdtemp(tmpdir);
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(tmpDir);
+    }
+
+    fs::path tmpDir;
+};
+
+TEST_F(ParentDirWatchTest, RoutesEventsByBaseName)
+{
+    sdbusplus::async::context ctx;
+    inotify::ParentDirWatch watch(ctx, tmpDir);
+    auto file1 = watch.subscribe(tmpDir / "file1");
+    auto file2 = watch.subscribe(tmpDir / "file2");
+
+    // An atomic save of file1, by renaming a temporary file over it
+    watch.dispatch({{1, "file1.tmp", IN_CLOSE_WRITE, 0},
+                    {1, "file1.tmp", IN_MOVED_FROM, 10},
+                    {1, "file1", IN_MOVED_TO, 10},
+                    {1, "other", IN_DELETE, 0}});
+
+    auto dataOps = file1->takeDataOperations();
+    ASSERT_EQ(dataOps.size(), 1U);
+    EXPECT_EQ(dataOps[0], inotify::DataOperation(tmpDir / "file1",
+                                                 inotify::DataOps::COPY));
+    EXPECT_TRUE(file2->takeDataOperations().empty());
+
+    // Only the last change is synced
+    watch.dispatch(
+        {{1, "file2", IN_CLOSE_WRITE, 0}, {1, "file2", IN_DELETE, 0}});
+    dataOps = file2->takeDataOperations();
+    ASSERT_EQ(dataOps.size(), 1U);
+    EXPECT_EQ(dataOps[0], inotify::DataOperation(tmpDir / "file2",
+                                                 inotify::DataOps::DELETE));
+}
+
+TEST_F(ParentDirWatchTest, SkipsUpdatesByRsync)
+{
+    sdbusplus::async::context ctx;
+    inotify::ParentDirWatch watch(ctx, tmpDir);
+    auto file1 = watch.subscribe(tmpDir / "file1");
+
+    watch.dispatch({{1, ".file1.AbCdEf", IN_CLOSE_WRITE, 0},
+                    {1, ".file1.AbCdEf", IN_MOVED_FROM, 20},
+                    {1, "file1", IN_MOVED_TO, 20}});
+    EXPECT_TRUE(file1->takeDataOperations().empty());
+}
+
+TEST_F(ParentDirWatchTest, ClosesSubscriptionsOnDirRemoval)
+{
+    sdbusplus::async::context ctx;
+    inotify::ParentDirWatch watch(ctx, tmpDir);
+    auto file1 = watch.subscribe(tmpDir / "file1");
+
+    watch.dispatch({{1, "", IN_DELETE_SELF, 0}, {1, "file1", IN_DELETE, 0}});
+
+    EXPECT_FALSE(watch.isWatching());
+    EXPECT_TRUE(file1->isClosed());
+    EXPECT_TRUE(file1->takeDataOperations().empty());
+
+    // The files subscribed later are watched by themselves
+    EXPECT_TRUE(watch.subscribe(tmpDir / "file2")->isClosed());
+}
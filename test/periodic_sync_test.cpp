@@ -594,3 +594,234 @@ TEST_F(ManagerTest, PeriodicDataSyncTestWithExcludeList)
         sdbusplus::async::execution::then([&ctx]() { ctx.request_stop(); }));
     ctx.run();
 }
+
+TEST_F(ManagerTest, PeriodicFlushTest)
+{
+    using namespace std::literals;
+    namespace ed = data_sync::ext_data;
+
+    std::unique_ptr<ed::ExternalDataIFaces> extDataIface =
+        std::make_unique<ed::MockExternalDataIFaces>();
+
+    ed::MockExternalDataIFaces* mockExtDataIfaces =
+        dynamic_cast<ed::MockExternalDataIFaces*>(extDataIface.get());
+
+    ON_CALL(*mockExtDataIfaces, fetchBMCRedundancyMgrProps())
+        // NOLINTNEXTLINE
+        .WillByDefault([&mockExtDataIfaces]() -> sdbusplus::async::task<> {
+        mockExtDataIfaces->setBMCRole(ed::BMCRole::Active);
+        mockExtDataIfaces->setBMCRedundancy(true);
+        co_return;
+    });
+
+    EXPECT_CALL(*mockExtDataIfaces, fetchBMCPosition())
+        // NOLINTNEXTLINE
+        .WillRepeatedly([]() -> sdbusplus::async::task<> { co_return; });
+
+    // Long periodicity to make sure that only the flush syncs the data
+    nlohmann::json jsonData = {
+        {"Files",
+         {{{"Path", ManagerTest::tmpDataSyncDataDir.string() + "/srcFile1"},
+           {"DestinationPath", ManagerTest::destDir.string()},
+           {"Description", "Flush test file"},
+           {"SyncDirection", "Active2Passive"},
+           {"SyncType", "Periodic"},
+           {"Periodicity", "PT1H"}}}}};
+
+    fs::path srcFile{jsonData["Files"][0]["Path"]};
+    fs::path destDir{jsonData["Files"][0]["DestinationPath"]};
+    fs::path destFile = destDir / fs::relative(srcFile, "/");
+
+    writeConfig(jsonData);
+    sdbusplus::async::context ctx;
+
+    std::string data{"Initial Data\n"};
+    ManagerTest::writeData(srcFile, data);
+
+    data_sync::Manager manager{ctx, std::move(extDataIface),
+                               ManagerTest::dataSyncCfgDir};
+
+    std::string updatedData{"Data got updated\n"};
+    auto flushAndCheck = [&]() -> sdbusplus::async::task<> {
+        // Wait for the full sync to complete
+        using data_sync::FullSyncStatus;
+        auto status = manager.getFullSyncStatus();
+        while (status != FullSyncStatus::FullSyncCompleted &&
+               status != FullSyncStatus::FullSyncFailed)
+        {
+            status = manager.getFullSyncStatus();
+            co_await sdbusplus::async::sleep_for(ctx, 50ms);
+        }
+        EXPECT_EQ(ManagerTest::readData(destFile), data);
+
+        ManagerTest::writeData(srcFile, updatedData);
+        co_await sdbusplus::async::sleep_for(ctx, 100ms);
+        EXPECT_GT(manager.getReplicationLag(), 0ms)
+            << "The update is pending until the next periodic interval";
+
+        auto failedPaths = co_await manager.flush(5s);
+        EXPECT_TRUE(failedPaths.empty());
+        EXPECT_EQ(ManagerTest::readData(destFile), updatedData);
+
+        ctx.request_stop();
+        co_return;
+    };
+
+    ctx.spawn(flushAndCheck());
+    ctx.run();
+}
+
+TEST_F(ManagerTest, PeriodicIdleIntervalSkipTest)
+{
+    using namespace std::literals;
+    namespace ed = data_sync::ext_data;
+
+    std::unique_ptr<ed::ExternalDataIFaces> extDataIface =
+        std::make_unique<ed::MockExternalDataIFaces>();
+
+    ed::MockExternalDataIFaces* mockExtDataIfaces =
+        dynamic_cast<ed::MockExternalDataIFaces*>(extDataIface.get());
+
+    ON_CALL(*mockExtDataIfaces, fetchBMCRedundancyMgrProps())
+        // NOLINTNEXTLINE
+        .WillByDefault([&mockExtDataIfaces]() -> sdbusplus::async::task<> {
+        mockExtDataIfaces->setBMCRole(ed::BMCRole::Active);
+        mockExtDataIfaces->setBMCRedundancy(true);
+        co_return;
+    });
+
+    EXPECT_CALL(*mockExtDataIfaces, fetchBMCPosition())
+        // NOLINTNEXTLINE
+        .WillRepeatedly([]() -> sdbusplus::async::task<> { co_return; });
+
+    nlohmann::json jsonData = {
+        {"Files",
+         {{{"Path", ManagerTest::tmpDataSyncDataDir.string() + "/srcFile1"},
+           {"DestinationPath", ManagerTest::destDir.string()},
+           {"Description", "Idle interval test file"},
+           {"SyncDirection", "Active2Passive"},
+           {"SyncType", "Periodic"},
+           {"Periodicity", "PT1S"}}}}};
+
+    fs::path srcFile{jsonData["Files"][0]["Path"]};
+    fs::path destDir{jsonData["Files"][0]["DestinationPath"]};
+    fs::path destFile = destDir / fs::relative(srcFile, "/");
+
+    writeConfig(jsonData);
+    sdbusplus::async::context ctx;
+
+    std::string data{"Initial Data\n"};
+    ManagerTest::writeData(srcFile, data);
+
+    data_sync::Manager manager{ctx, std::move(extDataIface),
+                               ManagerTest::dataSyncCfgDir};
+
+    std::string updatedData{"Data got updated\n"};
+    auto checkIdleIntervals = [&]() -> sdbusplus::async::task<> {
+        // The first interval syncs as the data might be changed before
+        co_await sdbusplus::async::sleep_for(ctx, 1.5s);
+        EXPECT_EQ(ManagerTest::readData(destFile), data);
+
+        // The idle intervals don't sync, hence the removed destination file
+        // is not synced back.
+        fs::remove(destFile);
+        co_await sdbusplus::async::sleep_for(ctx, 2.5s);
+        EXPECT_FALSE(fs::exists(destFile))
+            << "The idle intervals should be skipped";
+
+        ManagerTest::writeData(srcFile, updatedData);
+        co_await sdbusplus::async::sleep_for(ctx, 1.5s);
+        EXPECT_EQ(ManagerTest::readData(destFile), updatedData);
+
+        ctx.request_stop();
+        co_return;
+    };
+
+    ctx.spawn(checkIdleIntervals());
+    ctx.run();
+}
+
+TEST_F(ManagerTest, PeriodicScheduleBatchTest)
+{
+    using namespace std::literals;
+    namespace ed = data_sync::ext_data;
+
+    std::unique_ptr<ed::ExternalDataIFaces> extDataIface =
+        std::make_unique<ed::MockExternalDataIFaces>();
+
+    ed::MockExternalDataIFaces* mockExtDataIfaces =
+        dynamic_cast<ed::MockExternalDataIFaces*>(extDataIface.get());
+
+    ON_CALL(*mockExtDataIfaces, fetchBMCRedundancyMgrProps())
+        // NOLINTNEXTLINE
+        .WillByDefault([&mockExtDataIfaces]() -> sdbusplus::async::task<> {
+        mockExtDataIfaces->setBMCRole(ed::BMCRole::Active);
+        mockExtDataIfaces->setBMCRedundancy(true);
+        co_return;
+    });
+
+    EXPECT_CALL(*mockExtDataIfaces, fetchBMCPosition())
+        // NOLINTNEXTLINE
+        .WillRepeatedly([]() -> sdbusplus::async::task<> { co_return; });
+
+    // The files of the same periodicity are synced together
+    nlohmann::json jsonData = {
+        {"Files",
+         {{{"Path", ManagerTest::tmpDataSyncDataDir.string() + "/srcFile1"},
+           {"DestinationPath", ManagerTest::destDir.string()},
+           {"Description", "Batched periodic file"},
+           {"SyncDirection", "Active2Passive"},
+           {"SyncType", "Periodic"},
+           {"Periodicity", "PT2S"}},
+          {{"Path", ManagerTest::tmpDataSyncDataDir.string() + "/srcFile2"},
+           {"DestinationPath", ManagerTest::destDir.string()},
+           {"Description", "Batched periodic file"},
+           {"SyncDirection", "Active2Passive"},
+           {"SyncType", "Periodic"},
+           {"Periodicity", "PT2S"}}}}};
+
+    fs::path srcFile1{jsonData["Files"][0]["Path"]};
+    fs::path srcFile2{jsonData["Files"][1]["Path"]};
+    fs::path destDir{jsonData["Files"][0]["DestinationPath"]};
+    fs::path destFile1 = destDir / fs::relative(srcFile1, "/");
+    fs::path destFile2 = destDir / fs::relative(srcFile2, "/");
+
+    writeConfig(jsonData);
+    sdbusplus::async::context ctx;
+
+    std::string data{"Initial Data\n"};
+    ManagerTest::writeData(srcFile1, data);
+    ManagerTest::writeData(srcFile2, data);
+
+    data_sync::Manager manager{ctx, std::move(extDataIface),
+                               ManagerTest::dataSyncCfgDir};
+
+    std::string updatedData{"Data got updated\n"};
+    auto checkSchedule = [&]() -> sdbusplus::async::task<> {
+        co_await sdbusplus::async::sleep_for(ctx, 0.5s);
+        auto schedule = manager.getPeriodicSchedule();
+        EXPECT_EQ(schedule.size(), 2U);
+        if (schedule.size() == 2)
+        {
+            EXPECT_EQ(schedule[0].periodicity, 2s);
+            EXPECT_EQ(schedule[0].nextDue, schedule[1].nextDue)
+                << "The same periodicity should be due together";
+        }
+
+        co_await sdbusplus::async::sleep_for(ctx, 2s);
+        EXPECT_EQ(ManagerTest::readData(destFile1), data);
+        EXPECT_EQ(ManagerTest::readData(destFile2), data);
+
+        ManagerTest::writeData(srcFile1, updatedData);
+        ManagerTest::writeData(srcFile2, updatedData);
+        co_await sdbusplus::async::sleep_for(ctx, 2s);
+        EXPECT_EQ(ManagerTest::readData(destFile1), updatedData);
+        EXPECT_EQ(ManagerTest::readData(destFile2), updatedData);
+
+        ctx.request_stop();
+        co_return;
+    };
+
+    ctx.spawn(checkSchedule());
+    ctx.run();
+}
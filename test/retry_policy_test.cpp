@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "retry_policy.hpp"
+
+#include <gtest/gtest.h>
+
+namespace retry = data_sync::retry;
+using namespace std::chrono_literals;
+
+TEST(RetryPolicyTest, BackoffDoublesWithJitter)
+{
+    constexpr auto baseInterval = 10s;
+    for (size_t attempt = 1; attempt <= 4; ++attempt)
+    {
+        const std::chrono::milliseconds wait = baseInterval *
+                                               (1U << (attempt - 1));
+        for (int i = 0; i < 100; ++i)
+        {
+            auto backoff = retry::backoff(baseInterval, attempt);
+            EXPECT_LE(backoff, wait);
+            EXPECT_GE(backoff, wait / 2);
+        }
+    }
+
+    // Bounded even for the large attempts
+    EXPECT_LE(retry::backoff(baseInterval, 100), retry::maxBackoff);
+    EXPECT_EQ(retry::backoff(0s, 3), 0ms);
+}
+
+TEST(RetryPolicyTest, OnlyConnectionFailuresCount)
+{
+    EXPECT_TRUE(retry::isLinkFailure(10));
+    EXPECT_TRUE(retry::isLinkFailure(35));
+    EXPECT_FALSE(retry::isLinkFailure(0));
+    EXPECT_FALSE(retry::isLinkFailure(23));
+    EXPECT_FALSE(retry::isLinkFailure(24));
+}
+
+TEST(RetryPolicyTest, CircuitBreakerTransitions)
+{
+    using State = retry::CircuitBreaker::State;
+    retry::CircuitBreaker breaker(3, 10s);
+    auto now = retry::Clock::now();
+
+    // A success in between resets the consecutive failures
+    EXPECT_FALSE(breaker.recordFailure(now));
+    EXPECT_FALSE(breaker.recordFailure(now));
+    EXPECT_FALSE(breaker.recordSuccess());
+    EXPECT_FALSE(breaker.recordFailure(now));
+    EXPECT_FALSE(breaker.recordFailure(now));
+    EXPECT_EQ(breaker.getState(), State::Closed);
+    EXPECT_TRUE(breaker.allowRequest(now));
+
+    EXPECT_TRUE(breaker.recordFailure(now));
+    EXPECT_EQ(breaker.getState(), State::Open);
+    EXPECT_FALSE(breaker.allowRequest(now + 5s));
+
+    // The in-flight failures don't extend the cooldown
+    EXPECT_FALSE(breaker.recordFailure(now + 5s));
+
+    // Only one probe is allowed after the cooldown
+    EXPECT_TRUE(breaker.allowRequest(now + 10s));
+    EXPECT_EQ(breaker.getState(), State::HalfOpen);
+    EXPECT_FALSE(breaker.allowRequest(now + 11s));
+
+    // The failed probe opens it again
+    EXPECT_FALSE(breaker.recordFailure(now + 12s));
+    EXPECT_EQ(breaker.getState(), State::Open);
+    EXPECT_FALSE(breaker.allowRequest(now + 20s));
+
+    // The lost probe is replaced after the cooldown
+    EXPECT_TRUE(breaker.allowRequest(now + 22s));
+    EXPECT_TRUE(breaker.allowRequest(now + 32s));
+
+    EXPECT_TRUE(breaker.recordSuccess());
+    EXPECT_EQ(breaker.getState(), State::Closed);
+    EXPECT_TRUE(breaker.allowRequest(now + 33s));
+}
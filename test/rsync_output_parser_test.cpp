@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "rsync_output_parser.hpp"
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+namespace rsync = data_sync::utility::rsync;
+
+namespace
+{
+
+constexpr std::string_view rsyncOutput{
+    "cd+++++++++ var/lib/app/\n"
+    ">f+++++++++ var/lib/app/new\n"
+    ">f.st...... var/lib/app/changed\n"
+    ".f...p..... var/lib/app/chmoded\n"
+    "*deleting   var/lib/app/old\n"
+    "\n"
+    "Number of files: 5 (reg: 4, dir: 1)\n"
+    "Number of created files: 2 (reg: 1, dir: 1)\n"
+    "Number of deleted files: 1 (reg: 1)\n"
+    "Number of regular files transferred: 2\n"
+    "Total file size: 1,234,567 bytes\n"
+    "Total transferred file size: 12,345 bytes\n"
+    "Literal data: 2,345 bytes\n"
+    "Matched data: 10,000 bytes\n"
+    "File list size: 0\n"
+    "Total bytes sent: 2,601\n"
+    "Total bytes received: 62\n"
+    "\n"
+    "sent 2,601 bytes  received 62 bytes  5,326.00 bytes/sec\n"
+    "total size is 1,234,567  speedup is 463.60"};
+
+} // namespace
+
+TEST(RsyncOutputParserTest, ParsesStatsAndItemizedChanges)
+{
+    rsync::OutputParser parser;
+    parser.feed(rsyncOutput);
+    parser.finish();
+
+    const auto& stats = parser.getStats();
+    EXPECT_EQ(stats.filesTransferred, 2);
+    EXPECT_EQ(stats.literalBytes, 2345);
+    EXPECT_EQ(stats.matchedBytes, 10000);
+    EXPECT_EQ(stats.deletions, 1);
+    EXPECT_FALSE(stats.changesTruncated);
+
+    ASSERT_EQ(stats.changes.size(), 5);
+    EXPECT_EQ(stats.changes[0].path, "var/lib/app/");
+    EXPECT_TRUE(stats.changes[1].isTransferred());
+    EXPECT_EQ(stats.changes[2].summary, ">f.st......");
+    EXPECT_FALSE(stats.changes[3].isTransferred());
+    EXPECT_TRUE(stats.changes[4].isDeleted());
+    EXPECT_EQ(stats.changes[4].path, "var/lib/app/old");
+
+    EXPECT_TRUE(stats.hasChangesUnder("/var/lib/app/"));
+    EXPECT_TRUE(stats.hasChangesUnder("/var/lib/app/old"));
+    EXPECT_FALSE(stats.hasChangesUnder("/var/lib/app/chmoded"));
+    EXPECT_FALSE(stats.hasChangesUnder("/var/lib/other"));
+
+    // The attribute only changes are not the data changes
+    EXPECT_EQ(stats.getChangedPathsUnder("/var/lib/app/"),
+              (std::vector<fs::path>{"/var/lib/app", "/var/lib/app/new",
+                                     "/var/lib/app/changed",
+                                     "/var/lib/app/old"}));
+    EXPECT_EQ(stats.getChangedPathsUnder("/var/lib/app/changed"),
+              (std::vector<fs::path>{"/var/lib/app/changed"}));
+    EXPECT_TRUE(stats.getChangedPathsUnder("/var/lib/other").empty());
+}
+
+TEST(RsyncOutputParserTest, ParsesAcrossChunks)
+{
+    // Fed a byte at a time, as the lines can be split across the reads
+    rsync::OutputParser parser;
+    for (char c : rsyncOutput)
+    {
+        parser.feed(std::string_view(&c, 1));
+    }
+    parser.finish();
+
+    const auto& stats = parser.getStats();
+    EXPECT_EQ(stats.filesTransferred, 2);
+    EXPECT_EQ(stats.literalBytes, 2345);
+    EXPECT_EQ(stats.changes.size(), 5);
+}
+
+TEST(RsyncOutputParserTest, ParsesHumanReadableNumbers)
+{
+    EXPECT_EQ(rsync::OutputParser::parseNumber("1,234 bytes"), 1234);
+    EXPECT_EQ(rsync::OutputParser::parseNumber(" 1.2K bytes"), 1200);
+    EXPECT_EQ(rsync::OutputParser::parseNumber("3.25M"), 3250000);
+    EXPECT_EQ(rsync::OutputParser::parseNumber("2G"), 2000000000);
+    EXPECT_EQ(rsync::OutputParser::parseNumber("0 bytes"), 0);
+    EXPECT_EQ(rsync::OutputParser::parseNumber("bytes"), std::nullopt);
+
+    rsync::OutputParser parser;
+    parser.feed("Number of files transferred: 1\nLiteral data: 1.2K bytes\n");
+    parser.finish();
+    EXPECT_EQ(parser.getStats().filesTransferred, 1);
+    EXPECT_EQ(parser.getStats().literalBytes, 1200);
+}
+
+TEST(RsyncOutputParserTest, BoundsItemizedChanges)
+{
+    rsync::OutputParser parser;
+    for (size_t i = 0; i <= rsync::OutputParser::maxChanges; ++i)
+    {
+        parser.feed("*deleting   var/lib/app/file" + std::to_string(i) + "\n");
+    }
+    parser.finish();
+
+    // The deletions are counted from the itemized changes without the stats
+    const auto& stats = parser.getStats();
+    EXPECT_TRUE(stats.changesTruncated);
+    EXPECT_EQ(stats.changes.size(), rsync::OutputParser::maxChanges);
+    EXPECT_EQ(stats.deletions, rsync::OutputParser::maxChanges + 1);
+    EXPECT_TRUE(stats.hasChangesUnder("/var/lib/unknown"));
+}
@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sibling_monitor.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <sdbusplus/async.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace sibling = data_sync::sibling;
+
+class SiblingMonitorTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        listenFd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        ASSERT_NE(listenFd, -1);
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = 0; // Any free port
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        auto* sockAddr = reinterpret_cast<sockaddr*>(&addr);
+        ASSERT_EQ(bind(listenFd, sockAddr, sizeof(addr)), 0);
+        ASSERT_EQ(listen(listenFd, 1), 0);
+
+        socklen_t addrLen = sizeof(addr);
+        ASSERT_EQ(getsockname(listenFd, sockAddr, &addrLen), 0);
+        port = ntohs(addr.sin_port);
+    }
+
+    void TearDown() override
+    {
+        if (server.joinable())
+        {
+            server.join();
+        }
+        if (listenFd != -1)
+        {
+            close(listenFd);
+        }
+    }
+
+    // Accepts a connection and sends the given greeting, like the rsync
+    // daemon or a stunnel which fails to reach the sibling BMC.
+    void serveOnce(std::string greeting)
+    {
+        server = std::thread([this, greeting = std::move(greeting)]() {
+            int connFd = accept(listenFd, nullptr, nullptr);
+            if (connFd == -1)
+            {
+                return;
+            }
+            if (!greeting.empty())
+            {
+                EXPECT_EQ(write(connFd, greeting.data(), greeting.size()),
+                          static_cast<ssize_t>(greeting.size()));
+            }
+            close(connFd);
+        });
+    }
+
+    bool probeOnce()
+    {
+        sdbusplus::async::context ctx;
+        sibling::SiblingMonitor monitor(ctx, "127.0.0.1", port,
+                                        std::chrono::seconds(1), 1, nullptr);
+        bool available{false};
+
+        auto probe = [&]() -> sdbusplus::async::task<> {
+            available = co_await monitor.probe();
+            ctx.request_stop();
+            co_return;
+        };
+        ctx.spawn(probe());
+        ctx.run();
+        return available;
+    }
+
+    int listenFd{-1};
+    uint16_t port{0};
+    std::thread server;
+};
+
+TEST_F(SiblingMonitorTest, AvailableOnRsyncdGreeting)
+{
+    serveOnce("@RSYNCD: 31.0\n");
+    EXPECT_TRUE(probeOnce());
+}
+
+TEST_F(SiblingMonitorTest, NotAvailableIfClosedWithoutGreeting)
+{
+    // The local stunnel accepts but closes as the sibling isn't reachable
+    serveOnce("");
+    EXPECT_FALSE(probeOnce());
+}
+
+TEST_F(SiblingMonitorTest, NotAvailableIfNotListening)
+{
+    close(listenFd);
+    listenFd = -1;
+    EXPECT_FALSE(probeOnce());
+}
+
+TEST_F(SiblingMonitorTest, NotifyAvailabilityChange)
+{
+    sdbusplus::async::context ctx;
+    std::vector<bool> notified;
+    sibling::SiblingMonitor monitor(
+        ctx, "127.0.0.1", port, std::chrono::seconds(1), 1,
+        [&notified](bool available) { notified.push_back(available); });
+    EXPECT_TRUE(monitor.isAvailable());
+
+    // Nothing serves the greeting, hence not available
+    close(listenFd);
+    listenFd = -1;
+
+    auto stopAfterProbe = [&]() -> sdbusplus::async::task<> {
+        co_await sdbusplus::async::sleep_for(ctx,
+                                             std::chrono::milliseconds(200));
+        ctx.request_stop();
+        co_return;
+    };
+    ctx.spawn(monitor.run());
+    ctx.spawn(stopAfterProbe());
+    ctx.run();
+
+    EXPECT_FALSE(monitor.isAvailable());
+    ASSERT_EQ(notified.size(), 1U);
+    EXPECT_FALSE(notified[0]);
+}
+
+TEST_F(SiblingMonitorTest, NotAvailableAfterConsecutiveFailures)
+{
+    using namespace std::chrono_literals;
+    sdbusplus::async::context ctx;
+    std::vector<bool> notified;
+    sibling::SiblingMonitor monitor(
+        ctx, "127.0.0.1", port, 100ms, 3,
+        [&notified](bool available) { notified.push_back(available); });
+
+    close(listenFd);
+    listenFd = -1;
+
+    bool availableAfterTwoFailures{false};
+    auto checkAvailability = [&]() -> sdbusplus::async::task<> {
+        // The probes at 0ms and 100ms failed
+        co_await sdbusplus::async::sleep_for(ctx, 150ms);
+        availableAfterTwoFailures = monitor.isAvailable();
+
+        // The probe at 200ms failed too
+        co_await sdbusplus::async::sleep_for(ctx, 250ms);
+        ctx.request_stop();
+        co_return;
+    };
+    ctx.spawn(monitor.run());
+    ctx.spawn(checkAvailability());
+    ctx.run();
+
+    EXPECT_TRUE(availableAfterTwoFailures);
+    EXPECT_FALSE(monitor.isAvailable());
+    ASSERT_EQ(notified.size(), 1U);
+    EXPECT_FALSE(notified[0]);
+}
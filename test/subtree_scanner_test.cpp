@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "subtree_scanner.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+namespace scan = data_sync::watch::scan;
+using namespace std::chrono_literals;
+
+class SubtreeScannerTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char tmpdir[] = "/tmp/pdsSubtreeScannerXXXXXX";
+        tmpDir = mkdtemp(tmpdir);
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(tmpDir);
+    }
+
+    static void writeData(const fs::path& fileName, const std::string& data)
+    {
+        std::ofstream out(fileName);
+        ASSERT_TRUE(out.is_open()) << "Failed to open " << fileName;
+        out << data;
+        out.close();
+    }
+
+    static bool contains(const std::vector<fs::path>& paths,
+                         const fs::path& path)
+    {
+        return std::ranges::find(paths, path) != paths.end();
+    }
+
+    fs::path tmpDir;
+};
+
+TEST_F(SubtreeScannerTest, ReportsChangesSinceLastScan)
+{
+    fs::create_directories(tmpDir / "dir1" / "dir2");
+    writeData(tmpDir / "file1", "Data1");
+    writeData(tmpDir / "dir1" / "file2", "Data2");
+    writeData(tmpDir / "dir1" / "dir2" / "file3", "Data3");
+
+    scan::SubtreeScanner scanner(tmpDir, [](const fs::path&) {
+        return false;
+    });
+    EXPECT_EQ(scanner.getDirCount(), 3U);
+    EXPECT_TRUE(scanner.scan().empty());
+
+    writeData(tmpDir / "dir1" / "dir2" / "file3", "Modified");
+    fs::last_write_time(tmpDir / "dir1" / "dir2" / "file3",
+                        fs::last_write_time(tmpDir / "dir1" / "dir2" /
+                                            "file3") +
+                            1s);
+    fs::remove(tmpDir / "dir1" / "file2");
+    fs::create_directories(tmpDir / "newDir");
+    writeData(tmpDir / "newDir" / "file4", "Data4");
+
+    auto changes = scanner.scan();
+    EXPECT_EQ(changes.modified.size(), 2U);
+    EXPECT_TRUE(
+        contains(changes.modified, tmpDir / "dir1" / "dir2" / "file3"));
+    EXPECT_TRUE(contains(changes.modified, tmpDir / "newDir" / ""));
+    ASSERT_EQ(changes.removed.size(), 1U);
+    EXPECT_EQ(changes.removed[0], tmpDir / "dir1" / "file2");
+
+    // The removed directory is reported once, without its children
+    fs::remove_all(tmpDir / "dir1");
+    changes = scanner.scan();
+    EXPECT_TRUE(changes.modified.empty());
+    ASSERT_EQ(changes.removed.size(), 1U);
+    EXPECT_EQ(changes.removed[0], tmpDir / "dir1");
+    EXPECT_EQ(scanner.getDirCount(), 2U);
+}
+
+TEST_F(SubtreeScannerTest, SkipsUninterestedEntries)
+{
+    fs::create_directories(tmpDir / ".hidden");
+    scan::SubtreeScanner scanner(tmpDir, [](const fs::path& path) {
+        return path.filename().string().starts_with(".");
+    });
+
+    writeData(tmpDir / ".hidden" / "file1", "Data1");
+    writeData(tmpDir / ".file2", "Data2");
+    writeData(tmpDir / "file3", "Data3");
+
+    auto changes = scanner.scan();
+    ASSERT_EQ(changes.modified.size(), 1U);
+    EXPECT_EQ(changes.modified[0], tmpDir / "file3");
+    EXPECT_TRUE(changes.removed.empty());
+    EXPECT_EQ(scanner.getDirCount(), 1U);
+}
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "timer_wheel.hpp"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace schedule = data_sync::schedule;
+using namespace std::chrono_literals;
+
+TEST(TimerWheelTest, SamePeriodicityIsDueTogether)
+{
+    const auto epoch = schedule::Clock::now();
+    schedule::TimerWheel wheel(epoch);
+
+    // Added at the different times, but aligned to the epoch
+    wheel.add("/var/lib/a/", 60s, epoch + 5s);
+    wheel.add("/var/lib/b/", 60s, epoch + 42s);
+    wheel.add("/var/lib/c/", 7s, epoch + 5s);
+    EXPECT_TRUE(wheel.contains("/var/lib/a/"));
+    EXPECT_EQ(wheel.getNextDue(), epoch + 7s);
+
+    EXPECT_TRUE(wheel.popDue(epoch + 6s).empty());
+    EXPECT_EQ(wheel.popDue(epoch + 7s),
+              (std::vector<schedule::fs::path>{"/var/lib/c/"}));
+    EXPECT_EQ(wheel.getNextDue(), epoch + 14s);
+
+    // Every interval of the same periodicity stays together
+    for (auto due = epoch + 60s; due < epoch + 300s; due += 60s)
+    {
+        auto duePaths = wheel.popDue(due);
+        std::erase(duePaths, "/var/lib/c/");
+        EXPECT_EQ(duePaths, (std::vector<schedule::fs::path>{"/var/lib/a/",
+                                                             "/var/lib/b/"}));
+    }
+
+    wheel.remove("/var/lib/c/");
+    EXPECT_FALSE(wheel.contains("/var/lib/c/"));
+    EXPECT_EQ(wheel.getNextDue(), epoch + 300s);
+
+    wheel.remove("/var/lib/a/");
+    wheel.remove("/var/lib/b/");
+    EXPECT_TRUE(wheel.empty());
+    EXPECT_EQ(wheel.getNextDue(), std::nullopt);
+}
+
+TEST(TimerWheelTest, DueWithinSlackAreDispatchedTogether)
+{
+    const auto epoch = schedule::Clock::now();
+    schedule::TimerWheel wheel(epoch);
+
+    // The slack is a tenth of the periodicity, bounded by the maxSlack
+    wheel.add("/var/lib/a/", 60s, epoch);
+    wheel.add("/var/lib/b/", 63s, epoch);
+    wheel.add("/var/lib/c/", 90s, epoch);
+    wheel.add("/var/lib/d/", 600s, epoch);
+
+    auto duePaths = wheel.popDue(epoch + 60s);
+    std::ranges::sort(duePaths);
+    EXPECT_EQ(duePaths, (std::vector<schedule::fs::path>{"/var/lib/a/",
+                                                         "/var/lib/b/"}));
+
+    // The early dispatch doesn't shift the later intervals
+    const auto nextSchedule = wheel.getSchedule();
+    ASSERT_EQ(nextSchedule.size(), 4U);
+    std::map<schedule::fs::path, schedule::Clock::time_point> nextDue;
+    for (const auto& entry : nextSchedule)
+    {
+        nextDue.emplace(entry.path, entry.nextDue);
+    }
+    EXPECT_EQ(nextDue["/var/lib/a/"], epoch + 120s);
+    EXPECT_EQ(nextDue["/var/lib/b/"], epoch + 126s);
+    EXPECT_EQ(nextDue["/var/lib/c/"], epoch + 90s);
+    EXPECT_EQ(nextDue["/var/lib/d/"], epoch + 600s);
+    EXPECT_EQ(nextSchedule.front().path, "/var/lib/c/");
+    EXPECT_EQ(nextSchedule.front().periodicity, 90s);
+
+    // Nothing is dispatched early without a due path
+    EXPECT_TRUE(wheel.popDue(epoch + 88s).empty());
+}
+
+TEST(TimerWheelTest, MissedIntervalsAreSkipped)
+{
+    const auto epoch = schedule::Clock::now();
+    schedule::TimerWheel wheel(epoch);
+
+    wheel.add("/var/lib/a/", 10s, epoch);
+    wheel.add("/var/lib/b/", 60s, epoch);
+
+    // Dispatched once though many intervals are missed
+    EXPECT_EQ(wheel.popDue(epoch + 35s),
+              (std::vector<schedule::fs::path>{"/var/lib/a/"}));
+    EXPECT_EQ(wheel.getNextDue(), epoch + 40s);
+
+    // Beyond a round of the wheel
+    auto duePaths = wheel.popDue(epoch + 1000s);
+    std::ranges::sort(duePaths);
+    EXPECT_EQ(duePaths, (std::vector<schedule::fs::path>{"/var/lib/a/",
+                                                         "/var/lib/b/"}));
+    EXPECT_EQ(wheel.getNextDue(), epoch + 1010s);
+    EXPECT_TRUE(wheel.popDue(epoch + 1005s).empty());
+}
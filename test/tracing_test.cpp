@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "tracing.hpp"
+
+#include <unistd.h>
+
+#include <nlohmann/json.hpp>
+#include <sdbusplus/async.hpp>
+
+#include <atomic>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+namespace tracing = data_sync::tracing;
+
+TEST(TracingTest, RingBufferKeepsRecentSpans)
+{
+    tracing::SpanTracer tracer(3);
+
+    auto start = tracing::Clock::now();
+    for (tracing::CorrelationId id = 1; id <= 5; ++id)
+    {
+        tracer.record({id, tracing::Stage::Dispatch, start,
+                       std::chrono::microseconds(id), std::to_string(id)});
+    }
+
+    // The two oldest spans are overwritten and the rest are returned from
+    // the oldest to the newest.
+    auto spans = tracer.getSpans();
+    ASSERT_EQ(spans.size(), 3U);
+    EXPECT_EQ(spans[0].correlationId, 3U);
+    EXPECT_EQ(spans[1].correlationId, 4U);
+    EXPECT_EQ(spans[2].correlationId, 5U);
+    EXPECT_EQ(tracer.getDroppedSpans(), 2U);
+
+    tracer.clear();
+    EXPECT_TRUE(tracer.getSpans().empty());
+    EXPECT_EQ(tracer.getDroppedSpans(), 0U);
+}
+
+TEST(TracingTest, ZeroCapacityDisablesCollection)
+{
+    tracing::SpanTracer tracer(0);
+    tracer.record({tracer.newCorrelationId(), tracing::Stage::InotifyRead,
+                   tracing::Clock::now(), tracing::Clock::duration::zero(),
+                   ""});
+    EXPECT_TRUE(tracer.getSpans().empty());
+}
+
+TEST(TracingTest, CorrelationIdsAreUnique)
+{
+    tracing::SpanTracer tracer(1);
+    auto first = tracer.newCorrelationId();
+    auto second = tracer.newCorrelationId();
+    EXPECT_NE(first, 0U);
+    EXPECT_NE(first, second);
+}
+
+TEST(TracingTest, ExportChromeTrace)
+{
+    char tmpdir[] = "/tmp/pdsTracingXXXXXX";
+    fs::path tmpDir = mkdtemp(tmpdir);
+    fs::path traceFile = tmpDir / "spans.json";
+
+    tracing::SpanTracer tracer(8);
+    auto id = tracer.newCorrelationId();
+    auto start = tracing::Clock::now();
+    tracer.record({id, tracing::Stage::InotifyRead, start,
+                   std::chrono::microseconds(10), "/file"});
+    tracer.record({id, tracing::Stage::RsyncExit,
+                   start + std::chrono::microseconds(10),
+                   std::chrono::microseconds(200), "/file ExitCode: 0"});
+    tracer.exportChromeTrace(traceFile);
+
+    std::ifstream file(traceFile);
+    ASSERT_TRUE(file.is_open());
+    auto chromeTrace = nlohmann::json::parse(file);
+
+    ASSERT_EQ(chromeTrace["traceEvents"].size(), 2U);
+    const auto& rsyncSpan = chromeTrace["traceEvents"][1];
+    EXPECT_EQ(rsyncSpan["name"], "RsyncExit");
+    EXPECT_EQ(rsyncSpan["ph"], "X");
+    EXPECT_EQ(rsyncSpan["dur"], 200);
+    EXPECT_EQ(rsyncSpan["tid"], id);
+    EXPECT_EQ(rsyncSpan["args"]["CorrelationId"], id);
+    EXPECT_EQ(rsyncSpan["args"]["Detail"], "/file ExitCode: 0");
+
+    fs::remove_all(tmpDir);
+}
+
+TEST(TracingTest, ExportOnSignalWithOtherThreads)
+{
+    using namespace std::literals;
+
+    char tmpdir[] = "/tmp/pdsTracingXXXXXX";
+    fs::path tmpDir = mkdtemp(tmpdir);
+    fs::path traceFile = tmpDir / "spans.json";
+
+    // Blocked before the other thread is started, as the daemon does
+    ASSERT_TRUE(tracing::blockExportSignal());
+
+    std::atomic<bool> done{false};
+    std::thread otherThread([&done]() {
+        while (!done)
+        {
+            std::this_thread::sleep_for(1ms);
+        }
+    });
+
+    auto& tracer = tracing::SpanTracer::instance();
+    tracer.record({tracer.newCorrelationId(), tracing::Stage::Dispatch,
+                   tracing::Clock::now(), std::chrono::microseconds(10),
+                   "/file"});
+
+    sdbusplus::async::context ctx;
+    ctx.spawn(tracing::exportOnSignal(ctx, traceFile));
+
+    // NOLINTNEXTLINE
+    auto raiseSignal = [&]() -> sdbusplus::async::task<> {
+        co_await sdbusplus::async::sleep_for(ctx, 10ms);
+
+        // Raised at the process, hence any of its threads which doesn't block
+        // the signal could take it and terminate the process.
+        kill(getpid(), SIGUSR1);
+        for (int i = 0; i < 100 && !fs::exists(traceFile); ++i)
+        {
+            co_await sdbusplus::async::sleep_for(ctx, 10ms);
+        }
+
+        ctx.request_stop();
+
+        // Raise it again so that the export loop wakes up and exits
+        kill(getpid(), SIGUSR1);
+        co_return;
+    };
+
+    ctx.spawn(raiseSignal());
+    ctx.run();
+
+    done = true;
+    otherThread.join();
+
+    std::ifstream file(traceFile);
+    ASSERT_TRUE(file.is_open());
+    auto chromeTrace = nlohmann::json::parse(file);
+    EXPECT_FALSE(chromeTrace["traceEvents"].empty());
+
+    fs::remove_all(tmpDir);
+}
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "wakeup_event.hpp"
+
+#include <sdbusplus/async.hpp>
+
+#include <chrono>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace async = data_sync::async;
+using namespace std::chrono_literals;
+
+TEST(WakeupEventTest, NotifyEndsTheWaitEarly)
+{
+    sdbusplus::async::context ctx;
+    async::WakeupEvent wakeup(ctx);
+    bool notified{false};
+    std::chrono::steady_clock::duration waited{};
+
+    auto waitForNotify = [&]() -> sdbusplus::async::task<> {
+        const auto start = async::Clock::now();
+        notified = co_await wakeup.waitUntil(start + 10s);
+        waited = async::Clock::now() - start;
+        ctx.request_stop();
+        co_return;
+    };
+    auto notifyLater = [&]() -> sdbusplus::async::task<> {
+        co_await sdbusplus::async::sleep_for(ctx, 100ms);
+        wakeup.notify();
+        co_return;
+    };
+
+    ctx.spawn(waitForNotify());
+    ctx.spawn(notifyLater());
+    ctx.run();
+
+    EXPECT_TRUE(notified);
+    EXPECT_GE(waited, 100ms);
+    EXPECT_LT(waited, 5s);
+}
+
+TEST(WakeupEventTest, DeadlineEndsTheWait)
+{
+    sdbusplus::async::context ctx;
+    async::WakeupEvent wakeup(ctx);
+    bool notified{true};
+    std::chrono::steady_clock::duration waited{};
+
+    auto waitForDeadline = [&]() -> sdbusplus::async::task<> {
+        const auto start = async::Clock::now();
+        notified = co_await wakeup.waitUntil(start + 200ms);
+        waited = async::Clock::now() - start;
+        ctx.request_stop();
+        co_return;
+    };
+
+    ctx.spawn(waitForDeadline());
+    ctx.run();
+
+    EXPECT_FALSE(notified);
+    EXPECT_GE(waited, 200ms);
+}
+
+TEST(WakeupEventTest, NotifyBeforeTheWaitIsKept)
+{
+    sdbusplus::async::context ctx;
+    async::WakeupEvent wakeup(ctx);
+    std::vector<bool> results;
+
+    auto waitTwice = [&]() -> sdbusplus::async::task<> {
+        // The earlier notification ends the first wait right away, and is
+        // consumed by it.
+        wakeup.notify();
+        results.push_back(co_await wakeup.waitUntil(async::Clock::now() + 10s));
+        results.push_back(
+            co_await wakeup.waitUntil(async::Clock::now() + 100ms));
+        ctx.request_stop();
+        co_return;
+    };
+
+    ctx.spawn(waitTwice());
+    ctx.run();
+
+    EXPECT_EQ(results, (std::vector<bool>{true, false}));
+}
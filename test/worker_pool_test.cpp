@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "worker_pool.hpp"
+
+#include <sdbusplus/async.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace worker = data_sync::worker;
+
+TEST(WorkerPoolTest, JobRunsOffTheEventLoop)
+{
+    sdbusplus::async::context ctx;
+    worker::WorkerPool workerPool(2);
+    const auto eventLoopThread = std::this_thread::get_id();
+
+    std::thread::id jobThread;
+    std::thread::id resumedThread;
+    std::string result;
+
+    auto runJob = [&]() -> sdbusplus::async::task<> {
+        result = co_await workerPool.run(ctx, [&jobThread]() {
+            jobThread = std::this_thread::get_id();
+            return std::string("parsed");
+        });
+        resumedThread = std::this_thread::get_id();
+        ctx.request_stop();
+        co_return;
+    };
+
+    ctx.spawn(runJob());
+    ctx.run();
+
+    EXPECT_EQ(result, "parsed");
+    EXPECT_NE(jobThread, eventLoopThread);
+    EXPECT_EQ(resumedThread, eventLoopThread);
+}
+
+TEST(WorkerPoolTest, JobExceptionRethrown)
+{
+    sdbusplus::async::context ctx;
+    worker::WorkerPool workerPool(1);
+    bool caught{false};
+
+    auto runJob = [&]() -> sdbusplus::async::task<> {
+        try
+        {
+            co_await workerPool.run(
+                ctx, []() { throw std::runtime_error("parse failed"); });
+        }
+        catch (const std::runtime_error&)
+        {
+            caught = true;
+        }
+        ctx.request_stop();
+        co_return;
+    };
+
+    ctx.spawn(runJob());
+    ctx.run();
+
+    EXPECT_TRUE(caught);
+}
+
+TEST(WorkerPoolTest, JobRunsInlineWithoutWorkers)
+{
+    sdbusplus::async::context ctx;
+    worker::WorkerPool workerPool(0);
+    const auto eventLoopThread = std::this_thread::get_id();
+    std::thread::id jobThread;
+
+    auto runJob = [&]() -> sdbusplus::async::task<> {
+        co_await workerPool.run(
+            ctx, [&jobThread]() { jobThread = std::this_thread::get_id(); });
+        ctx.request_stop();
+        co_return;
+    };
+
+    ctx.spawn(runJob());
+    ctx.run();
+
+    EXPECT_EQ(jobThread, eventLoopThread);
+}